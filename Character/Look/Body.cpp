@@ -77,7 +77,7 @@ namespace ms
 					{
 						std::string z;
 						try {
-							z = partnode["z"];
+							z = partnode["z"].get_string();
 						} catch (const std::exception& e) {
 							continue; // Skip this part
 						}
@@ -159,7 +159,7 @@ namespace ms
 			LOG(LOG_DEBUG, "Skin [" << skin << "] is using the default value.");
 
 			try {
-				name = nl::nx::String["Eqp.img"]["Eqp"]["Skin"][skin]["name"];
+				name = nl::nx::String["Eqp.img"]["Eqp"]["Skin"][skin]["name"].get_string();
 			} catch (const std::exception& e) {
 				name = "Skin " + std::to_string(skin); // Use fallback name
 			}
@@ -104,7 +104,7 @@ namespace ms
 			}
 
 			try {
-				name = nl::nx::String["Eqp.img"]["Eqp"]["Face"][std::to_string(faceid)]["name"];
+				name = nl::nx::String["Eqp.img"]["Eqp"]["Face"][std::to_string(faceid)]["name"].get_string();
 			} catch (const std::exception& e) {
 				name = "Face " + std::to_string(faceid); // Use fallback name
 			}
@@ -142,7 +142,7 @@ namespace ms
 		}
 
 		try {
-			name = nl::nx::String["Eqp.img"]["Eqp"]["Hair"][std::to_string(hairid)]["name"];
+			name = nl::nx::String["Eqp.img"]["Eqp"]["Hair"][std::to_string(hairid)]["name"].get_string();
 		} catch (const std::exception& e) {
 			name = "Hair " + std::to_string(hairid); // Use fallback name
 		}
@@ -27,10 +27,15 @@ namespace ms
 	{
 		settings.emplace<ServerIP>();
 		settings.emplace<ServerPort>();
+		settings.emplace<NetworkThread>();
+		settings.emplace<PacketCapture>();
 		settings.emplace<Fullscreen>();
 		settings.emplace<Width>();
 		settings.emplace<Height>();
 		settings.emplace<VSync>();
+		settings.emplace<BakeTiles>();
+		settings.emplace<MapPrefetch>();
+		settings.emplace<MapLoadBudget>();
 		settings.emplace<Monitor>();
 		settings.emplace<FontPathNormal>();
 		settings.emplace<FontPathBold>();
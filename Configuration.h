@@ -275,6 +275,18 @@ namespace ms
 		ServerPort() : StringEntry("ServerPort", "8484") {}
 	};
 
+	// Whether socket I/O and decryption run on a separate network thread
+	struct NetworkThread : public Configuration::BoolEntry
+	{
+		NetworkThread() : BoolEntry("NetworkThread", "false") {}
+	};
+
+	// File to record received packets to, for replaying them later; empty to not record
+	struct PacketCapture : public Configuration::StringEntry
+	{
+		PacketCapture() : StringEntry("PacketCapture", "") {}
+	};
+
 	// Whether to start in full screen mode
 	struct Fullscreen : public Configuration::BoolEntry
 	{
@@ -299,6 +311,24 @@ namespace ms
 		VSync() : BoolEntry("VSync", "true") {}
 	};
 
+	// Whether to bake static tiles and objects into vertex buffers when a map is loaded
+	struct BakeTiles : public Configuration::BoolEntry
+	{
+		BakeTiles() : BoolEntry("BakeTiles", "true") {}
+	};
+
+	// Whether to prepare the maps behind the portals of the current map on a background thread
+	struct MapPrefetch : public Configuration::BoolEntry
+	{
+		MapPrefetch() : BoolEntry("MapPrefetch", "true") {}
+	};
+
+	// The milliseconds of each frame which may be spent loading a map while the screen is faded out
+	struct MapLoadBudget : public Configuration::ShortEntry
+	{
+		MapLoadBudget() : ShortEntry("MapLoadBudget", "8") {}
+	};
+
 	// The monitor to display the game on (0 = primary, 1 = secondary, etc.)
 	struct Monitor : public Configuration::ByteEntry
 	{
@@ -18,6 +18,8 @@
 #include "ItemData.h"
 
 #ifdef USE_NX
+#include "../Util/NodeCache.h"
+
 #include <nlnx/nx.hpp>
 #endif
 
@@ -34,36 +36,36 @@ namespace ms
 		nl::node src;
 		nl::node strsrc;
 
-		std::string strprefix = "0" + std::to_string(get_item_prefix(itemid));
-		std::string strid = "0" + std::to_string(itemid);
+		int32_t itemprefix = get_item_prefix(itemid);
 		int32_t prefix = get_prefix(itemid);
+		NodeCache& nodes = NodeCache::get();
 
 		switch (prefix)
 		{
 			case 1:
 				category = get_eqcategory(itemid);
-				src = nl::nx::Character[category][strid + ".img"]["info"];
-				strsrc = nl::nx::String["Eqp.img"]["Eqp"][category][std::to_string(itemid)];
+				src = nodes.resolve_format("Character/%s/0%d.img/info", category.c_str(), itemid);
+				strsrc = nodes.resolve_format("String/Eqp.img/Eqp/%s/%d", category.c_str(), itemid);
 				break;
 			case 2:
 				category = "Consume";
-				src = nl::nx::Item["Consume"][strprefix + ".img"][strid]["info"];
-				strsrc = nl::nx::String["Consume.img"][std::to_string(itemid)];
+				src = nodes.resolve_format("Item/Consume/0%d.img/0%d/info", itemprefix, itemid);
+				strsrc = nodes.resolve_format("String/Consume.img/%d", itemid);
 				break;
 			case 3:
 				category = "Install";
-				src = nl::nx::Item["Install"][strprefix + ".img"][strid]["info"];
-				strsrc = nl::nx::String["Ins.img"][std::to_string(itemid)];
+				src = nodes.resolve_format("Item/Install/0%d.img/0%d/info", itemprefix, itemid);
+				strsrc = nodes.resolve_format("String/Ins.img/%d", itemid);
 				break;
 			case 4:
 				category = "Etc";
-				src = nl::nx::Item["Etc"][strprefix + ".img"][strid]["info"];
-				strsrc = nl::nx::String["Etc.img"]["Etc"][std::to_string(itemid)];
+				src = nodes.resolve_format("Item/Etc/0%d.img/0%d/info", itemprefix, itemid);
+				strsrc = nodes.resolve_format("String/Etc.img/Etc/%d", itemid);
 				break;
 			case 5:
 				category = "Cash";
-				src = nl::nx::Item["Cash"][strprefix + ".img"][strid]["info"];
-				strsrc = nl::nx::String["Cash.img"][std::to_string(itemid)];
+				src = nodes.resolve_format("Item/Cash/0%d.img/0%d/info", itemprefix, itemid);
+				strsrc = nodes.resolve_format("String/Cash.img/%d", itemid);
 				break;
 		}
 
@@ -78,8 +80,8 @@ namespace ms
 			cashitem = src["cash"].get_bool();
 			gender = get_item_gender(itemid);
 
-			name = strsrc["name"];
-			desc = strsrc["desc"];
+			name = strsrc["name"].get_string();
+			desc = strsrc["desc"].get_string();
 
 			valid = true;
 		}
@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "MobData.h"
+
+#include "../Gameplay/MapleMap/Mob.h"
+#include "../Util/Misc.h"
+
+#ifdef USE_NX
+#include "../Util/NodeCache.h"
+
+#include <nlnx/nx.hpp>
+#endif
+
+namespace ms
+{
+	MobData::MobData(int32_t mobid)
+	{
+		nl::node src = NodeCache::get().resolve_format("Mob/%07d.img", mobid);
+		nl::node info = src["info"];
+
+		valid = src.size() > 0;
+
+		stats.level = info["level"];
+		stats.watk = info["PADamage"];
+		stats.matk = info["MADamage"];
+		stats.wdef = info["PDDamage"];
+		stats.mdef = info["MDDamage"];
+		stats.accuracy = info["acc"];
+		stats.avoid = info["eva"];
+		stats.knockback = info["pushed"];
+		stats.speed = info["speed"];
+		stats.flyspeed = info["flySpeed"];
+		stats.touchdamage = info["bodyAttack"].get_bool();
+		stats.undead = info["undead"].get_bool();
+		stats.noflip = info["noFlip"].get_bool();
+		stats.notattack = info["notAttack"].get_bool();
+		stats.canjump = src["jump"].size() > 0;
+		stats.canfly = src["fly"].size() > 0;
+		stats.canmove = src["move"].size() > 0 || stats.canfly;
+
+		stats.speed += 100;
+		stats.speed *= 0.001f;
+
+		stats.flyspeed += 100;
+		stats.flyspeed *= 0.0005f;
+
+		std::string linkid = info["link"];
+		nl::node link_src = nl::nx::Mob[linkid + ".img"];
+		nl::node link = link_src ? link_src : src;
+
+		if (stats.canfly)
+		{
+			nl::node fly = link["fly"];
+
+			animations[Mob::Stance::STAND] = fly;
+			animations[Mob::Stance::MOVE] = fly;
+		}
+		else
+		{
+			animations[Mob::Stance::STAND] = link["stand"];
+			animations[Mob::Stance::MOVE] = link["move"];
+		}
+
+		animations[Mob::Stance::JUMP] = link["jump"];
+		animations[Mob::Stance::HIT] = link["hit1"];
+		animations[Mob::Stance::DIE] = link["die1"];
+
+		// Attack and skill animations are optional
+		for (auto stance : { Mob::Stance::ATTACK1, Mob::Stance::ATTACK2, Mob::Stance::ATTACK3, Mob::Stance::ATTACK4, Mob::Stance::SKILL1, Mob::Stance::SKILL2 })
+		{
+			nl::node stancenode = link[Mob::nameof(stance)];
+
+			if (stancenode)
+				animations[stance] = stancenode;
+		}
+
+		name = nl::nx::String["Mob.img"][mobid]["name"].get_string();
+
+		nl::node sndsrc = NodeCache::get().resolve_format("Sound/Mob.img/%07d", mobid);
+
+		hitsound = sndsrc["Damage"];
+		diesound = sndsrc["Die"];
+	}
+
+	bool MobData::is_valid() const
+	{
+		return valid;
+	}
+
+	MobData::operator bool() const
+	{
+		return is_valid();
+	}
+
+	const MobData::Stats& MobData::get_stats() const
+	{
+		return stats;
+	}
+
+	const std::string& MobData::get_name() const
+	{
+		return name;
+	}
+
+	const Sound& MobData::get_hitsound() const
+	{
+		return hitsound;
+	}
+
+	const Sound& MobData::get_diesound() const
+	{
+		return diesound;
+	}
+
+	const std::map<uint8_t, Animation>& MobData::get_animations() const
+	{
+		return animations;
+	}
+}
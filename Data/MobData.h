@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "../Audio/Audio.h"
+#include "../Graphics/Animation.h"
+#include "../Template/Cache.h"
+
+#include <map>
+
+namespace ms
+{
+	// Information about a mob type which is shared by all mobs with the same id
+	class MobData : public Cache<MobData>
+	{
+	public:
+		// The stats of a mob type
+		struct Stats
+		{
+			uint16_t level;
+			float speed;
+			float flyspeed;
+			uint16_t watk;
+			uint16_t matk;
+			uint16_t wdef;
+			uint16_t mdef;
+			uint16_t accuracy;
+			uint16_t avoid;
+			uint16_t knockback;
+			bool undead;
+			bool touchdamage;
+			bool noflip;
+			bool notattack;
+			bool canmove;
+			bool canjump;
+			bool canfly;
+		};
+
+		// Return whether the mob was loaded correctly
+		bool is_valid() const;
+		// Return whether the mob was loaded correctly
+		explicit operator bool() const;
+
+		// Return the stats of this mob type
+		const Stats& get_stats() const;
+		// Return the name of this mob type
+		const std::string& get_name() const;
+		// Return the sound played when a mob is hit
+		const Sound& get_hitsound() const;
+		// Return the sound played when a mob dies
+		const Sound& get_diesound() const;
+		// Return the stance animations, keyed by stance value
+		// Mobs copy these as the frame state of an animation is per instance.
+		const std::map<uint8_t, Animation>& get_animations() const;
+
+	private:
+		// Allow the cache to use the constructor
+		friend Cache<MobData>;
+		// Load a mob type from the game files
+		MobData(int32_t mobid);
+
+		std::map<uint8_t, Animation> animations;
+		std::string name;
+		Sound hitsound;
+		Sound diesound;
+		Stats stats;
+		bool valid;
+	};
+}
@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "MobSkillData.h"
+
+#ifdef USE_NX
+#include <nlnx/nx.hpp>
+#endif
+
+namespace ms
+{
+	MobSkillData::MobSkillData(int32_t skillid)
+	{
+		nl::node src = nl::nx::Skill["MobSkill.img"][std::to_string(skillid)]["level"]["1"];
+
+		nl::node effectsrc = src["mob"];
+		haseffect = effectsrc ? true : false;
+
+		if (haseffect)
+			effect = effectsrc;
+
+		// Some skills use "ball", others use "effect"
+		nl::node projectilesrc = src["ball"];
+
+		if (!projectilesrc)
+			projectilesrc = src["effect"];
+
+		hasprojectile = projectilesrc ? true : false;
+
+		if (hasprojectile)
+			projectile = projectilesrc;
+
+		nl::node speedsrc = src["info"]["bulletSpeed"];
+		bulletspeed = speedsrc ? static_cast<int16_t>(speedsrc.get_integer()) : 140;
+	}
+
+	bool MobSkillData::has_effect() const
+	{
+		return haseffect;
+	}
+
+	bool MobSkillData::has_projectile() const
+	{
+		return hasprojectile;
+	}
+
+	const Animation& MobSkillData::get_effect() const
+	{
+		return effect;
+	}
+
+	const Animation& MobSkillData::get_projectile() const
+	{
+		return projectile;
+	}
+
+	int16_t MobSkillData::get_bulletspeed() const
+	{
+		return bulletspeed;
+	}
+}
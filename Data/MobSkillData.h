@@ -0,0 +1,53 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "../Graphics/Animation.h"
+#include "../Template/Cache.h"
+
+namespace ms
+{
+	// Information about a mob skill which is shared by all mobs using it
+	class MobSkillData : public Cache<MobSkillData>
+	{
+	public:
+		// Return whether the skill has an effect shown on the mob
+		bool has_effect() const;
+		// Return whether the skill has a projectile
+		bool has_projectile() const;
+
+		// Return the effect shown on the mob using the skill
+		const Animation& get_effect() const;
+		// Return the projectile animation
+		const Animation& get_projectile() const;
+		// Return the projectile speed
+		int16_t get_bulletspeed() const;
+
+	private:
+		// Allow the cache to use the constructor
+		friend Cache<MobSkillData>;
+		// Load a mob skill from the game files
+		MobSkillData(int32_t skillid);
+
+		Animation effect;
+		Animation projectile;
+		int16_t bulletspeed;
+		bool haseffect;
+		bool hasprojectile;
+	};
+}
@@ -133,4 +133,15 @@ namespace ms
 	{
 		return { x.get(alpha), y.get(alpha) };
 	}
+
+	Rectangle<int16_t> Camera::visible_area(double viewx, double viewy)
+	{
+		auto left = static_cast<int16_t>(std::round(-viewx));
+		auto top = static_cast<int16_t>(std::round(-viewy));
+
+		int16_t width = Constants::Constants::get().get_viewwidth();
+		int16_t height = Constants::Constants::get().get_viewheight();
+
+		return Rectangle<int16_t>(left, left + width, top, top + height);
+	}
 }
\ No newline at end of file
@@ -20,6 +20,7 @@
 #include "../Template/Interpolated.h"
 #include "../Template/Point.h"
 #include "../Template/Range.h"
+#include "../Template/Rectangle.h"
 
 #include <cstdint>
 
@@ -45,6 +46,9 @@ namespace ms
 		// Return the interpolated position.
 		Point<double> realposition(float alpha) const;
 
+		// Return the area of the map which is visible from the given view position.
+		static Rectangle<int16_t> visible_area(double viewx, double viewy);
+
 	private:
 		// Movement variables.
 		Linear<double> x;
@@ -57,6 +57,16 @@ namespace ms
 	{
 		physics.move_object(phobj);
 
+		return finish(physics);
+	}
+
+	bool Drop::is_batched() const
+	{
+		return true;
+	}
+
+	int8_t Drop::finish(const Physics&)
+	{
 		if (state == Drop::State::DROPPED)
 		{
 			if (phobj.onground)
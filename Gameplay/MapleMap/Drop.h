@@ -27,6 +27,10 @@ namespace ms
 	{
 	public:
 		virtual int8_t update(const Physics& physics) override;
+		// Drops are moved in the batched physics step
+		bool is_batched() const override;
+		// Float, spin or fade out after the drop was moved
+		int8_t finish(const Physics& physics) override;
 
 		void expire(int8_t, const PhysicsObject*);
 
@@ -152,9 +152,25 @@ namespace ms
 		int16_t tw = cx * htile;
 		int16_t th = cy * vtile;
 
+		Rectangle<int16_t> screen(0, VWIDTH, 0, VHEIGHT);
+		Rectangle<int16_t> extents = animation.get_extents();
+		size_t culled = 0;
+
 		for (int16_t tx = 0; tx < tw; tx += cx)
+		{
 			for (int16_t ty = 0; ty < th; ty += cy)
-				animation.draw(DrawArgument(Point<int16_t>(ix + tx, iy + ty), flipped, opacity / 255), alpha);
+			{
+				Rectangle<int16_t> copy = extents;
+				copy.shift(Point<int16_t>(ix + tx, iy + ty));
+
+				if (copy.overlaps(screen))
+					animation.draw(DrawArgument(Point<int16_t>(ix + tx, iy + ty), flipped, opacity / 255), alpha);
+				else
+					culled++;
+			}
+		}
+
+		GraphicsGL::get().cull(culled);
 	}
 
 	void Background::update()
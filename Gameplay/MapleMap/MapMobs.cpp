@@ -18,6 +18,7 @@
 #include "MapMobs.h"
 #include "Mob.h"
 
+#include "../../Data/MobSkillData.h"
 #include "../../Util/Misc.h"
 #include "../Stage.h"
 #include "../../Template/Range.h"
@@ -28,6 +29,8 @@
 #include <map>
 
 #ifdef USE_NX
+#include "../../Util/NodeCache.h"
+
 #include <nlnx/nx.hpp>
 #endif
 
@@ -311,40 +314,34 @@ namespace ms
 			}
 			
 			// Load the projectile animation from WZ files
-			std::string skill_str = std::to_string(skill_id);
-			nl::node skill_node = nl::nx::Skill["MobSkill.img"][skill_str]["level"]["1"]["ball"];
-			
-			// Some skills use "ball", others use "effect"
-			if (!skill_node)
-				skill_node = nl::nx::Skill["MobSkill.img"][skill_str]["level"]["1"]["effect"];
-				
+			const MobSkillData& skilldata = MobSkillData::get(skill_id);
+			Animation projectile_anim = skilldata.get_projectile();
+			bool found = skilldata.has_projectile();
+
 			// For Pixie, let's check specific mob projectiles
-			if (!skill_node)
+			if (!found)
 			{
 				// Pixie star projectile
 				int32_t mob_id = mob->get_id();
 				if (mob_id == 5120000 || mob_id == 4230106 || mob_id == 3230200)
 				{
 					// Try to load pixie star from mob data
-					std::string mob_id_str = string_format::extend_id(mob_id, 7);
-					skill_node = nl::nx::Mob[mob_id_str + ".img"]["attack1"]["info"]["ball"];
+					nl::node ball = NodeCache::get().resolve_format("Mob/%07d.img/attack1/info/ball", mob_id);
+
+					if (ball)
+					{
+						projectile_anim = ball;
+						found = true;
+					}
 				}
 			}
-			
-			if (skill_node)
+
+			if (found)
 			{
-				Animation projectile_anim(skill_node);
-				
-				// Get projectile speed from skill data or use default
-				int16_t speed = 140; // Default speed
-				nl::node speed_node = nl::nx::Skill["MobSkill.img"][skill_str]["level"]["1"]["info"]["bulletSpeed"];
-				if (speed_node)
-					speed = speed_node;
-				
 				projectiles.push_back(std::make_unique<MobProjectile>(
-					projectile_anim, origin, target, speed, mob_oid
+					projectile_anim, origin, target, skilldata.get_bulletspeed(), mob_oid
 				));
-				
+
 				std::cout << "[DEBUG] Projectile spawned! Total projectiles: " << projectiles.size() << std::endl;
 			}
 			else
@@ -429,8 +426,7 @@ namespace ms
 					// Show impact effect on player (spit dissipating)
 					// For spit attacks, we should show the hit animation
 					int32_t mob_id = mob->get_id();
-					std::string mob_id_str = string_format::extend_id(mob_id, 7);
-					nl::node attack_info = nl::nx::Mob[mob_id_str + ".img"]["attack1"]["info"];
+					nl::node attack_info = NodeCache::get().resolve_format("Mob/%07d.img/attack1/info", mob_id);
 					nl::node hit_node = attack_info["hit"];
 					
 					if (hit_node)
@@ -480,8 +476,7 @@ namespace ms
 			target.shift_y(-25); // Aim at player mid-body
 			
 			// Try to load attack data from mob
-			std::string mob_id_str = string_format::extend_id(mob_id, 7);
-			nl::node attack_info = nl::nx::Mob[mob_id_str + ".img"]["attack1"]["info"];
+			nl::node attack_info = NodeCache::get().resolve_format("Mob/%07d.img/attack1/info", mob_id);
 			
 			// Debug: Print all children of attack_info
 			std::cout << "[DEBUG] Attack info for mob " << mob_id << ":" << std::endl;
@@ -605,7 +600,7 @@ namespace ms
 						{
 							// For now, let's try to create a projectile from the attack animation itself
 							// Look for the main attack animation
-							nl::node attack_anim = nl::nx::Mob[mob_id_str + ".img"]["attack1"];
+							nl::node attack_anim = NodeCache::get().resolve_format("Mob/%07d.img/attack1", mob_id);
 							if (attack_anim)
 							{
 								spit_projectile = Animation(attack_anim);
@@ -32,6 +32,21 @@ namespace ms
 		return phobj.fhlayer;
 	}
 
+	bool MapObject::is_batched() const
+	{
+		return false;
+	}
+
+	bool MapObject::prepare()
+	{
+		return true;
+	}
+
+	int8_t MapObject::finish(const Physics&)
+	{
+		return phobj.fhlayer;
+	}
+
 	void MapObject::set_position(int16_t x, int16_t y)
 	{
 		phobj.set_x(x);
@@ -65,6 +80,14 @@ namespace ms
 		return phobj.fhlayer;
 	}
 
+	Rectangle<int16_t> MapObject::get_extents() const
+	{
+		Point<int16_t> position = get_position();
+
+		// Generous box for objects which don't know their size, e.g. characters with effects and name tags
+		return Rectangle<int16_t>(position.x() - 400, position.x() + 400, position.y() - 500, position.y() + 200);
+	}
+
 	int32_t MapObject::get_oid() const
 	{
 		return oid;
@@ -74,4 +97,9 @@ namespace ms
 	{
 		return phobj.get_position();
 	}
+
+	PhysicsObject& MapObject::get_phobj()
+	{
+		return phobj;
+	}
 }
\ No newline at end of file
@@ -34,6 +34,12 @@ namespace ms
 
 		// Updates the object and returns the updated layer.
 		virtual int8_t update(const Physics& physics);
+		// Checks whether the update is split into prepare and finish, so physics can be stepped for many objects at once.
+		virtual bool is_batched() const;
+		// Runs the part of the update before the physics step and returns whether the object should be moved.
+		virtual bool prepare();
+		// Runs the part of the update after the physics step and returns the updated layer.
+		virtual int8_t finish(const Physics& physics);
 		// Reactivates the object.
 		virtual void makeactive();
 		// Deactivates the object.
@@ -42,6 +48,8 @@ namespace ms
 		virtual bool is_active() const;
 		// Obtains the layer used to determine the drawing order on the map.
 		virtual int8_t get_layer() const;
+		// Obtains the area on the map which may be covered when drawing the object.
+		virtual Rectangle<int16_t> get_extents() const;
 
 		// Changes the objects position.
 		void set_position(int16_t x, int16_t y);
@@ -52,6 +60,8 @@ namespace ms
 		int32_t get_oid() const;
 		// Returns the current position.
 		Point<int16_t> get_position() const;
+		// Returns the object which is moved by physics.
+		PhysicsObject& get_phobj();
 
 	protected:
 		MapObject(int32_t oid, Point<int16_t> position = {});
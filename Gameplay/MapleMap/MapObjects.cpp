@@ -17,33 +17,60 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "MapObjects.h"
 
+#include "../../Graphics/GraphicsGL.h"
+
 #include <iostream>
 
 namespace ms
 {
 	void MapObjects::draw(Layer::Id layer, double viewx, double viewy, float alpha) const
 	{
-		
-		for (auto& oid : layers[layer])
+		Rectangle<int16_t> area = Camera::visible_area(viewx, viewy);
+		size_t culled = 0;
+
+		for (auto mmo : layers[layer])
 		{
-			auto mmo = get(oid);
+			if (!mmo->is_active())
+				continue;
 
-			if (mmo && mmo->is_active()) {
+			if (mmo->get_extents().overlaps(area))
 				mmo->draw(viewx, viewy, alpha);
-			}
+			else
+				culled++;
 		}
+
+		GraphicsGL::get().cull(culled);
 	}
 
 	void MapObjects::update(const Physics& physics)
 	{
+		bodies.clear();
+		oldlayers.clear();
+
+		// Step the physics of all batched objects together, physics may already change the layer
+		for (auto& iter : objects)
+		{
+			auto& mmo = iter.second;
+
+			oldlayers.push_back(mmo ? mmo->get_layer() : 0);
+
+			if (mmo && mmo->is_batched() && mmo->prepare())
+				bodies.push_back(&mmo->get_phobj());
+		}
+
+		physics.move_objects(bodies.data(), bodies.size());
+
+		// Nothing is added to objects in between, so the iteration order is the same
+		size_t index = 0;
+
 		for (auto iter = objects.begin(); iter != objects.end();)
 		{
 			bool remove_mob = false;
+			int8_t oldlayer = oldlayers[index++];
 
 			if (auto& mmo = iter->second)
 			{
-				int8_t oldlayer = mmo->get_layer();
-				int8_t newlayer = mmo->update(physics);
+				int8_t newlayer = mmo->is_batched() ? mmo->finish(physics) : mmo->update(physics);
 
 				if (newlayer == -1)
 				{
@@ -51,12 +78,10 @@ namespace ms
 				}
 				else if (newlayer != oldlayer)
 				{
-					int32_t oid = iter->first;
-					
 					if (oldlayer >= 0 && oldlayer < Layer::LENGTH)
-						layers[oldlayer].erase(oid);
+						layers[oldlayer].erase(mmo.get());
 					if (newlayer >= 0 && newlayer < Layer::LENGTH)
-						layers[newlayer].insert(oid);
+						layers[newlayer].insert(mmo.get());
 				}
 			}
 			else
@@ -65,7 +90,12 @@ namespace ms
 			}
 
 			if (remove_mob)
+			{
+				for (auto& layer : layers)
+					layer.erase(iter->second.get());
+
 				iter = objects.erase(iter);
+			}
 			else
 				iter++;
 		}
@@ -96,8 +126,10 @@ namespace ms
 			layer = 0;
 		}
 		
+		remove(oid);
+
+		layers[layer].insert(toadd.get());
 		objects[oid] = std::move(toadd);
-		layers[layer].insert(oid);
 	}
 
 	void MapObjects::remove(int32_t oid)
@@ -106,10 +138,10 @@ namespace ms
 
 		if (iter != objects.end() && iter->second)
 		{
-			int8_t layer = iter->second->get_layer();
-			objects.erase(iter);
+			for (auto& layer : layers)
+				layer.erase(iter->second.get());
 
-			layers[layer].erase(oid);
+			objects.erase(iter);
 		}
 	}
 
@@ -65,6 +65,10 @@ namespace ms
 
 	private:
 		std::unordered_map<int32_t, std::unique_ptr<MapObject>> objects;
-		std::array<std::unordered_set<int32_t>, Layer::Id::LENGTH> layers;
+		std::array<std::unordered_set<MapObject*>, Layer::Id::LENGTH> layers;
+		// Objects which are moved in this tick's batched physics step
+		std::vector<PhysicsObject*> bodies;
+		// Layer of every object before this tick's update, in iteration order
+		std::vector<int8_t> oldlayers;
 	};
 }
\ No newline at end of file
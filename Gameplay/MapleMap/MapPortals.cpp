@@ -21,6 +21,8 @@
 
 #include "../../Util/Misc.h"
 
+#include <algorithm>
+
 #ifdef USE_NX
 #include <nlnx/nx.hpp>
 #endif
@@ -50,7 +52,9 @@ namespace ms
 				<< "', type=" << (int)type << ", position=(" << position.x() << "," << position.y() 
 				<< "), target_map=" << target_id << ", target_name='" << target_name << "'");
 
-			const Animation* animation = &animations[type];
+			// Only looked up, portals are also created by the map prefetcher's thread
+			auto animiter = animations.find(type);
+			const Animation* animation = animiter != animations.end() ? &animiter->second : &noanimation;
 			bool intramap = target_id == mapid;
 
 			portals_by_id.emplace(
@@ -138,6 +142,21 @@ namespace ms
 		}
 	}
 
+	std::vector<int32_t> MapPortals::get_target_maps() const
+	{
+		std::vector<int32_t> targets;
+
+		for (auto& iter : portals_by_id)
+		{
+			Portal::WarpInfo warpinfo = iter.second.getwarpinfo();
+
+			if (warpinfo.valid && !warpinfo.intramap && std::find(targets.begin(), targets.end(), warpinfo.mapid) == targets.end())
+				targets.push_back(warpinfo.mapid);
+		}
+
+		return targets;
+	}
+
 	Portal::WarpInfo MapPortals::find_warp_at(Point<int16_t> playerpos)
 	{
 		if (cooldown == 0)
@@ -292,9 +311,13 @@ namespace ms
 		
 		// Also load INVISIBLE portal animation (same as HIDDEN for most cases)
 		animations[Portal::INVISIBLE] = animations[Portal::HIDDEN];
+
+		// Updated every frame, so they must exist before portals are created on other threads
+		animations.emplace(Portal::REGULAR, Animation());
 		
 		LOG(LOG_DEBUG, "[MapPortals] Portal animation initialization complete");
 	}
 
 	std::unordered_map<Portal::Type, Animation> MapPortals::animations;
+	const Animation MapPortals::noanimation;
 }
\ No newline at end of file
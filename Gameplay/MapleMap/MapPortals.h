@@ -20,6 +20,7 @@
 #include "Portal.h"
 
 #include <unordered_map>
+#include <vector>
 
 namespace ms
 {
@@ -42,9 +43,13 @@ namespace ms
 		Point<int16_t> get_portal_by_id(uint8_t id) const;
 		Point<int16_t> get_portal_by_name(const std::string& name) const;
 		size_t get_portal_count() const { return portals_by_id.size(); }
+		// Return the maps the portals lead to, without duplicates or the map itself
+		std::vector<int32_t> get_target_maps() const;
 
 	private:
 		static std::unordered_map<Portal::Type, Animation> animations;
+		// Used by portals of types without an animation
+		static const Animation noanimation;
 
 		std::unordered_map<uint8_t, Portal> portals_by_id;
 		std::unordered_map<std::string, uint8_t> portal_ids_by_name;
@@ -0,0 +1,218 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "MapPrefetcher.h"
+
+#include "../Stage.h"
+
+#include "../../Configuration.h"
+
+#include <algorithm>
+#include <set>
+
+#ifdef USE_NX
+#include <nlnx/bitmap.hpp>
+#include <nlnx/nx.hpp>
+#endif
+
+namespace ms
+{
+	namespace
+	{
+		// Read every node below a source and the compressed data of its bitmaps
+		void touch(nl::node src)
+		{
+			if (src.data_type() == nl::node::type::bitmap)
+				src.get_bitmap().touch();
+
+			for (auto child : src)
+				touch(child);
+		}
+	}
+
+	MapPrefetcher::MapPrefetcher() : stopping(false) {}
+
+	MapPrefetcher::~MapPrefetcher()
+	{
+		stop_thread();
+	}
+
+	void MapPrefetcher::prefetch(const std::vector<int32_t>& mapids)
+	{
+		if (!Setting<MapPrefetch>::get().load())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			wanted = mapids;
+			queue.clear();
+
+			for (auto iter = ready.begin(); iter != ready.end();)
+			{
+				if (std::find(wanted.begin(), wanted.end(), iter->first) == wanted.end())
+					iter = ready.erase(iter);
+				else
+					iter++;
+			}
+
+			for (int32_t mapid : wanted)
+				if (ready.count(mapid) == 0)
+					queue.push_back(mapid);
+		}
+
+		if (!worker.joinable())
+			worker = std::thread(&MapPrefetcher::run, this);
+
+		queued.notify_one();
+	}
+
+	std::unique_ptr<MapPrefetcher::Prepared> MapPrefetcher::take(int32_t mapid)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto iter = ready.find(mapid);
+
+		if (iter == ready.end())
+			return nullptr;
+
+		std::unique_ptr<Prepared> prepared = std::move(iter->second);
+		ready.erase(iter);
+
+		return prepared;
+	}
+
+	void MapPrefetcher::clear()
+	{
+		stop_thread();
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		wanted.clear();
+		queue.clear();
+		ready.clear();
+	}
+
+	size_t MapPrefetcher::get_ready()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		return ready.size();
+	}
+
+	void MapPrefetcher::run()
+	{
+		while (true)
+		{
+			int32_t mapid;
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				queued.wait(lock, [&]() { return stopping || !queue.empty(); });
+
+				if (stopping)
+					return;
+
+				mapid = queue.front();
+				queue.pop_front();
+			}
+
+			std::unique_ptr<Prepared> prepared = prepare(mapid);
+
+			std::lock_guard<std::mutex> lock(mutex);
+
+			// The player may have moved on while this map was prepared
+			if (prepared && std::find(wanted.begin(), wanted.end(), mapid) != wanted.end())
+				ready[mapid] = std::move(prepared);
+		}
+	}
+
+	void MapPrefetcher::stop_thread()
+	{
+		if (!worker.joinable())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+
+		queued.notify_one();
+		worker.join();
+
+		stopping = false;
+	}
+
+	void MapPrefetcher::warm(nl::node src)
+	{
+		touch(src);
+
+		// Tiles, objects and backgrounds are drawn from other images, which are only read in
+		// Their textures are created on the main thread as they are registered with the graphics.
+		std::set<nl::node> sources;
+
+		for (int layer = 0; layer < 8; layer++)
+		{
+			nl::node layersrc = src[layer];
+			std::string tileset = layersrc["info"]["tS"] + ".img";
+
+			for (auto tile : layersrc["tile"])
+				sources.insert(nl::nx::Map["Tile"][tileset][tile["u"]][tile["no"]]);
+
+			for (auto obj : layersrc["obj"])
+				sources.insert(nl::nx::Map["Obj"][obj["oS"] + ".img"][obj["l0"]][obj["l1"]][obj["l2"]]);
+		}
+
+		nl::node backsrc = nl::nx::Map001["Back"];
+
+		if (backsrc.name().empty())
+			backsrc = nl::nx::Map["Back"];
+
+		for (auto back : src["back"])
+			sources.insert(backsrc[back["bS"] + ".img"][back["ani"].get_bool() ? "ani" : "back"][back["no"]]);
+
+		for (auto& source : sources)
+			touch(source);
+	}
+
+	std::unique_ptr<MapPrefetcher::Prepared> MapPrefetcher::prepare(int32_t mapid)
+	{
+		try
+		{
+			nl::node src = Stage::find_map(mapid);
+
+			if (!src)
+				return nullptr;
+
+			warm(src);
+
+			auto prepared = std::make_unique<Prepared>();
+			prepared->src = src;
+			prepared->physics = Physics(src["foothold"]);
+			prepared->mapinfo = MapInfo(src, prepared->physics.get_fht().get_walls(), prepared->physics.get_fht().get_borders());
+			prepared->portals = MapPortals(src["portal"], mapid);
+
+			return prepared;
+		}
+		catch (const std::exception& ex)
+		{
+			LOG(LOG_WARN, "[MapPrefetcher] Failed to prepare map " << mapid << ": " << ex.what());
+
+			return nullptr;
+		}
+	}
+}
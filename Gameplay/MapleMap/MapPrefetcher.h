@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "MapInfo.h"
+#include "MapPortals.h"
+
+#include "../Physics/Physics.h"
+
+#include "../../Template/Singleton.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ms
+{
+	// Prepares the maps behind the portals of the current map on a background thread
+	// The pages of their data are read in and the parts which need no textures are parsed,
+	// so a warp only has to build tiles, objects and backgrounds.
+	class MapPrefetcher : public Singleton<MapPrefetcher>
+	{
+	public:
+		// The parts of a map which can be built off the main thread
+		struct Prepared
+		{
+			nl::node src;
+			Physics physics;
+			MapInfo mapinfo;
+			MapPortals portals;
+		};
+
+		MapPrefetcher();
+		// Stop and join the worker thread
+		~MapPrefetcher();
+
+		// Prepare these maps in order, maps which are not among them are dropped
+		// Does nothing unless the MapPrefetch setting is enabled.
+		void prefetch(const std::vector<int32_t>& mapids);
+		// Take a prepared map, returns nullptr if it is not ready yet
+		std::unique_ptr<Prepared> take(int32_t mapid);
+		// Stop the worker thread and drop all maps
+		void clear();
+
+		// Return the number of maps which are ready
+		size_t get_ready();
+
+	private:
+		void run();
+		void stop_thread();
+
+		// Read the nodes of a map and the data of every bitmap it draws
+		static void warm(nl::node src);
+		static std::unique_ptr<Prepared> prepare(int32_t mapid);
+
+		std::thread worker;
+		std::deque<int32_t> queue;
+		std::vector<int32_t> wanted;
+		std::unordered_map<int32_t, std::unique_ptr<Prepared>> ready;
+		std::mutex mutex;
+		std::condition_variable queued;
+		bool stopping;
+	};
+}
@@ -17,6 +17,12 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "MapTilesObjs.h"
 
+#include "../Camera.h"
+
+#include "../../Configuration.h"
+
+#include "../../Graphics/GraphicsGL.h"
+
 namespace ms
 {
 	TilesObjs::TilesObjs(nl::node src)
@@ -36,6 +42,55 @@ namespace ms
 			int8_t z = obj.getz();
 			objs.emplace(z, std::move(obj));
 		}
+
+		baked = false;
+
+		if (Setting<BakeTiles>::get().load())
+			bake();
+	}
+
+	void TilesObjs::bake()
+	{
+		std::vector<const Obj*> still;
+
+		auto record = [&](bool withtiles)
+		{
+			if (still.empty() && (!withtiles || tiles.empty()))
+				return;
+
+			StaticBlock block(
+				[&]()
+				{
+					for (auto obj : still)
+						obj->draw({}, 1.0f);
+
+					if (withtiles)
+						for (auto& iter : tiles)
+							iter.second.draw({});
+				}
+			);
+
+			runs.push_back({ std::move(block), nullptr });
+			still.clear();
+		};
+
+		for (auto& iter : objs)
+		{
+			if (iter.second.is_static())
+			{
+				still.push_back(&iter.second);
+			}
+			else
+			{
+				record(false);
+				runs.push_back({ StaticBlock(), &iter.second });
+			}
+		}
+
+		// Tiles are drawn after all objects
+		record(true);
+
+		baked = true;
 	}
 
 	void TilesObjs::update()
@@ -46,17 +101,54 @@ namespace ms
 
 	void TilesObjs::draw(Point<int16_t> viewpos, float alpha) const
 	{
+		Rectangle<int16_t> area = Camera::visible_area(viewpos.x(), viewpos.y());
+		size_t culled = 0;
+
+		if (baked)
+		{
+			for (auto& run : runs)
+			{
+				if (!run.animated)
+					run.block.draw(viewpos);
+				else if (run.animated->get_extents().overlaps(area))
+					run.animated->draw(viewpos, alpha);
+				else
+					culled++;
+			}
+
+			GraphicsGL::get().cull(culled);
+
+			return;
+		}
+
 		for (auto& iter : objs)
-			iter.second.draw(viewpos, alpha);
+		{
+			if (iter.second.get_extents().overlaps(area))
+				iter.second.draw(viewpos, alpha);
+			else
+				culled++;
+		}
 
 		for (auto& iter : tiles)
-			iter.second.draw(viewpos);
+		{
+			if (iter.second.get_extents().overlaps(area))
+				iter.second.draw(viewpos);
+			else
+				culled++;
+		}
+
+		GraphicsGL::get().cull(culled);
 	}
 
 	MapTilesObjs::MapTilesObjs(nl::node src)
 	{
-		for (auto iter : layers)
-			iter.second = src[iter.first];
+		for (auto id : Layer::IDs)
+			load(src, id);
+	}
+
+	void MapTilesObjs::load(nl::node src, Layer::Id layer)
+	{
+		layers[layer] = src[layer];
 	}
 
 	void MapTilesObjs::draw(Layer::Id layer, Point<int16_t> viewpos, float alpha) const
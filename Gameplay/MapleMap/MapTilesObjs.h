@@ -21,6 +21,7 @@
 #include "Obj.h"
 #include "Tile.h"
 
+#include "../../Graphics/StaticBlock.h"
 #include "../../Template/EnumMap.h"
 
 #include <map>
@@ -31,15 +32,27 @@ namespace ms
 	class TilesObjs
 	{
 	public:
-		TilesObjs() {}
+		TilesObjs() : baked(false) {}
 		TilesObjs(nl::node src);
 
 		void draw(Point<int16_t> viewpos, float alpha) const;
 		void update();
 
 	private:
+		// Record runs of static objects and the tiles into blocks, keeping the drawing order
+		void bake();
+
+		// Either a block of static tiles and objects, or a single animated object
+		struct Run
+		{
+			StaticBlock block;
+			const Obj* animated;
+		};
+
 		std::multimap<uint8_t, Tile> tiles;
 		std::multimap<uint8_t, Obj> objs;
+		std::vector<Run> runs;
+		bool baked;
 	};
 
 	// The collection of tile and object layers on a map
@@ -49,6 +62,9 @@ namespace ms
 		MapTilesObjs() {}
 		MapTilesObjs(nl::node src);
 
+		// Load a single layer, so staged map loads can spread the layers over frames
+		void load(nl::node src, Layer::Id layer);
+
 		void draw(Layer::Id layer, Point<int16_t> viewpos, float alpha) const;
 		void update();
 
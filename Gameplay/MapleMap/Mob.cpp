@@ -17,6 +17,7 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "Mob.h"
 
+#include "../../Data/MobSkillData.h"
 #include "../../Util/Misc.h"
 
 #include "../../Net/Packets/GameplayPackets.h"
@@ -25,89 +26,14 @@
 #include <iostream>
 #include <cmath>
 
-#ifdef USE_NX
-#include <nlnx/nx.hpp>
-#endif
-
 namespace ms
 {
-	Mob::Mob(int32_t oi, int32_t mid, int8_t mode, int8_t st, uint16_t fh, bool newspawn, int8_t tm, Point<int16_t> position) : MapObject(oi)
+	Mob::Mob(int32_t oi, int32_t mid, int8_t mode, int8_t st, uint16_t fh, bool newspawn, int8_t tm, Point<int16_t> position) : MapObject(oi), data(MobData::get(mid)), stats(data.get_stats())
 	{
-		std::string strid = string_format::extend_id(mid, 7);
-		
-		nl::node src = nl::nx::Mob[strid + ".img"];
-		if (!src) {
-		}
-
-		nl::node info = src["info"];
-
-		level = info["level"];
-		watk = info["PADamage"];
-		matk = info["MADamage"];
-		wdef = info["PDDamage"];
-		mdef = info["MDDamage"];
-		accuracy = info["acc"];
-		avoid = info["eva"];
-		knockback = info["pushed"];
-		speed = info["speed"];
-		flyspeed = info["flySpeed"];
-		touchdamage = info["bodyAttack"].get_bool();
-		undead = info["undead"].get_bool();
-		noflip = info["noFlip"].get_bool();
-		notattack = info["notAttack"].get_bool();
-		canjump = src["jump"].size() > 0;
-		canfly = src["fly"].size() > 0;
-		canmove = src["move"].size() > 0 || canfly;
-		
-		std::string linkid = info["link"];
-		nl::node link_src = nl::nx::Mob[linkid + ".img"];
-		nl::node link = link_src ? link_src : src;
-		nl::node fly = link["fly"];
-
-		if (canfly)
-		{
-			animations[Stance::STAND] = fly;
-			animations[Stance::MOVE] = fly;
-		}
-		else
-		{
-			animations[Stance::STAND] = link["stand"];
-			animations[Stance::MOVE] = link["move"];
-			
-		}
+		for (auto& iter : data.get_animations())
+			animations.emplace(static_cast<Stance>(iter.first), iter.second);
 
-		animations[Stance::JUMP] = link["jump"];
-		animations[Stance::HIT] = link["hit1"];
-		animations[Stance::DIE] = link["die1"];
-		
-		// Load attack animations if they exist
-		if (link["attack1"])
-			animations[Stance::ATTACK1] = link["attack1"];
-		if (link["attack2"])
-			animations[Stance::ATTACK2] = link["attack2"];
-		if (link["attack3"])
-			animations[Stance::ATTACK3] = link["attack3"];
-		if (link["attack4"])
-			animations[Stance::ATTACK4] = link["attack4"];
-		if (link["skill1"])
-			animations[Stance::SKILL1] = link["skill1"];
-		if (link["skill2"])
-			animations[Stance::SKILL2] = link["skill2"];
-
-		name = nl::nx::String["Mob.img"][std::to_string(mid)]["name"];
-
-		nl::node sndsrc = nl::nx::Sound["Mob.img"][strid];
-
-		hitsound = sndsrc["Damage"];
-		diesound = sndsrc["Die"];
-
-		speed += 100;
-		speed *= 0.001f;
-
-		flyspeed += 100;
-		flyspeed *= 0.0005f;
-
-		if (canfly)
+		if (stats.canfly)
 			phobj.type = PhysicsObject::Type::FLYING;
 
 		id = mid;
@@ -123,6 +49,8 @@ namespace ms
 		hppercent = 0;
 		dying = false;
 		dead = false;
+		aniend = false;
+		stepped = false;
 		fading = false;
 		set_stance(st);
 		flydirection = STRAIGHT;
@@ -130,7 +58,7 @@ namespace ms
 		skill_anim_time = 0;
 		pre_skill_stance = Stance::STAND;
 
-		namelabel = Text(Text::Font::A13M, Text::Alignment::CENTER, Color::Name::WHITE, Text::Background::NAMETAG, name);
+		namelabel = Text(Text::Font::A13M, Text::Alignment::CENTER, Color::Name::WHITE, Text::Background::NAMETAG, data.get_name());
 
 		if (newspawn)
 		{
@@ -179,11 +107,25 @@ namespace ms
 
 	int8_t Mob::update(const Physics& physics)
 	{
+		if (prepare())
+			physics.move_object(phobj);
+
+		return finish(physics);
+	}
+
+	bool Mob::is_batched() const
+	{
+		return true;
+	}
+
+	bool Mob::prepare()
+	{
+		stepped = false;
+
 		if (!active)
-			return phobj.fhlayer;
-			
+			return false;
 
-		bool aniend = animations.at(stance).update();
+		aniend = animations.at(stance).update();
 
 		if (aniend && stance == Stance::DIE)
 			dead = true;
@@ -214,7 +156,7 @@ namespace ms
 		{
 			deactivate();
 
-			return -1;
+			return false;
 		}
 
 		effects.update();
@@ -232,58 +174,69 @@ namespace ms
 			}
 		}
 
-		if (!dying)
+		if (dying)
+			return false;
+
+		if (!stats.canfly)
 		{
-			if (!canfly)
+			if (phobj.is_flag_not_set(PhysicsObject::Flag::TURNATEDGES))
 			{
-				if (phobj.is_flag_not_set(PhysicsObject::Flag::TURNATEDGES))
-				{
-					flip = !flip;
-					phobj.set_flag(PhysicsObject::Flag::TURNATEDGES);
+				flip = !flip;
+				phobj.set_flag(PhysicsObject::Flag::TURNATEDGES);
 
-					if (stance == Stance::HIT)
-						set_stance(Stance::STAND);
-				}
+				if (stance == Stance::HIT)
+					set_stance(Stance::STAND);
 			}
+		}
 
-			switch (stance)
+		switch (stance)
+		{
+		case Stance::MOVE:
+			if (stats.canfly)
 			{
-			case Stance::MOVE:
-				if (canfly)
-				{
-					phobj.hforce = flip ? flyspeed : -flyspeed;
-
-					switch (flydirection)
-					{
-					case FlyDirection::UPWARDS:
-						phobj.vforce = -flyspeed;
-						break;
-					case FlyDirection::DOWNWARDS:
-						phobj.vforce = flyspeed;
-						break;
-					}
-				}
-				else
-				{
-					phobj.hforce = flip ? speed : -speed;
-				}
+				phobj.hforce = flip ? stats.flyspeed : -stats.flyspeed;
 
-				break;
-			case Stance::HIT:
-				if (canmove)
+				switch (flydirection)
 				{
-					double KBFORCE = phobj.onground ? 0.2 : 0.1;
-					phobj.hforce = flip ? -KBFORCE : KBFORCE;
+				case FlyDirection::UPWARDS:
+					phobj.vforce = -stats.flyspeed;
+					break;
+				case FlyDirection::DOWNWARDS:
+					phobj.vforce = stats.flyspeed;
+					break;
 				}
+			}
+			else
+			{
+				phobj.hforce = flip ? stats.speed : -stats.speed;
+			}
 
-				break;
-			case Stance::JUMP:
-				phobj.vforce = -5.0;
-				break;
+			break;
+		case Stance::HIT:
+			if (stats.canmove)
+			{
+				double KBFORCE = phobj.onground ? 0.2 : 0.1;
+				phobj.hforce = flip ? -KBFORCE : KBFORCE;
 			}
 
-			physics.move_object(phobj);
+			break;
+		case Stance::JUMP:
+			phobj.vforce = -5.0;
+			break;
+		}
+
+		stepped = true;
+
+		return true;
+	}
 
+	int8_t Mob::finish(const Physics& physics)
+	{
+		if (!active)
+			return dead ? -1 : phobj.fhlayer;
+
+		if (stepped)
+		{
 			if (control)
 			{
 				counter++;
@@ -313,11 +266,8 @@ namespace ms
 		}
 		else
 		{
-			Point<int16_t> pos_before = phobj.get_position();
 			phobj.normalize();
 			physics.get_fht().update_fh(phobj);
-			Point<int16_t> pos_after = phobj.get_position();
-			
 		}
 
 		return phobj.fhlayer;
@@ -327,9 +277,9 @@ namespace ms
 	{
 		std::cout << "[DEBUG] Mob " << oid << " next_move called - control=" << control 
 		          << ", aggro=" << aggro << ", stance=" << (int)stance 
-		          << ", notattack=" << notattack << ", canmove=" << canmove << std::endl;
+		          << ", notattack=" << stats.notattack << ", canmove=" << stats.canmove << std::endl;
 		
-		if (canmove)
+		if (stats.canmove)
 		{
 			switch (stance)
 			{
@@ -340,7 +290,7 @@ namespace ms
 			case Stance::ATTACK3:
 			case Stance::ATTACK4:
 				// Check if we should attack (50% chance when aggro)
-				if (aggro && notattack == false && randomizer.below(0.5f))
+				if (aggro && stats.notattack == false && randomizer.below(0.5f))
 				{
 					// Try to use attack1 if available
 					if (animations.find(Stance::ATTACK1) != animations.end())
@@ -360,14 +310,14 @@ namespace ms
 				else
 				{
 					std::cout << "[DEBUG] Mob " << oid << " not attacking (aggro=" << aggro 
-				          << ", notattack=" << notattack << ", random failed)" << std::endl;
+				          << ", notattack=" << stats.notattack << ", random failed)" << std::endl;
 					set_stance(Stance::MOVE);
 					flip = randomizer.next_bool();
 				}
 				break;
 			case Stance::MOVE:
 			case Stance::JUMP:
-				if (canjump && phobj.onground && randomizer.below(0.25f))
+				if (stats.canjump && phobj.onground && randomizer.below(0.25f))
 				{
 					set_stance(Stance::JUMP);
 				}
@@ -392,7 +342,7 @@ namespace ms
 				break;
 			}
 
-			if (stance == Stance::MOVE && canfly)
+			if (stance == Stance::MOVE && stats.canfly)
 				flydirection = randomizer.next_enum(FlyDirection::NUM_DIRECTIONS);
 		}
 		else
@@ -408,7 +358,7 @@ namespace ms
 				int16_t distance = std::abs(player_pos.x() - mob_pos.x());
 				bool in_range = distance < 150; // Attack range for stationary mobs
 				
-				if (in_range && notattack == false && randomizer.below(0.3f)) // 30% chance
+				if (in_range && stats.notattack == false && randomizer.below(0.3f)) // 30% chance
 				{
 					if (animations.find(Stance::ATTACK1) != animations.end())
 					{
@@ -472,7 +422,7 @@ namespace ms
 		{
 			float interopc = opacity.get(alpha);
 
-			animations.at(stance).draw(DrawArgument(absp, flip && !noflip, interopc), alpha);
+			animations.at(stance).draw(DrawArgument(absp, flip && !stats.noflip, interopc), alpha);
 
 			if (showhp)
 			{
@@ -486,6 +436,29 @@ namespace ms
 		effects.drawabove(absp, alpha);
 	}
 
+	Rectangle<int16_t> Mob::get_extents() const
+	{
+		auto iter = animations.find(stance);
+
+		if (iter == animations.end())
+			return MapObject::get_extents();
+
+		Rectangle<int16_t> stance_extents = iter->second.get_extents();
+		Point<int16_t> position = get_position();
+
+		// Leave room for the name tag below and the hp bar and effects above
+		Rectangle<int16_t> extents(
+			stance_extents.left() - 100,
+			stance_extents.right() + 100,
+			stance_extents.top() - 100,
+			stance_extents.bottom() + 40
+		);
+
+		extents.shift(position);
+
+		return extents;
+	}
+
 	void Mob::set_control(int8_t mode)
 	{
 		control = mode > 0;
@@ -524,7 +497,7 @@ namespace ms
 	{
 		Point<int16_t> head = animations.at(stance).get_head();
 
-		position.shift_x((flip && !noflip) ? -head.x() : head.x());
+		position.shift_x((flip && !stats.noflip) ? -head.x() : head.x());
 		position.shift_y(head.y());
 
 		return position;
@@ -553,7 +526,7 @@ namespace ms
 	{
 		if (hppercent == 0)
 		{
-			int16_t delta = playerlevel - level;
+			int16_t delta = playerlevel - stats.level;
 
 			if (delta > 9)
 				namelabel.change_color(Color::Name::YELLOW);
@@ -660,18 +633,11 @@ namespace ms
 		
 		
 		// Add skill-specific visual effects based on skill_id
-		// Load skill effect from WZ files if available
-		std::string skill_str = std::to_string(skill_id);
-		nl::node skill_node = nl::nx::Skill["MobSkill.img"][skill_str]["level"]["1"]["mob"];
-		
-		if (skill_node)
-		{
-			Animation skill_effect(skill_node);
-			// Show the effect at the mob's position
-			show_effect(skill_effect, 0, 1, false);
-			// Skill effect shown
-		}
-		
+		const MobSkillData& skilldata = MobSkillData::get(skill_id);
+
+		if (skilldata.has_effect())
+			show_effect(skilldata.get_effect(), 0, 1, false);
+
 		// For projectile skills, we need to handle them separately
 		// These would need to be spawned as separate objects that move toward the player
 	}
@@ -679,7 +645,7 @@ namespace ms
 	float Mob::calculate_hitchance(int16_t leveldelta, int32_t player_accuracy) const
 	{
 		float faccuracy = static_cast<float>(player_accuracy);
-		float hitchance = faccuracy / (((1.84f + 0.07f * leveldelta) * avoid) + 1.0f);
+		float hitchance = faccuracy / (((1.84f + 0.07f * leveldelta) * stats.avoid) + 1.0f);
 
 		if (hitchance < 0.01f)
 			hitchance = 0.01f;
@@ -691,8 +657,8 @@ namespace ms
 	{
 		double mindamage =
 			magic ?
-			damage - (1 + 0.01 * leveldelta) * mdef * 0.6 :
-			damage * (1 - 0.01 * leveldelta) - wdef * 0.6;
+			damage - (1 + 0.01 * leveldelta) * stats.mdef * 0.6 :
+			damage * (1 - 0.01 * leveldelta) - stats.wdef * 0.6;
 
 		return mindamage < 1.0 ? 1.0 : mindamage;
 	}
@@ -701,8 +667,8 @@ namespace ms
 	{
 		double maxdamage =
 			magic ?
-			damage - (1 + 0.01 * leveldelta) * mdef * 0.5 :
-			damage * (1 - 0.01 * leveldelta) - wdef * 0.5;
+			damage - (1 + 0.01 * leveldelta) * stats.mdef * 0.5 :
+			damage * (1 - 0.01 * leveldelta) - stats.wdef * 0.5;
 
 		return maxdamage < 1.0 ? 1.0 : maxdamage;
 	}
@@ -713,7 +679,7 @@ namespace ms
 		double maxdamage;
 		float hitchance;
 		float critical;
-		int16_t leveldelta = level - attack.playerlevel;
+		int16_t leveldelta = stats.level - attack.playerlevel;
 
 		if (leveldelta < 0)
 			leveldelta = 0;
@@ -779,13 +745,13 @@ namespace ms
 
 	void Mob::apply_damage(int32_t damage, bool toleft)
 	{
-		hitsound.play();
+		data.get_hitsound().play();
 
 		if (dying && stance != Stance::DIE)
 		{
 			apply_death();
 		}
-		else if (control && is_alive() && damage >= knockback)
+		else if (control && is_alive() && damage >= stats.knockback)
 		{
 			flip = toleft;
 			counter = 170;
@@ -797,11 +763,11 @@ namespace ms
 
 	MobAttack Mob::create_touch_attack() const
 	{
-		if (!touchdamage)
+		if (!stats.touchdamage)
 			return MobAttack();
 
-		int32_t minattack = static_cast<int32_t>(watk * 0.8f);
-		int32_t maxattack = watk;
+		int32_t minattack = static_cast<int32_t>(stats.watk * 0.8f);
+		int32_t maxattack = stats.watk;
 		int32_t attack = randomizer.next_int(minattack, maxattack);
 
 		return MobAttack(attack, get_position(), id, oid);
@@ -810,7 +776,7 @@ namespace ms
 	void Mob::apply_death()
 	{
 		set_stance(Stance::DIE);
-		diesound.play();
+		data.get_diesound().play();
 		dying = true;
 	}
 
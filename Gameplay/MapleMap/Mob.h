@@ -24,7 +24,7 @@
 #include "../Combat/Attack.h"
 #include "../Combat/Bullet.h"
 
-#include "../../Audio/Audio.h"
+#include "../../Data/MobData.h"
 #include "../../Graphics/EffectLayer.h"
 #include "../../Graphics/Geometry.h"
 #include "../../Util/Randomizer.h"
@@ -88,6 +88,14 @@ namespace ms
 		void draw(double viewx, double viewy, float alpha) const override;
 		// Update movement and animations
 		int8_t update(const Physics& physics) override;
+		// Mobs are moved in the batched physics step
+		bool is_batched() const override;
+		// Update animations and apply the forces of the current stance
+		bool prepare() override;
+		// Decide on the next move after the mob was moved
+		int8_t finish(const Physics& physics) override;
+		// Return the area covered by the current stance, the name tag and the hp bar
+		Rectangle<int16_t> get_extents() const override;
 
 		// Change this mob's control mode:
 		// 0 - no control, 1 - control, 2 - aggro
@@ -154,27 +162,10 @@ namespace ms
 		// Return the current 'head' position
 		Point<int16_t> get_head_position(Point<int16_t> position) const;
 
+		const MobData& data;
+		const MobData::Stats& stats;
+
 		std::map<Stance, Animation> animations;
-		std::string name;
-		Sound hitsound;
-		Sound diesound;
-		uint16_t level;
-		float speed;
-		float flyspeed;
-		uint16_t watk;
-		uint16_t matk;
-		uint16_t wdef;
-		uint16_t mdef;
-		uint16_t accuracy;
-		uint16_t avoid;
-		uint16_t knockback;
-		bool undead;
-		bool touchdamage;
-		bool noflip;
-		bool notattack;
-		bool canmove;
-		bool canjump;
-		bool canfly;
 
 		EffectLayer effects;
 		Text namelabel;
@@ -191,6 +182,8 @@ namespace ms
 		int8_t team;
 		bool dying;
 		bool dead;
+		bool aniend;
+		bool stepped;
 		bool control;
 		bool aggro;
 		Stance stance;
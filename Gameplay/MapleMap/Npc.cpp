@@ -18,6 +18,7 @@
 #include "Npc.h"
 
 #include <codecvt>
+#include <locale>
 
 #ifdef USE_NX
 #include <nlnx/nx.hpp>
@@ -88,8 +89,8 @@ namespace ms
 				lines[state].push_back(strsrc[speaknode.get_string()]);
 		}
 
-		name = strsrc["name"];
-		func = strsrc["func"];
+		name = strsrc["name"].get_string();
+		func = strsrc["func"].get_string();
 
 		std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
 		std::wstring wide = converter.from_bytes(func);
@@ -29,6 +29,9 @@ namespace ms
 		pos = Point<int16_t>(src["x"], src["y"]);
 		flip = src["f"].get_bool();
 		z = src["z"];
+
+		extents = animation.get_extents();
+		extents.shift(pos);
 	}
 
 	void Obj::update()
@@ -45,4 +48,14 @@ namespace ms
 	{
 		return z;
 	}
+
+	const Rectangle<int16_t>& Obj::get_extents() const
+	{
+		return extents;
+	}
+
+	bool Obj::is_static() const
+	{
+		return animation.is_static();
+	}
 }
\ No newline at end of file
@@ -33,11 +33,16 @@ namespace ms
 		void draw(Point<int16_t> viewpos, float inter) const;
 		// Return the depth of the object
 		uint8_t getz() const;
+		// Return the area covered by the object on the map
+		const Rectangle<int16_t>& get_extents() const;
+		// Check whether the object never changes, so it can be baked
+		bool is_static() const;
 
 	private:
 		Animation animation;
 		Point<int16_t> pos;
 		uint8_t z;
 		bool flip;
+		Rectangle<int16_t> extents;
 	};
 }
\ No newline at end of file
@@ -57,6 +57,9 @@ namespace ms
 
 		if (z == 0)
 			z = dsrc["zM"];
+
+		Point<int16_t> lt = pos - texture.get_origin();
+		extents = Rectangle<int16_t>(lt, lt + texture.get_dimensions());
 	}
 
 	void Tile::draw(Point<int16_t> viewpos) const
@@ -68,4 +71,9 @@ namespace ms
 	{
 		return z;
 	}
+
+	const Rectangle<int16_t>& Tile::get_extents() const
+	{
+		return extents;
+	}
 }
\ No newline at end of file
@@ -35,10 +35,13 @@ namespace ms
 		void draw(Point<int16_t> viewpos) const;
 		// Returns the depth of the tile
 		uint8_t getz() const;
+		// Returns the area covered by the tile on the map
+		const Rectangle<int16_t>& get_extents() const;
 
 	private:
 		Texture texture;
 		Point<int16_t> pos;
 		uint8_t z;
+		Rectangle<int16_t> extents;
 	};
 }
\ No newline at end of file
@@ -17,6 +17,7 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "FootholdTree.h"
 
+#include <algorithm>
 #include <iostream>
 #include "../../Util/Misc.h"
 
@@ -59,11 +60,14 @@ namespace ms
 						continue;
 					}
 
-					const Foothold& foothold = footholds.emplace(
-						std::piecewise_construct,
-						std::forward_as_tuple(id),
-						std::forward_as_tuple(lastf, id, layer)
-					).first->second;
+					if (id >= footholds.size())
+						footholds.resize(id + 1);
+
+					// Keep the first foothold if an id is used twice
+					if (footholds[id].id() > 0)
+						continue;
+
+					const Foothold& foothold = footholds[id] = Foothold(lastf, id, layer);
 
 					if (foothold.l() < leftw)
 						leftw = foothold.l();
@@ -76,19 +80,12 @@ namespace ms
 
 					if (foothold.t() < topb)
 						topb = foothold.t();
-
-					if (foothold.is_wall())
-						continue;
-
-					int16_t start = foothold.l();
-					int16_t end = foothold.r();
-
-					for (int16_t i = start; i <= end; i++)
-						footholdsbyx.emplace(i, id);
 				}
 			}
 		}
 
+		build_columns();
+
 		// Validate foothold data and provide safe defaults
 		bool hasValidFootholds = !footholds.empty();
 		
@@ -136,7 +133,66 @@ namespace ms
 		
 	}
 
-	FootholdTree::FootholdTree() {}
+	FootholdTree::FootholdTree() : columnleft(0) {}
+
+	void FootholdTree::build_columns()
+	{
+		columnids.clear();
+		columnstart.clear();
+		columnleft = 0;
+
+		int16_t left = 30000;
+		int16_t right = -30000;
+
+		for (auto& fh : footholds)
+		{
+			if (!fh.id() || fh.is_wall())
+				continue;
+
+			left = std::min(left, fh.l());
+			right = std::max(right, fh.r());
+		}
+
+		if (left > right)
+			return;
+
+		columnleft = left;
+
+		size_t columns = ((right - left) >> COLUMNSHIFT) + 1;
+		columnstart.assign(columns + 1, 0);
+
+		// Count the floors per column, then turn the counts into offsets and fill them in
+		for (auto& fh : footholds)
+		{
+			if (!fh.id() || fh.is_wall())
+				continue;
+
+			size_t first = (fh.l() - left) >> COLUMNSHIFT;
+			size_t last = (fh.r() - left) >> COLUMNSHIFT;
+
+			for (size_t c = first; c <= last; c++)
+				columnstart[c + 1]++;
+		}
+
+		for (size_t c = 0; c < columns; c++)
+			columnstart[c + 1] += columnstart[c];
+
+		columnids.resize(columnstart[columns]);
+
+		std::vector<uint32_t> fill(columnstart.begin(), columnstart.end() - 1);
+
+		for (auto& fh : footholds)
+		{
+			if (!fh.id() || fh.is_wall())
+				continue;
+
+			size_t first = (fh.l() - left) >> COLUMNSHIFT;
+			size_t last = (fh.r() - left) >> COLUMNSHIFT;
+
+			for (size_t c = first; c <= last; c++)
+				columnids[fill[c]++] = fh.id();
+		}
+	}
 
 	void FootholdTree::limit_movement(PhysicsObject& phobj) const
 	{
@@ -276,12 +332,10 @@ namespace ms
 
 	const Foothold& FootholdTree::get_fh(uint16_t fhid) const
 	{
-		auto iter = footholds.find(fhid);
-
-		if (iter == footholds.end())
+		if (fhid >= footholds.size())
 			return nullfh;
 
-		return iter->second;
+		return footholds[fhid];
 	}
 
 	double FootholdTree::get_wall(uint16_t curid, bool left, double fy) const
@@ -362,11 +416,23 @@ namespace ms
 		double comp = borders.second();
 
 		int16_t x = static_cast<int16_t>(fx);
-		auto range = footholdsbyx.equal_range(x);
 
-		for (auto iter = range.first; iter != range.second; ++iter)
+		if (columnstart.empty() || x < columnleft)
+			return 0;
+
+		size_t column = (x - columnleft) >> COLUMNSHIFT;
+
+		if (column + 1 >= columnstart.size())
+			return 0;
+
+		for (uint32_t i = columnstart[column]; i < columnstart[column + 1]; i++)
 		{
-			const Foothold& fh = footholds.at(iter->second);
+			const Foothold& fh = footholds[columnids[i]];
+
+			// A column is wider than a single x-coordinate
+			if (x < fh.l() || x > fh.r())
+				continue;
+
 			double ycomp = fh.ground_below(fx);
 
 			if (comp >= ycomp && ycomp >= fy)
@@ -20,7 +20,7 @@
 #include "Foothold.h"
 #include "PhysicsObject.h"
 
-#include <unordered_map>
+#include <vector>
 
 namespace ms
 {
@@ -48,9 +48,17 @@ namespace ms
 		double get_wall(uint16_t fhid, bool left, double fy) const;
 		double get_edge(uint16_t fhid, bool left) const;
 		const Foothold& get_fh(uint16_t fhid) const;
+		void build_columns();
 
-		std::unordered_map<uint16_t, Foothold> footholds;
-		std::unordered_multimap<int16_t, uint16_t> footholdsbyx;
+		// Columns which footholds are sorted into are 1 << COLUMNSHIFT pixels wide
+		static const int16_t COLUMNSHIFT = 6;
+
+		// Footholds indexed by id, ids which are not used hold an empty foothold
+		std::vector<Foothold> footholds;
+		// Ids of the floors overlapping each column, column i owns [columnstart[i], columnstart[i + 1])
+		std::vector<uint16_t> columnids;
+		std::vector<uint32_t> columnstart;
+		int16_t columnleft;
 
 		Foothold nullfh;
 		Range<int16_t> walls;
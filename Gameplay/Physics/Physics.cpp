@@ -16,8 +16,10 @@
 //	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
 //////////////////////////////////////////////////////////////////////////////////
 #include "Physics.h"
+
+#include <algorithm>
+#include <cmath>
 #include <iostream>
-#include <unordered_map>
 
 namespace ms
 {
@@ -38,13 +40,6 @@ namespace ms
 
 	void Physics::move_object(PhysicsObject& phobj) const
 	{
-		// Store previous position for oscillation detection
-		static std::unordered_map<void*, double> lastYPositions;
-		static std::unordered_map<void*, int> oscillationCounters;
-		
-		double prevY = lastYPositions[&phobj];
-		double currentY = phobj.crnt_y();
-		
 		// Determine which platform the object is currently on
 		fht.update_fh(phobj);
 
@@ -68,6 +63,73 @@ namespace ms
 			break;
 		}
 
+		finish_move(phobj);
+	}
+
+	void Physics::move_objects(PhysicsObject* const* tomove, size_t count) const
+	{
+		bodies.clear();
+
+		// Platforms and the rarer engines are handled one object at a time
+		for (size_t i = 0; i < count; i++)
+		{
+			PhysicsObject& phobj = *tomove[i];
+
+			fht.update_fh(phobj);
+
+			switch (phobj.type)
+			{
+			case PhysicsObject::Type::NORMAL:
+				bodies.push(static_cast<uint32_t>(i), phobj);
+				break;
+			case PhysicsObject::Type::FLYING:
+				move_flying(phobj);
+				break;
+			case PhysicsObject::Type::SWIMMING:
+				move_swimming(phobj);
+				break;
+			default:
+				break;
+			}
+		}
+
+		move_normal_batch();
+
+		for (size_t k = 0; k < bodies.size(); k++)
+		{
+			PhysicsObject& phobj = *tomove[bodies.index[k]];
+
+			phobj.hspeed = bodies.hspeed[k];
+			phobj.vspeed = bodies.vspeed[k];
+			phobj.hacc = bodies.hacc[k];
+			phobj.vacc = bodies.vacc[k];
+			phobj.hforce = 0.0;
+			phobj.vforce = 0.0;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			PhysicsObject& phobj = *tomove[i];
+
+			switch (phobj.type)
+			{
+			case PhysicsObject::Type::NORMAL:
+			case PhysicsObject::Type::FLYING:
+			case PhysicsObject::Type::SWIMMING:
+				fht.limit_movement(phobj);
+				break;
+			default:
+				break;
+			}
+
+			finish_move(phobj);
+		}
+	}
+
+	void Physics::finish_move(PhysicsObject& phobj) const
+	{
+		double prevY = phobj.lasty;
+
 		// Clamp extreme positions as safety net
 		const double MAX_SAFE_Y = 5000.0;
 		const double MIN_SAFE_Y = -5000.0;
@@ -90,9 +152,9 @@ namespace ms
 		
 		// Detect large position changes (potential oscillation)
 		if (yDelta > 1000.0) {
-			oscillationCounters[&phobj]++;
+			phobj.oscillations++;
 			
-			if (oscillationCounters[&phobj] >= 2) {
+			if (phobj.oscillations >= 2) {
 				// Emergency stabilization
 				double midY = (prevY + newY) / 2.0;
 				if (std::abs(midY) > 2000.0) {
@@ -105,15 +167,15 @@ namespace ms
 				phobj.onground = true;  // Force ground state to stop gravity
 				
 				// Reset counter after fixing
-				oscillationCounters[&phobj] = 0;
+				phobj.oscillations = 0;
 			}
 		} else {
 			// Reset counter if movement is normal
-			oscillationCounters[&phobj] = 0;
+			phobj.oscillations = 0;
 		}
 		
 		// Update position history
-		lastYPositions[&phobj] = newY;
+		phobj.lasty = newY;
 	}
 
 	void Physics::move_normal(PhysicsObject& phobj) const
@@ -155,6 +217,74 @@ namespace ms
 		phobj.vspeed += phobj.vacc;
 	}
 
+	void Physics::move_normal_batch() const
+	{
+		size_t count = bodies.size();
+
+		double* hspeed = bodies.hspeed.data();
+		double* vspeed = bodies.vspeed.data();
+		double* hacc = bodies.hacc.data();
+		double* vacc = bodies.vacc.data();
+		const double* hforce = bodies.hforce.data();
+		const double* vforce = bodies.vforce.data();
+		const double* fhslope = bodies.fhslope.data();
+		const uint8_t* onground = bodies.onground.data();
+		const uint8_t* gravity = bodies.gravity.data();
+
+		// Same as move_normal, written without early exits so the compiler can vectorize it
+		for (size_t k = 0; k < count; k++)
+		{
+			double hs = hspeed[k];
+			double inertia = hs / GROUNDSLIP;
+			double slopef = std::min(0.5, std::max(-0.5, fhslope[k]));
+			double friction = (FRICTION + SLOPEFACTOR * (1.0 + slopef * -inertia)) * inertia;
+			bool resting = hforce[k] == 0.0 && hs < 0.1 && hs > -0.1;
+
+			double ha = onground[k] ? hforce[k] - (resting ? 0.0 : friction) : 0.0;
+			double va = onground[k] ? vforce[k] : (gravity[k] ? GRAVFORCE : 0.0);
+
+			hs = (onground[k] && resting) ? 0.0 : hs;
+
+			hacc[k] = ha;
+			vacc[k] = va;
+			hspeed[k] = hs + ha;
+			vspeed[k] += va;
+		}
+	}
+
+	void Physics::Bodies::clear()
+	{
+		index.clear();
+		hspeed.clear();
+		vspeed.clear();
+		hforce.clear();
+		vforce.clear();
+		hacc.clear();
+		vacc.clear();
+		fhslope.clear();
+		onground.clear();
+		gravity.clear();
+	}
+
+	void Physics::Bodies::push(uint32_t i, const PhysicsObject& phobj)
+	{
+		index.push_back(i);
+		hspeed.push_back(phobj.hspeed);
+		vspeed.push_back(phobj.vspeed);
+		hforce.push_back(phobj.hforce);
+		vforce.push_back(phobj.vforce);
+		hacc.push_back(0.0);
+		vacc.push_back(0.0);
+		fhslope.push_back(phobj.fhslope);
+		onground.push_back(phobj.onground);
+		gravity.push_back(!(phobj.flags & PhysicsObject::Flag::NOGRAVITY));
+	}
+
+	size_t Physics::Bodies::size() const
+	{
+		return index.size();
+	}
+
 	void Physics::move_flying(PhysicsObject& phobj) const
 	{
 		phobj.hacc = phobj.hforce;
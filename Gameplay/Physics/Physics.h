@@ -19,6 +19,8 @@
 
 #include "FootholdTree.h"
 
+#include <vector>
+
 namespace ms
 {
 	// Class that uses physics engines and the collection of platforms to determine object movement
@@ -30,6 +32,8 @@ namespace ms
 
 		// Move the specified object over the specified game-time
 		void move_object(PhysicsObject& tomove) const;
+		// Move all specified objects, the forces of normal objects are stepped together in one pass
+		void move_objects(PhysicsObject* const* tomove, size_t count) const;
 		// Determine the point on the ground below the specified position
 		Point<int16_t> get_y_below(Point<int16_t> position) const;
 		// Return a reference to the collection of platforms
@@ -39,7 +43,30 @@ namespace ms
 		void move_normal(PhysicsObject&) const;
 		void move_flying(PhysicsObject&) const;
 		void move_swimming(PhysicsObject&) const;
+		void move_normal_batch() const;
+		void finish_move(PhysicsObject&) const;
+
+		// Structure of arrays for the normal objects of one batched step
+		struct Bodies
+		{
+			std::vector<uint32_t> index;
+			std::vector<double> hspeed;
+			std::vector<double> vspeed;
+			std::vector<double> hforce;
+			std::vector<double> vforce;
+			std::vector<double> hacc;
+			std::vector<double> vacc;
+			std::vector<double> fhslope;
+			std::vector<uint8_t> onground;
+			std::vector<uint8_t> gravity;
+
+			void clear();
+			void push(uint32_t i, const PhysicsObject& phobj);
+			size_t size() const;
+		};
 
 		FootholdTree fht;
+		// Kept between ticks so the batched step does not allocate
+		mutable Bodies bodies;
 	};
 }
\ No newline at end of file
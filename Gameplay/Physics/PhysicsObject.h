@@ -206,6 +206,10 @@ namespace ms
 		double hacc = 0.0;
 		double vacc = 0.0;
 
+		// Position after the last step and number of large jumps in a row, used to detect oscillation
+		double lasty = 0.0;
+		int32_t oscillations = 0;
+
 		bool is_flag_set(Flag f)
 		{
 			return (flags & f) != 0;
@@ -16,6 +16,7 @@
 //	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
 //////////////////////////////////////////////////////////////////////////////////
 #include "Stage.h"
+#include "MapleMap/MapPrefetcher.h"
 
 #include "../Configuration.h"
 
@@ -27,6 +28,8 @@
 #include "../Net/Packets/AttackAndSkillPackets.h"
 #include "../Net/Packets/GameplayPackets.h"
 #include "../Util/Misc.h"
+#include "../Util/NodeCache.h"
+#include "../Util/Profiler.h"
 
 #ifdef USE_NX
 #include <nlnx/nx.hpp>
@@ -37,6 +40,10 @@ namespace ms
 	Stage::Stage() : combat(player, chars, mobs, reactors)
 	{
 		state = State::INACTIVE;
+		loadstep = LoadStep::LOADED;
+		loadlayer = 0;
+		loadportal = 0;
+		loadframes = 0;
 	}
 
 	void Stage::init()
@@ -69,12 +76,81 @@ namespace ms
 					}
 					respawn(portalid);
 				break;
+			case State::LOADING:
+				// Finish a staged load of the same map right away
+				while (loadstep != LoadStep::LOADED)
+					load_step();
+
+				respawn(portalid);
+				break;
 			case State::ACTIVE:
 				// Already active, skip loading
 				LOG(LOG_DEBUG, "[Stage] Already active, skipping load");
 				return;
 		}
 
+		activate();
+	}
+
+	void Stage::load_staged(int32_t mapid, int8_t portalid)
+	{
+		LOG(LOG_DEBUG, "[Stage] load_staged() called - mapid: " << mapid << ", portalid: " << (int)portalid << ", current state: " << (int)state);
+
+		// Like 'load()', keep a map which is already active
+		if (state == State::ACTIVE && mapid == Stage::mapid)
+			return;
+
+		clear();
+		begin_map(mapid);
+
+		loadportal = portalid;
+		loadstart = std::chrono::steady_clock::now();
+		loadframes = 0;
+		state = State::LOADING;
+	}
+
+	void Stage::continue_load()
+	{
+		if (state != State::LOADING)
+			return;
+
+		ScopedTimer timer(Profiler::Section::MAP_LOAD);
+
+		auto budget = std::chrono::milliseconds(Setting<MapLoadBudget>::get().load());
+		auto begin = std::chrono::steady_clock::now();
+
+		loadframes++;
+
+		// At least one step runs every frame, so even a budget of zero makes progress
+		do
+		{
+			load_step();
+		}
+		while (loadstep != LoadStep::LOADED && std::chrono::steady_clock::now() - begin < budget);
+
+		if (loadstep != LoadStep::LOADED)
+			return;
+
+		respawn(loadportal);
+		activate();
+
+		LOG(LOG_DEBUG, "[Stage] Map " << mapid << " loaded in "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - loadstart).count()
+			<< " ms over " << loadframes << " frames");
+	}
+
+	bool Stage::is_loading() const
+	{
+		return state == State::LOADING;
+	}
+
+	bool Stage::is_loaded(int32_t mapid) const
+	{
+		return state == State::ACTIVE && Stage::mapid == mapid;
+	}
+
+	void Stage::activate()
+	{
 		state = State::ACTIVE;
 		LOG(LOG_DEBUG, "[Stage] Map loaded successfully, state set to ACTIVE");
 		
@@ -109,82 +185,152 @@ namespace ms
 	}
 
 	void Stage::load_map(int32_t mapid)
+	{
+		begin_map(mapid);
+
+		while (loadstep != LoadStep::LOADED)
+			load_step();
+	}
+
+	void Stage::begin_map(int32_t mapid)
 	{
 		Stage::mapid = mapid;
 		LOG(LOG_DEBUG, "[Stage] Loading map: " << mapid);
 
-		std::string strid = string_format::extend_id(mapid, 9);
-		std::string prefix = std::to_string(mapid / 100000000);
-		LOG(LOG_DEBUG, "[Stage] Map file path: Map" << prefix << "/" << strid << ".img");
+		LOG(LOG_DEBUG, "[Stage] Map file path: Map" << mapid / 100000000 << "/" << string_format::extend_id(mapid, 9) << ".img");
 
-		// Try Map002 fallback, then direct Map (v83)
-		nl::node src;
-		if (mapid == -1) {
-			src = nl::nx::UI["CashShopPreview.img"];
-		} else {
-			src = nl::nx::Map002["Map"]["Map" + prefix][strid + ".img"];
-			if (src.name().empty()) {
-				src = nl::nx::Map["Map"]["Map" + prefix][strid + ".img"];
-			}
-			
-			// Fix: Fallback again if critical nodes are missing (v87 compatibility)
-			if (src["portal"].size() == 0 || src["life"].size() == 0) {
-				nl::node alt = nl::nx::Map["Map"]["Map" + prefix][strid + ".img"];
-				if (!alt.name().empty()) {
-					src = alt;  // use classic map that contains full data
+		// Maps behind the portals of the previous map may already be parsed
+		prepared = MapPrefetcher::get().take(mapid);
+		loadsrc = prepared ? prepared->src : find_map(mapid);
+
+		loadstep = LoadStep::FOOTHOLDS;
+		loadlayer = 0;
+
+		// The layers are loaded one at a time, so drop those of the previous map
+		tilesobjs = MapTilesObjs();
+	}
+
+	void Stage::load_step()
+	{
+		nl::node src = loadsrc;
+
+		switch (loadstep)
+		{
+			case LoadStep::FOOTHOLDS:
+			{
+				// Debug: Check if foothold data exists
+				nl::node foothold_node = src["foothold"];
+				if (foothold_node.name().empty()) {
+					LOG(LOG_ERROR, "[Stage] No foothold data found for map " << mapid << " - players will fall through!");
+				} else {
+#ifdef _DEBUG
+					// Only counted for the log, which release builds compile out
+					size_t foothold_count = 0;
+					for (auto group : foothold_node) {
+						for (auto cat : group) {
+							foothold_count += cat.size();
+						}
+					}
+					LOG(LOG_DEBUG, "[Stage] Found " << foothold_count << " footholds for map " << mapid);
+#endif
+				}
+
+				if (prepared)
+				{
+					physics = std::move(prepared->physics);
+					mapinfo = std::move(prepared->mapinfo);
+				}
+				else
+				{
+					physics = Physics(src["foothold"]);
+					mapinfo = MapInfo(src, physics.get_fht().get_walls(), physics.get_fht().get_borders());
 				}
+
+				loadstep = LoadStep::PORTALS;
+				break;
 			}
-		}
+			case LoadStep::PORTALS:
+			{
+				// Debug: Check portal data
+				nl::node portal_node = src["portal"];
+				if (portal_node.name().empty()) {
+					LOG(LOG_ERROR, "[Stage] No portal data found for map " << mapid << " - spawn will fail!");
+				}
 
-		tilesobjs = MapTilesObjs(src);
-		backgrounds = MapBackgrounds(src["back"]);
-		
-		// Debug: Check if foothold data exists
-		nl::node foothold_node = src["foothold"];
-		if (foothold_node.name().empty()) {
-			LOG(LOG_ERROR, "[Stage] No foothold data found for map " << mapid << " - players will fall through!");
-		} else {
-			int foothold_count = 0;
-			for (auto group : foothold_node) {
-				for (auto cat : group) {
-					for (auto fh : cat) {
-						foothold_count++;
+				portals = prepared ? std::move(prepared->portals) : MapPortals(src["portal"], mapid);
+				LOG(LOG_DEBUG, "[Stage] Loaded " << portals.get_portal_count() << " portals for map " << mapid);
+
+				prepared.reset();
+
+				// Check if map has NPC life data that should be loaded
+				nl::node life_node = src["life"];
+				if (!life_node.name().empty()) {
+					int npc_count = 0;
+					for (auto life_entry : life_node) {
+						std::string type = life_entry["type"];
+						if (type == "n") { // NPC
+							npc_count++;
+							LOG(LOG_DEBUG, "[Stage] Found NPC in map data: ID=" << (int)life_entry["id"] 
+								<< ", pos=(" << (int)life_entry["x"] << "," << (int)life_entry["y"] << ")");
+						}
 					}
+					LOG(LOG_DEBUG, "[Stage] Map " << mapid << " has " << npc_count << " NPCs in life data (waiting for server spawn packets)");
+				} else {
+					LOG(LOG_DEBUG, "[Stage] Map " << mapid << " has no life data node");
 				}
+
+				// NPCs are loaded through network packets from the server, not from map data
+
+				loadstep = LoadStep::BACKGROUNDS;
+				break;
 			}
-			LOG(LOG_DEBUG, "[Stage] Found " << foothold_count << " footholds for map " << mapid);
-		}
-		
-		physics = Physics(src["foothold"]);
-		mapinfo = MapInfo(src, physics.get_fht().get_walls(), physics.get_fht().get_borders());
-		
-		// Debug: Check portal data
-		nl::node portal_node = src["portal"];
-		if (portal_node.name().empty()) {
-			LOG(LOG_ERROR, "[Stage] No portal data found for map " << mapid << " - spawn will fail!");
+			case LoadStep::BACKGROUNDS:
+				backgrounds = MapBackgrounds(src["back"]);
+
+				loadstep = LoadStep::TILESOBJS;
+				break;
+			case LoadStep::TILESOBJS:
+				// One layer per step, baking a crowded layer takes a while
+				tilesobjs.load(src, static_cast<Layer::Id>(loadlayer));
+
+				if (++loadlayer < Layer::Id::LENGTH)
+					break;
+
+				// The prefetcher's thread would compete with the map being loaded
+				MapPrefetcher::get().prefetch(portals.get_target_maps());
+
+				loadstep = LoadStep::LOADED;
+				break;
+			case LoadStep::LOADED:
+				break;
 		}
-		
-		portals = MapPortals(src["portal"], mapid);
-		LOG(LOG_DEBUG, "[Stage] Loaded " << portals.get_portal_count() << " portals for map " << mapid);
-		
-		// Check if map has NPC life data that should be loaded
-		nl::node life_node = src["life"];
-		if (!life_node.name().empty()) {
-			int npc_count = 0;
-			for (auto life_entry : life_node) {
-				std::string type = life_entry["type"];
-				if (type == "n") { // NPC
-					npc_count++;
-					LOG(LOG_DEBUG, "[Stage] Found NPC in map data: ID=" << (int)life_entry["id"] 
-						<< ", pos=(" << (int)life_entry["x"] << "," << (int)life_entry["y"] << ")");
-				}
-			}
-			LOG(LOG_DEBUG, "[Stage] Map " << mapid << " has " << npc_count << " NPCs in life data (waiting for server spawn packets)");
-		} else {
-			LOG(LOG_DEBUG, "[Stage] Map " << mapid << " has no life data node");
+	}
+
+	nl::node Stage::find_map(int32_t mapid)
+	{
+		if (mapid == -1)
+			return nl::nx::UI["CashShopPreview.img"];
+
+		int32_t prefix = mapid / 100000000;
+
+		// Try Map002 fallback, then direct Map (v83)
+		NodeCache& nodes = NodeCache::get();
+		nl::node src = nodes.resolve_format("Map002/Map/Map%d/%09d.img", prefix, mapid);
+
+		if (src.name().empty())
+			src = nodes.resolve_format("Map/Map/Map%d/%09d.img", prefix, mapid);
+
+		// Fix: Fallback again if critical nodes are missing (v87 compatibility)
+		if (src["portal"].size() == 0 || src["life"].size() == 0)
+		{
+			nl::node alt = nodes.resolve_format("Map/Map/Map%d/%09d.img", prefix, mapid);
+
+			// Use classic map that contains full data
+			if (!alt.name().empty())
+				src = alt;
 		}
-		
-		// NPCs are loaded through network packets from the server, not from map data
+
+		return src;
 	}
 
 	void Stage::respawn(int8_t portalid)
@@ -240,6 +386,8 @@ namespace ms
 
 	void Stage::draw(float alpha) const
 	{
+		ScopedTimer timer(Profiler::Section::STAGE_DRAW);
+
 		if (state != State::ACTIVE) {
 			// Stage is not active - don't draw anything during login screens
 			return;
@@ -275,6 +423,8 @@ namespace ms
 
 	void Stage::update()
 	{
+		ScopedTimer timer(Profiler::Section::STAGE_UPDATE);
+
 		static int stage_update_count = 0;
 		// if (stage_update_count++ % 60 == 0) {
 		//	printf("[Stage::update] Called #%d, state=%d (ACTIVE=%d)\n", stage_update_count, (int)state, (int)State::ACTIVE);
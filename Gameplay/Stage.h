@@ -23,6 +23,7 @@
 #include "MapleMap/MapEffect.h"
 #include "MapleMap/MapNpcs.h"
 #include "MapleMap/MapPortals.h"
+#include "MapleMap/MapPrefetcher.h"
 #include "MapleMap/MapTilesObjs.h"
 
 #include "../Timer.h"
@@ -40,6 +41,14 @@ namespace ms
 
 		// Loads the map to display
 		void load(int32_t mapid, int8_t portalid);
+		// Start loading a map in steps, which 'continue_load()' runs over the following frames
+		void load_staged(int32_t mapid, int8_t portalid);
+		// Run steps of a staged load until the budget of this frame is used up
+		void continue_load();
+		// Check if a staged load is still in progress
+		bool is_loading() const;
+		// Check if the specified map finished loading and is active
+		bool is_loaded(int32_t mapid) const;
 		// Remove all map objects and graphics
 		void clear();
 
@@ -101,9 +110,15 @@ namespace ms
 		// Get the current map ID being loaded/active
 		int32_t get_current_mapid() const;
 
+		// Return the source of a map, also used by the map prefetcher's thread
+		static nl::node find_map(int32_t mapid);
+
 	private:
 		void load_map(int32_t mapid);
+		void begin_map(int32_t mapid);
+		void load_step();
 		void respawn(int8_t portalid);
+		void activate();
 		void check_portals();
 		void check_seats();
 		void check_ladders(bool up);
@@ -113,9 +128,20 @@ namespace ms
 		{
 			INACTIVE,
 			TRANSITION,
+			LOADING,
 			ACTIVE
 		};
 
+		// The parts of a map in the order they are loaded, the music plays when the player respawns
+		enum LoadStep
+		{
+			FOOTHOLDS,
+			PORTALS,
+			BACKGROUNDS,
+			TILESOBJS,
+			LOADED
+		};
+
 		Camera camera;
 		Physics physics;
 		Player player;
@@ -124,6 +150,14 @@ namespace ms
 		State state;
 		int32_t mapid;
 
+		LoadStep loadstep;
+		uint8_t loadlayer;
+		int8_t loadportal;
+		nl::node loadsrc;
+		std::unique_ptr<MapPrefetcher::Prepared> prepared;
+		std::chrono::time_point<std::chrono::steady_clock> loadstart;
+		uint32_t loadframes;
+
 		MapInfo mapinfo;
 		MapTilesObjs tilesobjs;
 		MapBackgrounds backgrounds;
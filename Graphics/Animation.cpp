@@ -21,6 +21,7 @@
 
 #include "../Util/Misc.h"
 
+#include <algorithm>
 #include <set>
 #include <iostream>
 
@@ -164,7 +165,7 @@ namespace ms
 		animated = frames.size() > 1;
 		zigzag = src["zigzag"].get_bool();
 
-
+		measure();
 		reset();
 	}
 
@@ -175,9 +176,32 @@ namespace ms
 
 		frames.push_back(Frame());
 
+		measure();
 		reset();
 	}
 
+	void Animation::measure()
+	{
+		int16_t left = 0;
+		int16_t right = 0;
+		int16_t top = 0;
+		int16_t bottom = 0;
+
+		for (auto& fr : frames)
+		{
+			Point<int16_t> origin = fr.get_origin();
+			Point<int16_t> dimensions = fr.get_dimensions();
+
+			// Flipping mirrors the texture around the draw position
+			left = std::min<int16_t>(left, std::min<int16_t>(-origin.x(), origin.x() - dimensions.x()));
+			right = std::max<int16_t>(right, std::max<int16_t>(dimensions.x() - origin.x(), origin.x()));
+			top = std::min<int16_t>(top, -origin.y());
+			bottom = std::max<int16_t>(bottom, dimensions.y() - origin.y());
+		}
+
+		extents = Rectangle<int16_t>(left, right, top, bottom);
+	}
+
 	void Animation::reset()
 	{
 		frame.set(0);
@@ -329,6 +353,18 @@ namespace ms
 		return get_frame().get_bounds();
 	}
 
+	Rectangle<int16_t> Animation::get_extents() const
+	{
+		return extents;
+	}
+
+	bool Animation::is_static() const
+	{
+		const Frame& first = frames[0];
+
+		return !animated && first.opcstep(Constants::TIMESTEP) == 0.0f && first.scalestep(Constants::TIMESTEP) == 0.0f;
+	}
+
 	const Frame& Animation::get_frame() const
 	{
 		return frames[frame.get()];
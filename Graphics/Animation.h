@@ -73,11 +73,17 @@ namespace ms
 		Point<int16_t> get_dimensions() const;
 		Point<int16_t> get_head() const;
 		Rectangle<int16_t> get_bounds() const;
+		// Return the area covered by any frame relative to the draw position, either way flipped
+		Rectangle<int16_t> get_extents() const;
+		// Check whether the animation always looks the same, i.e. one frame which does not fade or scale
+		bool is_static() const;
 
 	private:
 		const Frame& get_frame() const;
+		void measure();
 
 		std::vector<Frame> frames;
+		Rectangle<int16_t> extents;
 		bool animated;
 		bool zigzag;
 
@@ -0,0 +1,132 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "BitmapDecoder.h"
+
+#include <algorithm>
+
+namespace ms
+{
+	BitmapDecoder::BitmapDecoder(size_t threads) : active(0), stopping(false)
+	{
+		threads = std::max<size_t>(threads, 1);
+
+		for (size_t i = 0; i < threads; i++)
+			workers.emplace_back(&BitmapDecoder::work, this);
+	}
+
+	BitmapDecoder::BitmapDecoder() : BitmapDecoder(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1) {}
+
+	BitmapDecoder::~BitmapDecoder()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+
+		jobready.notify_all();
+
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+
+	void BitmapDecoder::enqueue(const nl::bitmap& bmp)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			jobs.push_back(bmp);
+		}
+
+		jobready.notify_one();
+	}
+
+	bool BitmapDecoder::poll(Decoded& decoded)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (results.empty())
+			return false;
+
+		decoded = std::move(results.front());
+		results.pop_front();
+
+		return true;
+	}
+
+	void BitmapDecoder::recycle(std::vector<uint8_t>&& pixels)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		spares.push_back(std::move(pixels));
+	}
+
+	void BitmapDecoder::wait()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		jobdone.wait(lock, [&]() { return jobs.empty() && active == 0; });
+	}
+
+	size_t BitmapDecoder::get_pending()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		return jobs.size() + active;
+	}
+
+	size_t BitmapDecoder::get_threads() const
+	{
+		return workers.size();
+	}
+
+	void BitmapDecoder::work()
+	{
+		while (true)
+		{
+			Decoded decoded;
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				jobready.wait(lock, [&]() { return stopping || !jobs.empty(); });
+
+				if (stopping)
+					return;
+
+				decoded.bitmap = jobs.front();
+				jobs.pop_front();
+				active++;
+
+				if (!spares.empty())
+				{
+					decoded.pixels = std::move(spares.back());
+					spares.pop_back();
+				}
+			}
+
+			decoded.pixels.resize(decoded.bitmap.length());
+
+			if (!decoded.bitmap.decode_into(decoded.pixels.data(), decoded.pixels.size()))
+				decoded.pixels.clear();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				results.push_back(std::move(decoded));
+				active--;
+			}
+
+			jobdone.notify_all();
+		}
+	}
+}
@@ -0,0 +1,83 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef USE_NX
+#include <nlnx/bitmap.hpp>
+#endif
+
+namespace ms
+{
+	// Decompresses bitmaps on a pool of worker threads
+	// Used by GraphicsGL so atlas misses do not stall the render thread
+	class BitmapDecoder
+	{
+	public:
+		// A decompressed bitmap which is ready to be uploaded
+		// The pixels are empty if the data could not be decompressed
+		struct Decoded
+		{
+			nl::bitmap bitmap;
+			std::vector<uint8_t> pixels;
+		};
+
+		// Start the specified number of worker threads
+		BitmapDecoder(size_t threads);
+		// Start one worker thread per spare hardware thread
+		BitmapDecoder();
+		// Stop and join all worker threads
+		~BitmapDecoder();
+
+		BitmapDecoder(const BitmapDecoder&) = delete;
+		BitmapDecoder& operator=(const BitmapDecoder&) = delete;
+
+		// Queue a bitmap for decompression
+		void enqueue(const nl::bitmap& bmp);
+		// Take a decompressed bitmap, returns false if none are ready
+		bool poll(Decoded& decoded);
+		// Return a pixel buffer after uploading so it can be reused
+		void recycle(std::vector<uint8_t>&& pixels);
+		// Block until every queued bitmap has been decompressed
+		void wait();
+
+		// Return the number of bitmaps queued or being decompressed
+		size_t get_pending();
+		// Return the number of worker threads
+		size_t get_threads() const;
+
+	private:
+		void work();
+
+		std::vector<std::thread> workers;
+		std::deque<nl::bitmap> jobs;
+		std::deque<Decoded> results;
+		std::vector<std::vector<uint8_t>> spares;
+		std::mutex mutex;
+		std::condition_variable jobready;
+		std::condition_variable jobdone;
+		size_t active;
+		bool stopping;
+	};
+}
@@ -2,14 +2,41 @@
 
 #include "../Configuration.h"
 #include "../Util/Misc.h"
+#include "../Util/Profiler.h"
 #include <algorithm>
 #include <cmath>
 
 namespace ms
 {
+	bool GraphicsGL::alive = false;
+
 	GraphicsGL::GraphicsGL()
 	{
+		alive = true;
 		locked = false;
+		frame = 0;
+		current = 0;
+		fontymax = 0;
+		uploads = 0;
+
+		VBO = 0;
+		IBO = 0;
+		overlayVBO = 0;
+		streaming = Streaming::STAGING;
+		stream = nullptr;
+		stream_count = 0;
+		stream_capacity = 0;
+		segment = 0;
+		overflowed = false;
+		sprites = {};
+		lastsprites = {};
+		nextblock = 1;
+		recording = 0;
+		residency = 0;
+
+		for (size_t i = 0; i < SEGMENTS; i++)
+			fences[i] = nullptr;
+		nullresident.page = NOPAGE;
 
 		VWIDTH = Constants::Constants::get().get_viewwidth();
 		VHEIGHT = Constants::Constants::get().get_viewheight();
@@ -21,6 +48,11 @@ namespace ms
 		debug_mode = false;
 	}
 
+	GraphicsGL::~GraphicsGL()
+	{
+		alive = false;
+	}
+
 	Error GraphicsGL::init()
 	{
 		// Setup parameters
@@ -33,11 +65,12 @@ namespace ms
 			"varying vec4 colormod;"
 			"uniform vec2 screensize;"
 			"uniform int yoffset;"
+			"uniform vec2 translation;"
 
 			"void main(void)"
 			"{"
-			"	float x = -1.0 + coord.x * 2.0 / screensize.x;"
-			"	float y = 1.0 - (coord.y + yoffset) * 2.0 / screensize.y;"
+			"	float x = -1.0 + (coord.x + translation.x) * 2.0 / screensize.x;"
+			"	float y = 1.0 - (coord.y + translation.y + yoffset) * 2.0 / screensize.y;"
 			"   gl_Position = vec4(x, y, 0.0, 1.0);"
 			"	texpos = coord.zw;"
 			"	colormod = color;"
@@ -163,19 +196,23 @@ namespace ms
 		uniform_screensize = glGetUniformLocation(shaderProgram, "screensize");
 		uniform_yoffset = glGetUniformLocation(shaderProgram, "yoffset");
 		uniform_fontregion = glGetUniformLocation(shaderProgram, "fontregion");
+		uniform_translation = glGetUniformLocation(shaderProgram, "translation");
 
-		if (attribute_coord == -1 || attribute_color == -1 || uniform_texture == -1 || uniform_atlassize == -1 || uniform_screensize == -1 || uniform_yoffset == -1)
+		if (attribute_coord == -1 || attribute_color == -1 || uniform_texture == -1 || uniform_atlassize == -1 || uniform_screensize == -1 || uniform_yoffset == -1 || uniform_translation == -1)
 			return Error::Code::SHADER_VARS;
 
-		// Vertex Buffer Object
-		glGenBuffers(1, &VBO);
+		// Vertex and index buffers which quads are streamed through
+		createstream(STREAMQUADS);
 
-		glGenTextures(1, &atlas);
-		glBindTexture(GL_TEXTURE_2D, atlas);
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ATLASW, ATLASH, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		glGenBuffers(1, &overlayVBO);
+
+		// The first atlas page also holds the font glyphs
+		allocpage(0);
+
+		// Atlas misses are decompressed off the render thread and uploaded in flush
+		decoder = std::make_unique<BitmapDecoder>();
+
+		LOG(LOG_INFO, "Using " << decoder->get_threads() << " bitmap decoder threads");
 
 		fontborder.set_y(1);
 
@@ -203,23 +240,6 @@ namespace ms
 
 		fontymax += fontborder.y();
 
-		leftovers = QuadTree<size_t, Leftover>(
-			[](const Leftover& first, const Leftover& second)
-			{
-				bool width_comparison = first.width() >= second.width();
-				bool height_comparison = first.height() >= second.height();
-
-				if (width_comparison && height_comparison)
-					return QuadTree<size_t, Leftover>::Direction::RIGHT;
-				else if (width_comparison)
-					return QuadTree<size_t, Leftover>::Direction::DOWN;
-				else if (height_comparison)
-					return QuadTree<size_t, Leftover>::Direction::UP;
-				else
-					return QuadTree<size_t, Leftover>::Direction::LEFT;
-			}
-		);
-
 		return Error::Code::NONE;
 	}
 
@@ -312,40 +332,206 @@ namespace ms
 		glUniform1i(uniform_fontregion, fontymax);
 		glUniform2f(uniform_atlassize, ATLASW, ATLASH);
 		glUniform2f(uniform_screensize, VWIDTH, VHEIGHT);
-
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glVertexAttribPointer(attribute_coord, 4, GL_SHORT, GL_FALSE, sizeof(Quad::Vertex), 0);
-		glVertexAttribPointer(attribute_color, 4, GL_FLOAT, GL_FALSE, sizeof(Quad::Vertex), (const void*)8);
+		glUniform2f(uniform_translation, 0.0f, 0.0f);
 
 		glEnable(GL_BLEND);
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-		glBindTexture(GL_TEXTURE_2D, atlas);
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+		for (size_t i = 0; i < ATLASPAGES; i++)
+		{
+			if (!pages[i].texture)
+				continue;
+
+			glBindTexture(GL_TEXTURE_2D, pages[i].texture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		}
 
 		clearinternal();
 	}
 
-	void GraphicsGL::clearinternal()
+	void GraphicsGL::allocpage(size_t page)
+	{
+		AtlasPage& atlaspage = pages[page];
+
+		if (!atlaspage.texture)
+		{
+			glGenTextures(1, &atlaspage.texture);
+			glBindTexture(GL_TEXTURE_2D, atlaspage.texture);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ATLASW, ATLASH, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+			LOG(LOG_DEBUG, "[GraphicsGL] Allocated atlas page [" << page << "]");
+		}
+
+		resetpage(page);
+	}
+
+	void GraphicsGL::resetpage(size_t page)
 	{
-		border = Point<GLshort>(0, fontymax + 1); // Start textures below font region to avoid shader conflict
-		yrange = Range<GLshort>();
+		AtlasPage& atlaspage = pages[page];
+
+		// Every page starts below the font region so the shader does not mistake bitmaps for glyphs
+		atlaspage.border = Point<GLshort>(0, fontymax + 1);
+		atlaspage.yrange = Range<GLshort>();
+		atlaspage.rlid = 1;
+		atlaspage.wasted = 0;
+		atlaspage.bitmaps = 0;
+
+		atlaspage.leftovers = QuadTree<size_t, Leftover>(
+			[](const Leftover& first, const Leftover& second)
+			{
+				bool width_comparison = first.width() >= second.width();
+				bool height_comparison = first.height() >= second.height();
 
+				if (width_comparison && height_comparison)
+					return QuadTree<size_t, Leftover>::Direction::RIGHT;
+				else if (width_comparison)
+					return QuadTree<size_t, Leftover>::Direction::DOWN;
+				else if (height_comparison)
+					return QuadTree<size_t, Leftover>::Direction::UP;
+				else
+					return QuadTree<size_t, Leftover>::Direction::LEFT;
+			}
+		);
+	}
+
+	void GraphicsGL::evictpage(size_t page)
+	{
+		for (auto iter = offsets.begin(); iter != offsets.end();)
+		{
+			if (iter->second.page == page)
+				iter = offsets.erase(iter);
+			else
+				iter++;
+		}
+
+		AtlasPage& atlaspage = pages[page];
+
+		if (atlaspage.last_used == frame)
+			LOG(LOG_WARN, "[GraphicsGL] Evicting atlas page [" << page << "] which is in use this frame, consider more or larger pages");
+		else
+			LOG(LOG_DEBUG, "[GraphicsGL] Evicting atlas page [" << page << "] last used " << frame - atlaspage.last_used << " frames ago");
+
+		atlaspage.evictions++;
+		residency++;
+
+		resetpage(page);
+	}
+
+	size_t GraphicsGL::nextpage()
+	{
+		// Use a page which has never been allocated before evicting anything
+		for (size_t i = 0; i < ATLASPAGES; i++)
+		{
+			if (!pages[i].texture)
+			{
+				allocpage(i);
+
+				return i;
+			}
+		}
+
+		// Otherwise evict the least recently used page, other than the one which just filled up
+		size_t lru = current;
+
+		for (size_t i = 0; i < ATLASPAGES; i++)
+		{
+			if (i == current)
+				continue;
+
+			if (lru == current || pages[i].last_used < pages[lru].last_used)
+				lru = i;
+		}
+
+		evictpage(lru);
+
+		return lru;
+	}
+
+	void GraphicsGL::clearinternal()
+	{
 		offsets.clear();
-		leftovers.clear();
-		rlid = 1;
-		wasted = 0;
+		residency++;
+
+		for (size_t i = 0; i < ATLASPAGES; i++)
+			if (pages[i].texture)
+				resetpage(i);
+
+		current = 0;
 	}
 
 	void GraphicsGL::clear()
 	{
-		size_t used = ATLASW * border.y() + border.x() * yrange.second();
-		double usedpercent = static_cast<double>(used) / (ATLASW * ATLASH);
+		size_t used = 0;
+		size_t capacity = 0;
+		GLshort top = fontymax + 1;
+
+		for (size_t i = 0; i < ATLASPAGES; i++)
+		{
+			if (pages[i].texture)
+				used += pages[i].used(top);
+
+			capacity += ATLASW * (ATLASH - top);
+		}
+
+		double usedpercent = static_cast<double>(used) / capacity;
+
+		if (usedpercent > 0.8)
+			current = nextpage();
+	}
+
+	std::vector<GraphicsGL::AtlasInfo> GraphicsGL::get_atlas_info() const
+	{
+		std::vector<AtlasInfo> info;
+		GLshort top = fontymax + 1;
+		size_t capacity = ATLASW * (ATLASH - top);
+
+		for (size_t i = 0; i < ATLASPAGES; i++)
+		{
+			const AtlasPage& atlaspage = pages[i];
+			size_t used = atlaspage.texture ? atlaspage.used(top) : 0;
+
+			info.push_back({
+				atlaspage.texture != 0,
+				atlaspage.bitmaps,
+				used,
+				atlaspage.wasted,
+				static_cast<double>(used) / capacity,
+				used ? static_cast<double>(atlaspage.wasted) / used : 0.0,
+				atlaspage.last_used,
+				atlaspage.evictions
+			});
+		}
+
+		return info;
+	}
+
+	void GraphicsGL::log_atlas_info() const
+	{
+		std::vector<AtlasInfo> info = get_atlas_info();
+
+		for (size_t i = 0; i < info.size(); i++)
+		{
+			const AtlasInfo& page = info[i];
 
-		if (usedpercent > 80.0)
-			clearinternal();
+			if (!page.allocated)
+			{
+				LOG(LOG_INFO, "[GraphicsGL] Atlas page [" << i << "] Unallocated");
+				continue;
+			}
+
+			LOG(LOG_INFO, "[GraphicsGL] Atlas page [" << i << "]" << (i == current ? " (current)" : "")
+				<< " Bitmaps: [" << page.bitmaps << "]"
+				<< " Used: [" << page.usedpercent << "]"
+				<< " Wasted: [" << page.wastedpercent << "]"
+				<< " Idle: [" << frame - page.last_used << " frames]"
+				<< " Evictions: [" << page.evictions << "]");
+		}
 	}
 
 	void GraphicsGL::addbitmap(const nl::bitmap& bmp)
@@ -353,7 +539,7 @@ namespace ms
 		getoffset(bmp);
 	}
 
-	const GraphicsGL::Offset& GraphicsGL::getoffset(const nl::bitmap& bmp)
+	GraphicsGL::Resident& GraphicsGL::getoffset(const nl::bitmap& bmp)
 	{
 		size_t id = bmp.id();
 		GLshort width = bmp.width();
@@ -368,11 +554,18 @@ namespace ms
 		GLshort y = 0;
 
 		if (width <= 0 || height <= 0)
-			return nulloffset;
+			return nullresident;
+
+		if (width > ATLASW || height > ATLASH - fontymax - 1)
+		{
+			LOG(LOG_WARN, "[GraphicsGL] Bitmap [" << width << "x" << height << "] does not fit in an atlas page");
+
+			return nullresident;
+		}
 
 		Leftover value = Leftover(x, y, width, height);
 
-		size_t lid = leftovers.findnode(
+		size_t lid = pages[current].leftovers.findnode(
 			value,
 			[](const Leftover& val, const Leftover& leaf)
 			{
@@ -382,7 +575,8 @@ namespace ms
 
 		if (lid > 0)
 		{
-			const Leftover& leftover = leftovers[lid];
+			AtlasPage& atlaspage = pages[current];
+			const Leftover& leftover = atlaspage.leftovers[lid];
 
 			x = leftover.left;
 			y = leftover.top;
@@ -390,51 +584,59 @@ namespace ms
 			GLshort width_delta = leftover.width() - width;
 			GLshort height_delta = leftover.height() - height;
 
-			leftovers.erase(lid);
+			atlaspage.leftovers.erase(lid);
 
-			wasted -= width * height;
+			atlaspage.wasted -= width * height;
 
 			if (width_delta >= MINLOSIZE && height_delta >= MINLOSIZE)
 			{
-				leftovers.add(rlid, Leftover(x + width, y + height, width_delta, height_delta));
-				rlid++;
+				atlaspage.leftovers.add(atlaspage.rlid, Leftover(x + width, y + height, width_delta, height_delta));
+				atlaspage.rlid++;
 
 				if (width >= MINLOSIZE)
 				{
-					leftovers.add(rlid, Leftover(x, y + height, width, height_delta));
-					rlid++;
+					atlaspage.leftovers.add(atlaspage.rlid, Leftover(x, y + height, width, height_delta));
+					atlaspage.rlid++;
 				}
 
 				if (height >= MINLOSIZE)
 				{
-					leftovers.add(rlid, Leftover(x + width, y, width_delta, height));
-					rlid++;
+					atlaspage.leftovers.add(atlaspage.rlid, Leftover(x + width, y, width_delta, height));
+					atlaspage.rlid++;
 				}
 			}
 			else if (width_delta >= MINLOSIZE)
 			{
-				leftovers.add(rlid, Leftover(x + width, y, width_delta, height + height_delta));
-				rlid++;
+				atlaspage.leftovers.add(atlaspage.rlid, Leftover(x + width, y, width_delta, height + height_delta));
+				atlaspage.rlid++;
 			}
 			else if (height_delta >= MINLOSIZE)
 			{
-				leftovers.add(rlid, Leftover(x, y + height, width + width_delta, height_delta));
-				rlid++;
+				atlaspage.leftovers.add(atlaspage.rlid, Leftover(x, y + height, width + width_delta, height_delta));
+				atlaspage.rlid++;
 			}
 		}
 		else
 		{
+			Point<GLshort>& border = pages[current].border;
+			Range<GLshort>& yrange = pages[current].yrange;
+
 			if (border.x() + width > ATLASW)
 			{
 				border.set_x(0);
 				border.shift_y(yrange.second());
+				yrange = Range<GLshort>();
+			}
 
-				if (border.y() + height > ATLASH)
-					clearinternal();
-				else
-					yrange = Range<GLshort>();
+			if (border.y() + height > ATLASH)
+			{
+				current = nextpage();
+
+				return getoffset(bmp);
 			}
 
+			AtlasPage& atlaspage = pages[current];
+
 			x = border.x();
 			y = border.y();
 
@@ -444,11 +646,11 @@ namespace ms
 			{
 				if (x >= MINLOSIZE && height - yrange.second() >= MINLOSIZE)
 				{
-					leftovers.add(rlid, Leftover(0, yrange.first(), x, height - yrange.second()));
-					rlid++;
+					atlaspage.leftovers.add(atlaspage.rlid, Leftover(0, yrange.first(), x, height - yrange.second()));
+					atlaspage.rlid++;
 				}
 
-				wasted += x * (height - yrange.second());
+				atlaspage.wasted += x * (height - yrange.second());
 
 				yrange = Range<int16_t>(y + height, height);
 			}
@@ -456,48 +658,82 @@ namespace ms
 			{
 				if (width >= MINLOSIZE && yrange.first() - y - height >= MINLOSIZE)
 				{
-					leftovers.add(rlid, Leftover(x, y + height, width, yrange.first() - y - height));
-					rlid++;
+					atlaspage.leftovers.add(atlaspage.rlid, Leftover(x, y + height, width, yrange.first() - y - height));
+					atlaspage.rlid++;
 				}
 
-				wasted += width * (yrange.first() - y - height);
+				atlaspage.wasted += width * (yrange.first() - y - height);
 			}
 		}
 
+		AtlasPage& atlaspage = pages[current];
+		atlaspage.bitmaps++;
+		atlaspage.last_used = frame;
+
 #if LOG_LEVEL >= LOG_TRACE
-		size_t used = ATLASW * border.y() + border.x() * yrange.second();
+		size_t used = atlaspage.used(fontymax + 1);
 
 		double usedpercent = static_cast<double>(used) / (ATLASW * ATLASH);
-		double wastedpercent = static_cast<double>(wasted) / used;
+		double wastedpercent = static_cast<double>(atlaspage.wasted) / used;
 
-		LOG(LOG_TRACE, "Used: [" << usedpercent << "] Wasted: [" << wastedpercent << "]");
+		LOG(LOG_TRACE, "Page: [" << current << "] Used: [" << usedpercent << "] Wasted: [" << wastedpercent << "]");
 #endif
 
-		
-		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_BGRA, GL_UNSIGNED_BYTE, bmp.data());
-		
+		bool pending = decoder != nullptr;
+
+		if (pending)
+		{
+			decoder->enqueue(bmp);
+		}
+		else
+		{
+			glBindTexture(GL_TEXTURE_2D, atlaspage.texture);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_BGRA, GL_UNSIGNED_BYTE, bmp.data());
+		}
 
 		return offsets.emplace(
 			std::piecewise_construct,
 			std::forward_as_tuple(id),
-			std::forward_as_tuple(x, y, width, height)
+			std::forward_as_tuple(x, y, width, height, current, frame, pending)
 		).first->second;
 	}
 
 	void GraphicsGL::draw(const nl::bitmap& bmp, const Rectangle<int16_t>& rect, const Range<int16_t>& vertical, const Range<int16_t>& horizontal, const Color& color, float angle)
 	{
-		
-		if (locked)
+		if (color.invisible()) {
 			return;
+		}
 
-		if (color.invisible()) {
+		// Maps are loaded while the scene is locked, so recording comes first
+		if (recording > 0)
+		{
+			blocks[recording].records.push_back({ bmp, rect, vertical, horizontal, color, angle });
 			return;
 		}
 
+		if (locked)
+			return;
+
 		if (!rect.overlaps(SCREEN))
+		{
+			// Culling should have caught this earlier
+			sprites.offscreen++;
+			return;
+		}
+
+		Resident& resident = getoffset(bmp);
+
+		if (resident.page == NOPAGE)
 			return;
 
-		Offset offset = getoffset(bmp);
+		resident.last_drawn = frame;
+		pages[resident.page].last_used = frame;
+
+		// Skip bitmaps which are still being decompressed, they will be drawn once uploaded
+		if (resident.pending)
+			return;
+
+		Offset offset = resident.offset;
 
 		// In debug mode, draw red rectangles instead of textures
 		if (debug_mode && (rect.width() > 300 || rect.height() > 300)) {
@@ -510,13 +746,16 @@ namespace ms
 		offset.left += horizontal.first();
 		offset.right -= horizontal.second();
 
-		quads.emplace_back(
+		pushquad(
+			resident.page,
 			rect.left() + horizontal.first() + camera_x,
 			rect.right() - horizontal.second() + camera_x,
 			rect.top() + vertical.first() + camera_y,
 			rect.bottom() - vertical.second() + camera_y,
 			offset, color, angle
 		);
+
+		sprites.drawn++;
 	}
 
 	Text::Layout GraphicsGL::createlayout(const std::string& text, Text::Font id, Text::Alignment alignment, Color::Name color, int16_t maxwidth, bool formatted, int16_t line_adj)
@@ -983,9 +1222,9 @@ namespace ms
 					GLshort bottom = top + h - 2;
 					Color ntcolor = Color(0.0f, 0.0f, 0.0f, 0.6f);
 
-					quads.emplace_back(left, right, top, bottom, nulloffset, ntcolor, 0.0f);
-					quads.emplace_back(left - 1, left, top + 1, bottom - 1, nulloffset, ntcolor, 0.0f);
-					quads.emplace_back(right, right + 1, top + 1, bottom - 1, nulloffset, ntcolor, 0.0f);
+					pushquad(NOPAGE, left, right, top, bottom, nulloffset, ntcolor, 0.0f);
+					pushquad(NOPAGE, left - 1, left, top + 1, bottom - 1, nulloffset, ntcolor, 0.0f);
+					pushquad(NOPAGE, right, right + 1, top + 1, bottom - 1, nulloffset, ntcolor, 0.0f);
 				}
 
 				break;
@@ -1050,7 +1289,8 @@ namespace ms
 					if (char_width <= 0 || char_height <= 0)
 						continue;
 
-					quads.emplace_back(char_x, char_x + char_width, char_y, char_bottom, offset, abscolor, 0.0f);
+					// Font glyphs are always on the first page
+					pushquad(0, char_x, char_x + char_width, char_y, char_bottom, offset, abscolor, 0.0f);
 				}
 			}
 		}
@@ -1061,7 +1301,7 @@ namespace ms
 		if (locked)
 			return;
 
-		quads.emplace_back(x, x + width, y, y + height, nulloffset, Color(red, green, blue, alpha), 0.0f);
+		pushquad(NOPAGE, x, x + width, y, y + height, nulloffset, Color(red, green, blue, alpha), 0.0f);
 	}
 
 	void GraphicsGL::drawscreenfill(float red, float green, float blue, float alpha)
@@ -1069,6 +1309,242 @@ namespace ms
 		drawrectangle(0, 0, VWIDTH, VHEIGHT, red, green, blue, alpha);
 	}
 
+	void GraphicsGL::createstream(size_t quads)
+	{
+		destroystream();
+
+		stream_capacity = quads;
+		segment = 0;
+
+		// Every quad is drawn as two triangles sharing the diagonal
+		std::vector<GLuint> indices(quads * 6);
+
+		for (size_t i = 0; i < quads; i++)
+		{
+			GLuint vertex = static_cast<GLuint>(i * Quad::LENGTH);
+
+			indices[i * 6 + 0] = vertex + 0;
+			indices[i * 6 + 1] = vertex + 1;
+			indices[i * 6 + 2] = vertex + 2;
+			indices[i * 6 + 3] = vertex + 0;
+			indices[i * 6 + 4] = vertex + 2;
+			indices[i * 6 + 5] = vertex + 3;
+		}
+
+		glGenBuffers(1, &IBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+		glGenBuffers(1, &VBO);
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+		GLsizeiptr segmentsize = quads * sizeof(Quad);
+
+		bool buffer_storage = (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) && (GLEW_VERSION_3_2 || GLEW_ARB_sync);
+		bool map_buffer_range = GLEW_VERSION_3_0 || GLEW_ARB_map_buffer_range;
+
+		if (buffer_storage)
+		{
+			GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+			glBufferStorage(GL_ARRAY_BUFFER, segmentsize * SEGMENTS, nullptr, flags);
+			stream = static_cast<Quad*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, segmentsize * SEGMENTS, flags));
+
+			if (stream)
+			{
+				streaming = Streaming::PERSISTENT;
+			}
+			else
+			{
+				// Buffer storage is immutable, so start over with a plain buffer
+				glBindBuffer(GL_ARRAY_BUFFER, 0);
+				glDeleteBuffers(1, &VBO);
+				glGenBuffers(1, &VBO);
+				glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+				streaming = map_buffer_range ? Streaming::ORPHANED : Streaming::STAGING;
+			}
+		}
+		else
+		{
+			streaming = map_buffer_range ? Streaming::ORPHANED : Streaming::STAGING;
+		}
+
+		if (streaming == Streaming::STAGING)
+			staging.resize(quads);
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		// Nothing is mapped until the first frame begins
+		if (streaming != Streaming::PERSISTENT)
+			stream = nullptr;
+
+		stream_count = 0;
+
+		const char* mode = streaming == Streaming::PERSISTENT ? "persistent" : streaming == Streaming::ORPHANED ? "orphaned" : "staging";
+
+		LOG(LOG_INFO, "Streaming up to " << quads << " quads per frame through " << mode << " vertex buffers");
+	}
+
+	void GraphicsGL::destroystream()
+	{
+		for (size_t i = 0; i < SEGMENTS; i++)
+			waitfence(i);
+
+		if (VBO)
+		{
+			if (streaming == Streaming::PERSISTENT || (streaming == Streaming::ORPHANED && stream))
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, VBO);
+				glUnmapBuffer(GL_ARRAY_BUFFER);
+				glBindBuffer(GL_ARRAY_BUFFER, 0);
+			}
+
+			glDeleteBuffers(1, &VBO);
+			VBO = 0;
+		}
+
+		if (IBO)
+		{
+			glDeleteBuffers(1, &IBO);
+			IBO = 0;
+		}
+
+		stream = nullptr;
+		stream_count = 0;
+		staging.clear();
+		batches.clear();
+	}
+
+	void GraphicsGL::waitfence(size_t seg)
+	{
+		if (!fences[seg])
+			return;
+
+		while (glClientWaitSync(fences[seg], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED);
+
+		glDeleteSync(fences[seg]);
+		fences[seg] = nullptr;
+	}
+
+	void GraphicsGL::beginstream()
+	{
+		if (overflowed)
+		{
+			LOG(LOG_WARN, "[GraphicsGL] More than " << stream_capacity << " quads in one frame, growing the vertex stream");
+
+			overflowed = false;
+			createstream(stream_capacity * 2);
+		}
+
+		stream_count = 0;
+		batches.clear();
+
+		switch (streaming)
+		{
+			case Streaming::PERSISTENT:
+			{
+				// Wait until the GPU is done with the segment from SEGMENTS frames ago
+				segment = (segment + 1) % SEGMENTS;
+
+				waitfence(segment);
+
+				break;
+			}
+			case Streaming::ORPHANED:
+			{
+				glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+				if (stream)
+					glUnmapBuffer(GL_ARRAY_BUFFER);
+
+				GLsizeiptr size = stream_capacity * sizeof(Quad);
+
+				// Orphan the storage so the driver can hand out a fresh block without stalling
+				glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+				stream = static_cast<Quad*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+				glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+				if (!stream)
+				{
+					LOG(LOG_WARN, "[GraphicsGL] Mapping the vertex stream failed, falling back to staging");
+
+					streaming = Streaming::STAGING;
+					staging.resize(stream_capacity);
+					stream = staging.data();
+				}
+
+				break;
+			}
+			case Streaming::STAGING:
+			{
+				stream = staging.data();
+				break;
+			}
+		}
+	}
+
+	void GraphicsGL::pushquad(size_t page, GLshort left, GLshort right, GLshort top, GLshort bottom, const Offset& offset, const Color& color, GLfloat rotation)
+	{
+		if (!stream)
+			return;
+
+		if (stream_count >= stream_capacity)
+		{
+			overflowed = true;
+			return;
+		}
+
+		bool joinable = !batches.empty() && batches.back().block == 0;
+
+		// Untextured quads can be drawn together with any page
+		if (page == NOPAGE)
+			page = joinable ? batches.back().page : 0;
+
+		if (!joinable || batches.back().page != page)
+			batches.push_back({ page, 0 });
+
+		batches.back().count++;
+
+		// Build the quad on the stack so mapped memory is only ever written to
+		Quad* segmentbase = streaming == Streaming::PERSISTENT ? stream + segment * stream_capacity : stream;
+		segmentbase[stream_count++] = Quad(left, right, top, bottom, offset, color, rotation);
+	}
+
+	void GraphicsGL::upload()
+	{
+		uploads = 0;
+
+		if (!decoder)
+			return;
+
+		size_t budget = 0;
+		BitmapDecoder::Decoded decoded;
+
+		// Always upload at least one bitmap so large ones cannot starve
+		while (budget < UPLOADBUDGET && decoder->poll(decoded))
+		{
+			auto iter = offsets.find(decoded.bitmap.id());
+
+			// The page may have been evicted, or an earlier request already uploaded it
+			if (iter != offsets.end() && iter->second.pending && !decoded.pixels.empty())
+			{
+				Resident& resident = iter->second;
+				const Offset& offset = resident.offset;
+
+				glBindTexture(GL_TEXTURE_2D, pages[resident.page].texture);
+				glTexSubImage2D(GL_TEXTURE_2D, 0, offset.left, offset.top, offset.right - offset.left, offset.bottom - offset.top, GL_BGRA, GL_UNSIGNED_BYTE, decoded.pixels.data());
+
+				resident.pending = false;
+				budget += decoded.pixels.size();
+				uploads++;
+			}
+
+			decoder->recycle(std::move(decoded.pixels));
+		}
+	}
+
 	void GraphicsGL::lock()
 	{
 		locked = true;
@@ -1081,48 +1557,259 @@ namespace ms
 
 	void GraphicsGL::flush(float opacity)
 	{
-		bool coverscene = opacity != 1.0f;
+		ScopedTimer timer(Profiler::Section::FLUSH);
+
+		upload();
+
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);  // clear to black instead of white
+		glClear(GL_COLOR_BUFFER_BIT);
+
+		// Z-sorting temporarily disabled due to rendering issues
 
-		if (coverscene)
+		GLintptr base = 0;
+
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+		switch (streaming)
+		{
+			case Streaming::PERSISTENT:
+				base = segment * stream_capacity * sizeof(Quad);
+				break;
+			case Streaming::ORPHANED:
+				if (stream)
+				{
+					glUnmapBuffer(GL_ARRAY_BUFFER);
+					stream = nullptr;
+				}
+
+				break;
+			case Streaming::STAGING:
+				glBufferData(GL_ARRAY_BUFFER, stream_count * sizeof(Quad), staging.data(), GL_STREAM_DRAW);
+				break;
+		}
+
+		glEnableVertexAttribArray(attribute_coord);
+		glEnableVertexAttribArray(attribute_color);
+		glVertexAttribPointer(attribute_coord, 4, GL_SHORT, GL_FALSE, sizeof(Quad::Vertex), (const void*)base);
+		glVertexAttribPointer(attribute_color, 4, GL_FLOAT, GL_FALSE, sizeof(Quad::Vertex), (const void*)(base + 8));
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+
+		// Draw each run of quads with the page it samples from, keeping the original order
+		size_t first = 0;
+
+		for (const Batch& batch : batches)
+		{
+			if (batch.block > 0)
+			{
+				auto iter = blocks.find(batch.block);
+
+				// The block may have been released while the scene was locked
+				if (iter == blocks.end() || !iter->second.VBO)
+					continue;
+
+				const Block& block = iter->second;
+				size_t blockfirst = 0;
+
+				glBindBuffer(GL_ARRAY_BUFFER, block.VBO);
+				glUniform2f(uniform_translation, batch.translation.x(), batch.translation.y());
+
+				// Every run starts at the beginning of the index buffer, so runs may not be longer than the stream
+				for (const Batch& run : block.batches)
+				{
+					GLintptr runbase = blockfirst * sizeof(Quad);
+
+					glVertexAttribPointer(attribute_coord, 4, GL_SHORT, GL_FALSE, sizeof(Quad::Vertex), (const void*)runbase);
+					glVertexAttribPointer(attribute_color, 4, GL_FLOAT, GL_FALSE, sizeof(Quad::Vertex), (const void*)(runbase + 8));
+					glBindTexture(GL_TEXTURE_2D, pages[run.page].texture);
+					glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(run.count * 6), GL_UNSIGNED_INT, 0);
+
+					blockfirst += run.count;
+				}
+
+				glUniform2f(uniform_translation, 0.0f, 0.0f);
+				glBindBuffer(GL_ARRAY_BUFFER, VBO);
+				glVertexAttribPointer(attribute_coord, 4, GL_SHORT, GL_FALSE, sizeof(Quad::Vertex), (const void*)base);
+				glVertexAttribPointer(attribute_color, 4, GL_FLOAT, GL_FALSE, sizeof(Quad::Vertex), (const void*)(base + 8));
+
+				continue;
+			}
+
+			glBindTexture(GL_TEXTURE_2D, pages[batch.page].texture);
+			glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(batch.count * 6), GL_UNSIGNED_INT, (const void*)(first * 6 * sizeof(GLuint)));
+
+			first += batch.count;
+		}
+
+		if (opacity != 1.0f)
 		{
 			float complement = 1.0f - opacity;
-			
+
 			// CRITICAL FIX: Don't draw fully opaque black overlay
 			// When opacity = 0, complement = 1.0 which makes everything black
 			// Instead, skip the overlay when opacity is very low
 			// Increased threshold from 0.01 to 0.1 to handle floating point precision
-			if (opacity > 0.1f) {
+			if (opacity > 0.1f)
+			{
+				// The overlay has its own buffer so locked scenes can be redrawn without touching the stream
 				Color color = Color(0.0f, 0.0f, 0.0f, complement);
-				quads.emplace_back(SCREEN.left(), SCREEN.right(), SCREEN.top(), SCREEN.bottom(), nulloffset, color, 0.0f);
+				Quad overlay = Quad(SCREEN.left(), SCREEN.right(), SCREEN.top(), SCREEN.bottom(), nulloffset, color, 0.0f);
+
+				glBindBuffer(GL_ARRAY_BUFFER, overlayVBO);
+				glBufferData(GL_ARRAY_BUFFER, sizeof(Quad), &overlay, GL_STREAM_DRAW);
+				glVertexAttribPointer(attribute_coord, 4, GL_SHORT, GL_FALSE, sizeof(Quad::Vertex), 0);
+				glVertexAttribPointer(attribute_color, 4, GL_FLOAT, GL_FALSE, sizeof(Quad::Vertex), (const void*)8);
+				glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 			}
 		}
-		
 
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);  // clear to black instead of white
-		glClear(GL_COLOR_BUFFER_BIT);
+		glDisableVertexAttribArray(attribute_coord);
+		glDisableVertexAttribArray(attribute_color);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-		// Z-sorting temporarily disabled due to rendering issues
-		// std::stable_sort(quads.begin(), quads.end(), [](const Quad& a, const Quad& b) {
-		//     return a.z < b.z;
-		// });
+		if (streaming == Streaming::PERSISTENT)
+		{
+			if (fences[segment])
+				glDeleteSync(fences[segment]);
 
-		GLsizeiptr csize = quads.size() * sizeof(Quad);
-		GLsizeiptr fsize = quads.size() * Quad::LENGTH;
+			fences[segment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
 
-		glEnableVertexAttribArray(attribute_coord);
-		glEnableVertexAttribArray(attribute_color);
-		glBindBuffer(GL_ARRAY_BUFFER, VBO);
-		glBufferData(GL_ARRAY_BUFFER, csize, quads.data(), GL_STREAM_DRAW);
+		if (!locked)
+			lastsprites = sprites;
 
-		glDrawArrays(GL_QUADS, 0, fsize);
+		Profiler::get().count(Profiler::Counter::QUADS, sprites.drawn);
+		Profiler::get().count(Profiler::Counter::UPLOADS, uploads);
 
-		glDisableVertexAttribArray(attribute_coord);
-		glDisableVertexAttribArray(attribute_color);
+		sprites = {};
+		frame++;
+	}
+
+	void GraphicsGL::cull(size_t count)
+	{
+		sprites.culled += count;
+	}
+
+	size_t GraphicsGL::beginblock()
+	{
+		recording = nextblock++;
+		blocks[recording];
+
+		return recording;
+	}
+
+	void GraphicsGL::endblock()
+	{
+		recording = 0;
+	}
+
+	void GraphicsGL::drawblock(size_t id, Point<int16_t> position)
+	{
+		if (locked)
+			return;
+
+		auto iter = blocks.find(id);
+
+		if (iter == blocks.end())
+			return;
+
+		Block& block = iter->second;
+
+		// Rebuild after atlas pages were evicted, or once more bitmaps finished uploading
+		if (!block.built || block.residency != residency || (!block.complete && uploads > 0))
+			buildblock(block);
+
+		if (block.quads == 0)
+			return;
+
+		for (const Batch& run : block.batches)
+			pages[run.page].last_used = frame;
+
+		GLshort x = position.x() + camera_x;
+		GLshort y = position.y() + camera_y;
+
+		batches.push_back({ 0, 0, id, Point<GLshort>(x, y) });
+		sprites.drawn += block.quads;
+	}
+
+	void GraphicsGL::releaseblock(size_t id)
+	{
+		auto iter = blocks.find(id);
+
+		if (iter == blocks.end())
+			return;
+
+		if (iter->second.VBO)
+			glDeleteBuffers(1, &iter->second.VBO);
+
+		blocks.erase(iter);
+
+		if (recording == id)
+			recording = 0;
+	}
+
+	bool GraphicsGL::is_alive()
+	{
+		return alive;
+	}
+
+	void GraphicsGL::buildblock(Block& block)
+	{
+		std::vector<Quad> quads;
+		quads.reserve(block.records.size());
+
+		block.batches.clear();
+		block.residency = residency;
+		block.built = true;
+		block.complete = true;
+
+		for (const Record& record : block.records)
+		{
+			Resident& resident = getoffset(record.bitmap);
+
+			if (resident.page == NOPAGE)
+				continue;
+
+			// Leave out bitmaps which are still being decompressed, the block is rebuilt once they are uploaded
+			if (resident.pending)
+			{
+				block.complete = false;
+				continue;
+			}
+
+			Offset offset = resident.offset;
+			offset.top += record.vertical.first();
+			offset.bottom -= record.vertical.second();
+			offset.left += record.horizontal.first();
+			offset.right -= record.horizontal.second();
+
+			if (block.batches.empty() || block.batches.back().page != resident.page || block.batches.back().count >= stream_capacity)
+				block.batches.push_back({ resident.page, 0 });
+
+			block.batches.back().count++;
+
+			quads.emplace_back(
+				record.rect.left() + record.horizontal.first(),
+				record.rect.right() - record.horizontal.second(),
+				record.rect.top() + record.vertical.first(),
+				record.rect.bottom() - record.vertical.second(),
+				offset, record.color, record.angle
+			);
+		}
+
+		block.quads = quads.size();
+
+		if (!block.VBO)
+			glGenBuffers(1, &block.VBO);
+
+		glBindBuffer(GL_ARRAY_BUFFER, block.VBO);
+		glBufferData(GL_ARRAY_BUFFER, quads.size() * sizeof(Quad), quads.data(), GL_STATIC_DRAW);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
 
-		// Only pop if we actually added the overlay
-		if (coverscene && opacity > 0.1f)
-			quads.pop_back();
+	GraphicsGL::SpriteCounts GraphicsGL::get_sprite_counts() const
+	{
+		return lastsprites;
 	}
 
 	void GraphicsGL::move_camera(int16_t dx, int16_t dy)
@@ -1139,12 +1826,21 @@ namespace ms
 
 	void GraphicsGL::clear_atlas_cache()
 	{
-		// Clear the actual OpenGL texture data
-		GLubyte* black_data = new GLubyte[ATLASW * ATLASH * 4]();  // All zeros (black/transparent)
-		glBindTexture(GL_TEXTURE_2D, atlas);
-		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, ATLASW, ATLASH, GL_RGBA, GL_UNSIGNED_BYTE, black_data);
+		// Clear the actual OpenGL texture data below the font region
+		GLshort top = fontymax + 1;
+		GLubyte* black_data = new GLubyte[ATLASW * (ATLASH - top) * 4]();  // All zeros (black/transparent)
+
+		for (size_t i = 0; i < ATLASPAGES; i++)
+		{
+			if (!pages[i].texture)
+				continue;
+
+			glBindTexture(GL_TEXTURE_2D, pages[i].texture);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, top, ATLASW, ATLASH - top, GL_RGBA, GL_UNSIGNED_BYTE, black_data);
+		}
+
 		delete[] black_data;
-		
+
 		clearinternal();
 	}
 
@@ -1155,8 +1851,8 @@ namespace ms
 
 	void GraphicsGL::clearscene()
 	{
-		if (!locked) {
-			quads.clear();
-		}
+		// A locked scene keeps drawing the quads of the last frame
+		if (!locked)
+			beginstream();
 	}
 }
\ No newline at end of file
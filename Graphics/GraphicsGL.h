@@ -17,6 +17,7 @@
 //////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "BitmapDecoder.h"
 #include "Text.h"
 
 #include "../Constants.h"
@@ -38,13 +39,14 @@ namespace ms
 	{
 	public:
 		GraphicsGL();
+		~GraphicsGL();
 
 		// Initialize all resources
 		Error init();
 		// Re-initialize after changing screen modes
 		void reinit();
 
-		// Clear all bitmaps if most of the space is used up
+		// Evict the least recently used atlas page if most of the space is used up
 		void clear();
 
 		// Add a bitmap to the available resources
@@ -54,6 +56,20 @@ namespace ms
 
 		// Create a layout for the text with the parameters specified
 		Text::Layout createlayout(const std::string& text, Text::Font font, Text::Alignment alignment, Color::Name color, int16_t maxwidth, bool formatted, int16_t line_adj);
+		// Count sprites which were culled before reaching draw
+		void cull(size_t count = 1);
+
+		// Start recording draws into a new block of static geometry, returns the id of the block
+		size_t beginblock();
+		// Stop recording draws into the block
+		void endblock();
+		// Draw a block of static geometry, translated by the specified position
+		void drawblock(size_t id, Point<int16_t> position);
+		// Release a block of static geometry
+		void releaseblock(size_t id);
+		// Check whether the engine still exists, blocks may outlive it during static destruction
+		static bool is_alive();
+
 		// Draw a text with the given parameters
 		void drawtext(const DrawArgument& args, const Range<int16_t>& vertical, const std::string& text, const Text::Layout& layout, Text::Font font, Color::Name color, Text::Background back);
 
@@ -78,6 +94,35 @@ namespace ms
 		// Clear the buffer contents
 		void clearscene();
 
+		// Occupancy of a single atlas page
+		struct AtlasInfo
+		{
+			bool allocated;
+			size_t bitmaps;
+			size_t used;
+			size_t wasted;
+			double usedpercent;
+			double wastedpercent;
+			uint64_t last_used;
+			uint32_t evictions;
+		};
+
+		// Return occupancy figures for every atlas page
+		std::vector<AtlasInfo> get_atlas_info() const;
+		// Log occupancy figures for every atlas page
+		void log_atlas_info() const;
+
+		// Sprite counts of a single frame
+		struct SpriteCounts
+		{
+			size_t drawn;
+			size_t culled;
+			size_t offscreen;
+		};
+
+		// Return the sprite counts of the last completed frame
+		SpriteCounts get_sprite_counts() const;
+
 	private:
 		void clearinternal();
 		bool addfont(const char* name, Text::Font id, FT_UInt width, FT_UInt height);
@@ -106,8 +151,20 @@ namespace ms
 			}
 		};
 
+		// A bitmap which is resident in one of the atlas pages
+		struct Resident
+		{
+			Offset offset;
+			size_t page;
+			uint64_t last_drawn;
+			bool pending;
+
+			Resident(GLshort x, GLshort y, GLshort width, GLshort height, size_t pg, uint64_t frame, bool pend) : offset(x, y, width, height), page(pg), last_drawn(frame), pending(pend) {}
+			Resident() : offset(), page(0), last_drawn(0), pending(false) {}
+		};
+
 		// Add a bitmap to the available resources
-		const Offset& getoffset(const nl::bitmap& bmp);
+		Resident& getoffset(const nl::bitmap& bmp);
 
 		struct Leftover
 		{
@@ -161,6 +218,8 @@ namespace ms
 			static const size_t LENGTH = 4;
 			Vertex vertices[LENGTH];
 
+			Quad() {}
+
 			Quad(GLshort left, GLshort right, GLshort top, GLshort bottom, const Offset& offset, const Color& color, GLfloat rotation)
 			{
 				vertices[0] = { left, top, offset.left, offset.top, color };
@@ -223,6 +282,96 @@ namespace ms
 			}
 		};
 
+		// Packing state of a single texture in the atlas
+		struct AtlasPage
+		{
+			GLuint texture;
+			QuadTree<size_t, Leftover> leftovers;
+			size_t rlid;
+			size_t wasted;
+			size_t bitmaps;
+			Point<GLshort> border;
+			Range<GLshort> yrange;
+			uint64_t last_used;
+			uint32_t evictions;
+
+			AtlasPage() : texture(0), rlid(1), wasted(0), bitmaps(0), last_used(0), evictions(0) {}
+
+			size_t used(GLshort top) const
+			{
+				return ATLASW * (border.y() - top) + border.x() * yrange.second();
+			}
+		};
+
+		// A run of consecutive quads which sample from the same atlas page
+		// Batches with a block id draw that block instead of quads from the stream
+		struct Batch
+		{
+			size_t page;
+			size_t count;
+			size_t block;
+			Point<GLshort> translation;
+		};
+
+		// A draw which was recorded into a block
+		struct Record
+		{
+			nl::bitmap bitmap;
+			Rectangle<int16_t> rect;
+			Range<int16_t> vertical;
+			Range<int16_t> horizontal;
+			Color color;
+			float angle;
+		};
+
+		// Static geometry with its own vertex buffer, rebuilt when atlas residency changes
+		struct Block
+		{
+			std::vector<Record> records;
+			std::vector<Batch> batches;
+			size_t quads;
+			GLuint VBO;
+			uint64_t residency;
+			bool built;
+			bool complete;
+
+			Block() : quads(0), VBO(0), residency(0), built(false), complete(false) {}
+		};
+
+		// Create the texture for an atlas page
+		void allocpage(size_t page);
+		// Reset the packing state of an atlas page
+		void resetpage(size_t page);
+		// Remove all bitmaps which are resident in an atlas page
+		void evictpage(size_t page);
+		// Find a page for new bitmaps once the current one is full
+		size_t nextpage();
+		// How quads are streamed to the vertex buffer
+		enum class Streaming
+		{
+			// Buffer storage which stays mapped, split into fenced segments
+			PERSISTENT,
+			// Buffer which is orphaned and mapped each frame
+			ORPHANED,
+			// Client memory which is copied with glBufferData
+			STAGING
+		};
+
+		// Create the vertex and index buffers for the specified number of quads per frame
+		void createstream(size_t quads);
+		// Release the vertex and index buffers
+		void destroystream();
+		// Block until the GPU is done reading a segment of the stream
+		void waitfence(size_t seg);
+		// Prepare memory for the quads of the next frame
+		void beginstream();
+		// Add a quad which samples from the specified page
+		void pushquad(size_t page, GLshort left, GLshort right, GLshort top, GLshort bottom, const Offset& offset, const Color& color, GLfloat rotation);
+		// Upload bitmaps which finished decompressing, within the per-frame budget
+		void upload();
+		// Build the vertex buffer of a block from the bitmaps which are resident
+		void buildblock(Block& block);
+
 		class LayoutBuilder
 		{
 		public:
@@ -263,15 +412,41 @@ namespace ms
 		int16_t camera_y;
 		bool debug_mode;
 
-		static const GLshort ATLASW = 8192;
-		static const GLshort ATLASH = 8192;
+		static const GLshort ATLASW = 4096;
+		static const GLshort ATLASH = 4096;
+		static const size_t ATLASPAGES = 4;
+		static const size_t NOPAGE = ATLASPAGES;
 		static const GLshort MINLOSIZE = 32;
+		static const size_t UPLOADBUDGET = 4 * 1024 * 1024;
+		static const size_t STREAMQUADS = 32768;
+		static const size_t SEGMENTS = 3;
 
 		bool locked;
+		uint64_t frame;
 
-		std::vector<Quad> quads;
+		std::vector<Batch> batches;
 		GLuint VBO;
-		GLuint atlas;
+		GLuint IBO;
+		GLuint overlayVBO;
+
+		Streaming streaming;
+		Quad* stream;
+		size_t stream_count;
+		size_t stream_capacity;
+		size_t segment;
+		bool overflowed;
+		GLsync fences[SEGMENTS];
+		std::vector<Quad> staging;
+
+		SpriteCounts sprites;
+		SpriteCounts lastsprites;
+
+		static bool alive;
+
+		std::unordered_map<size_t, Block> blocks;
+		size_t nextblock;
+		size_t recording;
+		uint64_t residency;
 
 		GLint shaderProgram;
 		GLint attribute_coord;
@@ -280,16 +455,18 @@ namespace ms
 		GLint uniform_atlassize;
 		GLint uniform_screensize;
 		GLint uniform_yoffset;
+		GLint uniform_translation;
 		GLint uniform_fontregion;
 
-		std::unordered_map<size_t, Offset> offsets;
+		std::unordered_map<size_t, Resident> offsets;
 		Offset nulloffset;
+		Resident nullresident;
+
+		AtlasPage pages[ATLASPAGES];
+		size_t current;
 
-		QuadTree<size_t, Leftover> leftovers;
-		size_t rlid;
-		size_t wasted;
-		Point<GLshort> border;
-		Range<GLshort> yrange;
+		std::unique_ptr<BitmapDecoder> decoder;
+		size_t uploads;
 
 		FT_Library ftlibrary;
 		Font fonts[Text::Font::NUM_FONTS];
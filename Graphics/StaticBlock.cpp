@@ -0,0 +1,70 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "StaticBlock.h"
+
+#include "GraphicsGL.h"
+
+namespace ms
+{
+	StaticBlock::StaticBlock(std::function<void()> record)
+	{
+		id = GraphicsGL::get().beginblock();
+
+		record();
+
+		GraphicsGL::get().endblock();
+	}
+
+	StaticBlock::StaticBlock() : id(0) {}
+
+	StaticBlock::~StaticBlock()
+	{
+		if (id > 0 && GraphicsGL::is_alive())
+			GraphicsGL::get().releaseblock(id);
+	}
+
+	StaticBlock::StaticBlock(StaticBlock&& other) : id(other.id)
+	{
+		other.id = 0;
+	}
+
+	StaticBlock& StaticBlock::operator=(StaticBlock&& other)
+	{
+		if (this != &other)
+		{
+			if (id > 0)
+				GraphicsGL::get().releaseblock(id);
+
+			id = other.id;
+			other.id = 0;
+		}
+
+		return *this;
+	}
+
+	void StaticBlock::draw(Point<int16_t> position) const
+	{
+		if (id > 0)
+			GraphicsGL::get().drawblock(id, position);
+	}
+
+	bool StaticBlock::is_valid() const
+	{
+		return id > 0;
+	}
+}
@@ -0,0 +1,53 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "../Template/Point.h"
+
+#include <cstdint>
+#include <functional>
+
+namespace ms
+{
+	// Geometry which is recorded once and drawn with only a translation every frame
+	// Everything drawn by the recording function is kept, in order, in a vertex buffer owned by GraphicsGL
+	class StaticBlock
+	{
+	public:
+		// Record everything which is drawn by the specified function
+		StaticBlock(std::function<void()> record);
+		StaticBlock();
+		// Release the block
+		~StaticBlock();
+
+		StaticBlock(StaticBlock&& other);
+		StaticBlock& operator=(StaticBlock&& other);
+
+		StaticBlock(const StaticBlock&) = delete;
+		StaticBlock& operator=(const StaticBlock&) = delete;
+
+		// Draw the block at the specified position
+		void draw(Point<int16_t> position) const;
+
+		// Check whether anything was recorded
+		bool is_valid() const;
+
+	private:
+		size_t id;
+	};
+}
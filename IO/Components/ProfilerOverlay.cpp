@@ -0,0 +1,124 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "ProfilerOverlay.h"
+
+namespace ms
+{
+	namespace
+	{
+		const int16_t LEFT = 8;
+		const int16_t TOP = 28;
+		const int16_t LINE_HEIGHT = 14;
+		const int16_t NAME_WIDTH = 140;
+		const int16_t VALUE_WIDTH = 50;
+	}
+
+	ProfilerOverlay::ProfilerOverlay()
+	{
+		int16_t width = NAME_WIDTH + VALUE_WIDTH * (COLUMNS - 1) + 8;
+		int16_t height = LINE_HEIGHT * ROWS + 6;
+
+		background = ColorBox(width, height, Color::Name::BLACK, 0.6f);
+
+		for (size_t row = 0; row < ROWS; row++)
+		{
+			cells[row][0] = Text(Text::Font::A11M, Text::Alignment::LEFT, Color::Name::WHITE);
+
+			for (size_t column = 1; column < COLUMNS; column++)
+				cells[row][column] = Text(Text::Font::A11M, Text::Alignment::RIGHT, Color::Name::WHITE);
+		}
+
+		cells[0][0].change_text("Per frame (us)");
+		cells[0][1].change_text("p50");
+		cells[0][2].change_text("p99");
+		cells[0][3].change_text("max");
+
+		for (size_t section = 0; section < Profiler::Section::NUM_SECTIONS; section++)
+			cells[section + 1][0].change_text(Profiler::name_of(static_cast<Profiler::Section>(section)));
+
+		const size_t counters = ROWS - Profiler::Counter::NUM_COUNTERS;
+
+		cells[counters - 1][0].change_text("Frame");
+		cells[counters + Profiler::Counter::QUADS][0].change_text("Quads drawn");
+		cells[counters + Profiler::Counter::UPLOADS][0].change_text("Atlas uploads");
+		cells[counters + Profiler::Counter::NODE_LOOKUPS][0].change_text("Node lookups");
+
+		active = false;
+		ticks = 0;
+	}
+
+	void ProfilerOverlay::draw() const
+	{
+		if (!active)
+			return;
+
+		background.draw(Point<int16_t>(LEFT - 4, TOP - 2));
+
+		for (size_t row = 0; row < ROWS; row++)
+		{
+			int16_t y = static_cast<int16_t>(TOP + row * LINE_HEIGHT);
+
+			cells[row][0].draw(Point<int16_t>(LEFT, y));
+
+			for (size_t column = 1; column < COLUMNS; column++)
+				cells[row][column].draw(Point<int16_t>(static_cast<int16_t>(LEFT + NAME_WIDTH + VALUE_WIDTH * column), y));
+		}
+	}
+
+	void ProfilerOverlay::update()
+	{
+		if (!active)
+			return;
+
+		if (++ticks >= REFRESH)
+		{
+			ticks = 0;
+
+			refresh();
+		}
+	}
+
+	void ProfilerOverlay::toggle()
+	{
+		active = !active;
+		ticks = 0;
+
+		if (active)
+			refresh();
+	}
+
+	void ProfilerOverlay::refresh()
+	{
+		Profiler::Summary summary = Profiler::get().summarize();
+
+		auto set_row = [&](size_t row, const Profiler::Stats& stats)
+		{
+			cells[row][1].change_text(std::to_string(stats.p50));
+			cells[row][2].change_text(std::to_string(stats.p99));
+			cells[row][3].change_text(std::to_string(stats.max));
+		};
+
+		for (size_t section = 0; section < Profiler::Section::NUM_SECTIONS; section++)
+			set_row(section + 1, summary.sections[section]);
+
+		set_row(ROWS - Profiler::Counter::NUM_COUNTERS - 1, summary.frame);
+
+		for (size_t counter = 0; counter < Profiler::Counter::NUM_COUNTERS; counter++)
+			set_row(ROWS - Profiler::Counter::NUM_COUNTERS + counter, summary.counters[counter]);
+	}
+}
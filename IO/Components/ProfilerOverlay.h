@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "../../Graphics/Geometry.h"
+#include "../../Util/Profiler.h"
+
+namespace ms
+{
+	// Shows the percentiles of each profiled section over the recent frames in the top left corner
+	class ProfilerOverlay
+	{
+	public:
+		ProfilerOverlay();
+
+		void draw() const;
+		void update();
+
+		void toggle();
+
+	private:
+		void refresh();
+
+		// Heading, sections, whole frame, quads and uploads
+		static constexpr size_t ROWS = Profiler::Section::NUM_SECTIONS + Profiler::Counter::NUM_COUNTERS + 2;
+		// Name, p50, p99 and max
+		static constexpr size_t COLUMNS = 4;
+		// Updates between two refreshes of the numbers
+		static constexpr uint16_t REFRESH = 60;
+
+		ColorBox background;
+		Text cells[ROWS][COLUMNS];
+		bool active;
+		uint16_t ticks;
+	};
+}
@@ -22,6 +22,7 @@
 #include "UIStateLogin.h"
 #include "Window.h"
 #include "../Graphics/GraphicsGL.h"
+#include "../Util/Profiler.h"
 
 #include <iostream>
 
@@ -55,19 +56,25 @@ namespace ms
 
 	void UI::draw(float alpha) const
 	{
+		ScopedTimer timer(Profiler::Section::UI_DRAW);
+
 		// Drawing UI
 		state->draw(alpha, cursor.get_position());
 
 		scrollingnotice.draw(alpha);
+		profileroverlay.draw();
 
 		cursor.draw(alpha);
 	}
 
 	void UI::update()
 	{
+		ScopedTimer timer(Profiler::Section::UI_UPDATE);
+
 		state->update();
 
 		scrollingnotice.update();
+		profileroverlay.update();
 
 		cursor.update();
 	}
@@ -398,6 +405,11 @@ namespace ms
 		scrollingnotice.setnotice(notice);
 	}
 
+	void UI::toggle_profiler()
+	{
+		profileroverlay.toggle();
+	}
+
 	void UI::focus_textfield(Textfield* tofocus)
 	{
 		if (focusedtextfield)
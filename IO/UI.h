@@ -19,6 +19,7 @@
 
 #include "UIState.h"
 
+#include "Components/ProfilerOverlay.h"
 #include "Components/ScrollingNotice.h"
 #include "Components/Textfield.h"
 
@@ -59,6 +60,7 @@ namespace ms
 		void send_key(int32_t keycode, bool pressed);
 
 		void set_scrollnotice(const std::string& notice);
+		void toggle_profiler();
 		void focus_textfield(Textfield* textfield);
 		void remove_textfield();
 		void drag_icon(Icon* icon);
@@ -104,6 +106,7 @@ namespace ms
 		Keyboard keyboard;
 		Cursor cursor;
 		ScrollingNotice scrollingnotice;
+		ProfilerOverlay profileroverlay;
 
 		Optional<Textfield> focusedtextfield;
 		std::unordered_map<int32_t, bool> is_key_down;
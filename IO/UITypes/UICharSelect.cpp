@@ -36,8 +36,10 @@
 #include "../../Util/Misc.h"
 #include "../../Util/V83UIAssets.h"
 
+#ifdef _WIN32
 #define NOMINMAX
 #include <windows.h>
+#endif
 
 #ifdef USE_NX
 #include <nlnx/nx.hpp>
@@ -947,7 +949,9 @@ namespace ms
 			{
 				std::string url = Configuration::get().get_resetpic();
 
+#ifdef _WIN32
 				ShellExecuteA(NULL, "open", url.c_str(), NULL, NULL, SW_SHOWNORMAL);
+#endif
 				break;
 			}
 			case Buttons::BtCharacter:
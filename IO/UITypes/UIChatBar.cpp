@@ -21,12 +21,16 @@
 
 #include "../Components/MapleButton.h"
 
+#include "../../Net/Session.h"
 #include "../../Net/Packets/MessagingPackets.h"
+#include "../../Util/Profiler.h"
 
 #ifdef USE_NX
 #include <nlnx/nx.hpp>
 #endif
 
+#include <fstream>
+
 namespace ms
 {
 	UIChatBar::UIChatBar() : temp_view_x(0), temp_view_y(0), drag_direction(DragDirection::NONE), view_input(false), view_adjusted(false), position_adjusted(false)
@@ -1216,7 +1220,30 @@ namespace ms
 			user_message_history.push_back(message);
 			user_message_history_index = user_message_history.size();
 
-			GeneralChatPacket(message, true).dispatch();
+			// Client command to see which server packets took the most time to handle
+			if (message == "/packetprofile")
+			{
+				std::ofstream file("PacketProfile.txt");
+				Session::get().dump_profile(file);
+
+				show_message("Packet profile written to PacketProfile.txt", MessageType::YELLOW);
+			}
+			// Client commands to show frame times and to save the recent frames for chrome://tracing
+			else if (message == "/profiler")
+			{
+				UI::get().toggle_profiler();
+			}
+			else if (message == "/profiletrace")
+			{
+				std::ofstream file("ProfileTrace.json");
+				Profiler::get().write_trace(file);
+
+				show_message("Frame trace written to ProfileTrace.json", MessageType::YELLOW);
+			}
+			else
+			{
+				GeneralChatPacket(message, true).dispatch();
+			}
 
 			input_text.change_text("");
 		}
@@ -33,7 +33,9 @@
 #include "../../Util/Assets.h"
 #include "../../Util/V83UIAssets.h"
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <iostream>
 #include "../../Util/Misc.h"
 
@@ -414,7 +416,9 @@ namespace ms
 				return;
 		}
 
+#ifdef _WIN32
 		ShellExecuteA(NULL, "open", url.c_str(), NULL, NULL, SW_SHOWNORMAL);
+#endif
 	}
 
 	Button::State UILogin::button_pressed(uint16_t id)
@@ -135,7 +135,7 @@ namespace ms
 			int32_t i = std::stoi(name);
 
 			if (i >= offset && i <= offset + 5)
-				shownText += text;
+				shownText += text.get_string();
 		}
 
 		text.change_text(shownText);
@@ -306,7 +306,7 @@ namespace ms
 			// Invalid base image, create empty texture
 			base_img = Texture();
 		}
-		parent_map = WorldMap["info"]["parentMap"];
+		parent_map = WorldMap["info"]["parentMap"].get_string();
 
 		link_images.clear();
 		link_maps.clear();
@@ -324,7 +324,7 @@ namespace ms
 			Texture link_image = l["linkImg"];
 
 			link_images[i] = link_image;
-			link_maps[i] = l["linkMap"];
+			link_maps[i] = l["linkMap"].get_string();
 
 			buttons[i] = std::make_unique<AreaButton>(base_position - link_image.get_origin(), link_image.get_dimensions());
 			buttons[i]->set_active(true);
@@ -21,6 +21,7 @@
 
 #include "../Configuration.h"
 #include "../Timer.h"
+#include "../Util/Profiler.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -35,6 +36,7 @@ namespace ms
 		glwnd = nullptr;
 		opacity = 1.0f;
 		opcstep = 0.0f;
+		holding = false;
 		width = Constants::Constants::get().get_viewwidth();
 		height = Constants::Constants::get().get_viewheight();
 	}
@@ -275,6 +277,15 @@ namespace ms
 
 	void Window::updateopc()
 	{
+		if (holding)
+		{
+			if (!holdprocedure())
+				return;
+
+			holding = false;
+			holdprocedure = nullptr;
+		}
+
 		if (opcstep != 0.0f)
 		{
 			opacity += opcstep;
@@ -292,12 +303,17 @@ namespace ms
 				opcstep = -opcstep;
 
 				fadeprocedure();
+
+				if (holdprocedure)
+					holding = true;
 			}
 		}
 	}
 
 	void Window::check_events()
 	{
+		ScopedTimer timer(Profiler::Section::EVENTS);
+
 		int16_t max_width = Configuration::get().get_max_width();
 		int16_t max_height = Configuration::get().get_max_height();
 		int16_t new_width = Constants::Constants::get().get_viewwidth();
@@ -336,10 +352,12 @@ namespace ms
 
 	}
 
-	void Window::fadeout(float step, std::function<void()> fadeproc)
+	void Window::fadeout(float step, std::function<void()> fadeproc, std::function<bool()> holdproc)
 	{
 		opcstep = -step;
 		fadeprocedure = fadeproc;
+		holdprocedure = holdproc;
+		holding = false;
 	}
 
 	void Window::setclipboard(const std::string& text) const
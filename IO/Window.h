@@ -42,7 +42,8 @@ namespace ms
 		void update();
 		void begin() const;
 		void end() const;
-		void fadeout(float step, std::function<void()> fadeprocedure);
+		// Fade to black and run the procedure, the screen stays black until the hold procedure returns true
+		void fadeout(float step, std::function<void()> fadeprocedure, std::function<bool()> holdprocedure = nullptr);
 		void check_events();
 
 		void setclipboard(const std::string& text) const;
@@ -59,6 +60,8 @@ namespace ms
 		float opacity;
 		float opcstep;
 		std::function<void()> fadeprocedure;
+		std::function<bool()> holdprocedure;
+		bool holding;
 		int16_t width;
 		int16_t height;
 	};
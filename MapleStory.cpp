@@ -16,11 +16,14 @@
 //	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
 //////////////////////////////////////////////////////////////////////////////////
 #include "Gameplay/Stage.h"
+#include "Gameplay/MapleMap/MapPrefetcher.h"
 #include "IO/UI.h"
 #include "IO/Window.h"
 #include "quick_nx_test.cpp"
 #include "Net/Session.h"
 #include "Util/HardwareInfo.h"
+#include "Util/NodeCache.h"
+#include "Util/Profiler.h"
 #include "Util/ScreenResolution.h"
 
 #include <iostream>
@@ -118,10 +121,19 @@ namespace ms
 			for (accumulator += elapsed; accumulator >= timestep; accumulator -= timestep)
 				update();
 
+			// Send the packets of all updates in this frame together
+			Session::get().flush();
+
+			// A map being loaded gets a slice of every frame until it is done
+			Stage::get().continue_load();
+
 			// Draw the game. Interpolate to account for remaining time.
 			float alpha = static_cast<float>(accumulator) / timestep;
 			draw(alpha);
 
+			Profiler::get().count(Profiler::Counter::NODE_LOOKUPS, static_cast<size_t>(NodeCache::get().take_lookups()));
+			Profiler::get().next_frame();
+
 			if (show_fps)
 			{
 				if (samples < 100)
@@ -141,6 +153,8 @@ namespace ms
 			}
 		}
 
+		// The prefetcher's thread reads the NX files, which are closed on exit
+		MapPrefetcher::get().clear();
 		Sound::close();
 	}
 
@@ -17,8 +17,270 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "Cryptography.h"
 
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define AES_NI_MSVC
+#include <intrin.h>
+#include <wmmintrin.h>
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AES_NI_GCC
+#include <cpuid.h>
+#include <wmmintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MAPLE_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace ms
 {
+	namespace
+	{
+		// Rijndael substitution box
+		const uint8_t subbox[256] =
+		{
+			0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+			0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+			0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+			0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+			0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+			0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+			0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+			0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+			0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+			0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+			0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+			0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+			0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+			0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+			0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+			0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+		};
+
+		// This key is already expanded
+		// Only works for versions lower than version 118
+		const uint8_t maplekey[256] =
+		{
+			0x13, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0xB4, 0x00, 0x00, 0x00,
+			0x1B, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x33, 0x00, 0x00, 0x00, 0x52, 0x00, 0x00, 0x00,
+			0x71, 0x63, 0x63, 0x00, 0x79, 0x63, 0x63, 0x00, 0x7F, 0x63, 0x63, 0x00, 0xCB, 0x63, 0x63, 0x00,
+			0x04, 0xFB, 0xFB, 0x63, 0x0B, 0xFB, 0xFB, 0x63, 0x38, 0xFB, 0xFB, 0x63, 0x6A, 0xFB, 0xFB, 0x63,
+			0x7C, 0x6C, 0x98, 0x02, 0x05, 0x0F, 0xFB, 0x02, 0x7A, 0x6C, 0x98, 0x02, 0xB1, 0x0F, 0xFB, 0x02,
+			0xCC, 0x8D, 0xF4, 0x14, 0xC7, 0x76, 0x0F, 0x77, 0xFF, 0x8D, 0xF4, 0x14, 0x95, 0x76, 0x0F, 0x77,
+			0x40, 0x1A, 0x6D, 0x28, 0x45, 0x15, 0x96, 0x2A, 0x3F, 0x79, 0x0E, 0x28, 0x8E, 0x76, 0xF5, 0x2A,
+			0xD5, 0xB5, 0x12, 0xF1, 0x12, 0xC3, 0x1D, 0x86, 0xED, 0x4E, 0xE9, 0x92, 0x78, 0x38, 0xE6, 0xE5,
+			0x4F, 0x94, 0xB4, 0x94, 0x0A, 0x81, 0x22, 0xBE, 0x35, 0xF8, 0x2C, 0x96, 0xBB, 0x8E, 0xD9, 0xBC,
+			0x3F, 0xAC, 0x27, 0x94, 0x2D, 0x6F, 0x3A, 0x12, 0xC0, 0x21, 0xD3, 0x80, 0xB8, 0x19, 0x35, 0x65,
+			0x8B, 0x02, 0xF9, 0xF8, 0x81, 0x83, 0xDB, 0x46, 0xB4, 0x7B, 0xF7, 0xD0, 0x0F, 0xF5, 0x2E, 0x6C,
+			0x49, 0x4A, 0x16, 0xC4, 0x64, 0x25, 0x2C, 0xD6, 0xA4, 0x04, 0xFF, 0x56, 0x1C, 0x1D, 0xCA, 0x33,
+			0x0F, 0x76, 0x3A, 0x64, 0x8E, 0xF5, 0xE1, 0x22, 0x3A, 0x8E, 0x16, 0xF2, 0x35, 0x7B, 0x38, 0x9E,
+			0xDF, 0x6B, 0x11, 0xCF, 0xBB, 0x4E, 0x3D, 0x19, 0x1F, 0x4A, 0xC2, 0x4F, 0x03, 0x57, 0x08, 0x7C,
+			0x14, 0x46, 0x2A, 0x1F, 0x9A, 0xB3, 0xCB, 0x3D, 0xA0, 0x3D, 0xDD, 0xCF, 0x95, 0x46, 0xE5, 0x51,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+		};
+
+		uint8_t rollleft(uint8_t byte, size_t count)
+		{
+			count %= 8;
+
+			return static_cast<uint8_t>((byte << count) | (byte >> ((8 - count) % 8)));
+		}
+
+		uint8_t rollright(uint8_t byte, size_t count)
+		{
+			return rollleft(byte, 8 - count % 8);
+		}
+
+		// Lookup tables for the maple custom encryption, which combine the rolls
+		// with the constant transforms around them
+		struct MapleTables
+		{
+			uint8_t rollleft3[256];
+			uint8_t rollleft4[256];
+			uint8_t rollright3[256];
+			uint8_t rollright4[256];
+			// The last step of the forward encryption pass: ~ror(x, n) + 0x48
+			uint8_t encryptfinish[8][256];
+			// The last step of the reverse encryption pass: ror(x ^ 0x13, 3)
+			uint8_t encryptreverse[256];
+			// The first step of the reverse decryption pass: rol(x, 3) ^ 0x13
+			uint8_t decryptreverse[256];
+			// The first step of the forward decryption pass: rol(~(x - 0x48), n)
+			uint8_t decryptstart[8][256];
+
+			MapleTables()
+			{
+				for (size_t i = 0; i < 256; i++)
+				{
+					uint8_t x = static_cast<uint8_t>(i);
+
+					rollleft3[i] = rollleft(x, 3);
+					rollleft4[i] = rollleft(x, 4);
+					rollright3[i] = rollright(x, 3);
+					rollright4[i] = rollright(x, 4);
+					encryptreverse[i] = rollright(x ^ 0x13, 3);
+					decryptreverse[i] = rollleft(x, 3) ^ 0x13;
+
+					for (size_t n = 0; n < 8; n++)
+					{
+						encryptfinish[n][i] = static_cast<uint8_t>(~rollright(x, n) + 0x48);
+						decryptstart[n][i] = rollleft(static_cast<uint8_t>(~(x - 0x48)), n);
+					}
+				}
+			}
+		};
+
+		const MapleTables& mapletables()
+		{
+			static const MapleTables tables;
+
+			return tables;
+		}
+
+#ifdef MAPLE_SSE2
+		template <int count>
+		// Roll each byte of a vector to the left
+		__m128i rollleft(__m128i bytes)
+		{
+			const __m128i high = _mm_set1_epi8(static_cast<char>((0xFF << count) & 0xFF));
+			const __m128i low = _mm_set1_epi8(static_cast<char>(0xFF >> (8 - count)));
+
+			__m128i left = _mm_and_si128(_mm_slli_epi16(bytes, count), high);
+			__m128i right = _mm_and_si128(_mm_srli_epi16(bytes, 8 - count), low);
+
+			return _mm_or_si128(left, right);
+		}
+
+		template <int count>
+		// Roll each byte of a vector to the left if its count has the given bit set
+		__m128i rollleft_if(__m128i bytes, __m128i counts)
+		{
+			const __m128i bit = _mm_set1_epi8(count);
+			__m128i mask = _mm_cmpeq_epi8(_mm_and_si128(counts, bit), bit);
+
+			return _mm_or_si128(_mm_and_si128(mask, rollleft<count>(bytes)), _mm_andnot_si128(mask, bytes));
+		}
+
+		// Roll each byte of a vector to the left by the lowest three bits of its count
+		__m128i rollleft(__m128i bytes, __m128i counts)
+		{
+			bytes = rollleft_if<1>(bytes, counts);
+			bytes = rollleft_if<2>(bytes, counts);
+
+			return rollleft_if<4>(bytes, counts);
+		}
+
+		// Decrypt one round of the maple custom encryption, 16 bytes at a time
+		// Returns the number of bytes decrypted and leaves the last remember value.
+		size_t mapledecrypt_sse2(uint8_t* bytes, size_t length, uint8_t& remember)
+		{
+			const __m128i ramp = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+			const __m128i one = _mm_set1_epi8(1);
+			const __m128i xorkey = _mm_set1_epi8(0x13);
+			const __m128i offset = _mm_set1_epi8(0x48);
+			const __m128i ones = _mm_set1_epi8(-1);
+
+			__m128i previous = _mm_setzero_si128();
+			size_t j = 0;
+
+			// The byte after each block is read too, so the last block is left to the scalar loop
+			for (; j + 16 < length; j += 16)
+			{
+				__m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + j));
+				__m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + j + 1));
+
+				__m128i curtransformed = _mm_xor_si128(rollleft<3>(current), xorkey);
+				__m128i nexttransformed = _mm_xor_si128(rollleft<3>(next), xorkey);
+
+				__m128i reverselen = _mm_add_epi8(_mm_add_epi8(_mm_set1_epi8(static_cast<char>(j)), ramp), one);
+				__m128i datalen = _mm_sub_epi8(_mm_set1_epi8(static_cast<char>(length - j)), ramp);
+
+				__m128i reversed = rollleft<4>(_mm_sub_epi8(_mm_xor_si128(curtransformed, nexttransformed), reverselen));
+
+				__m128i inverted = _mm_xor_si128(_mm_sub_epi8(reversed, offset), ones);
+				__m128i forward = rollleft(inverted, datalen);
+
+				__m128i remembered = _mm_or_si128(_mm_slli_si128(forward, 1), _mm_srli_si128(previous, 15));
+				remembered = j == 0 ? _mm_slli_si128(forward, 1) : remembered;
+
+				__m128i result = rollleft<5>(_mm_sub_epi8(_mm_xor_si128(forward, remembered), datalen));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + j), result);
+
+				previous = forward;
+			}
+
+			if (j > 0)
+				remember = static_cast<uint8_t>(_mm_cvtsi128_si32(_mm_srli_si128(previous, 15)));
+
+			return j;
+		}
+#endif
+
+		const size_t ROUNDS = 14;
+
+		uint32_t rotate(uint32_t word, uint32_t count)
+		{
+			return (word << count) | (word >> (32 - count));
+		}
+
+		uint32_t load(const uint8_t* bytes)
+		{
+			uint32_t word;
+			std::memcpy(&word, bytes, sizeof(word));
+
+			return word;
+		}
+
+		// Lookup tables which combine the sub bytes and mix columns steps
+		// The state is held as four little-endian column words.
+		struct AESTables
+		{
+			uint32_t encrypt[4][256];
+			uint32_t roundkeys[4 * (ROUNDS + 1)];
+			bool hardware;
+
+			AESTables()
+			{
+				for (size_t i = 0; i < 256; i++)
+				{
+					uint32_t s = subbox[i];
+					uint32_t s2 = ((s << 1) ^ ((s & 0x80) ? 0x1B : 0x00)) & 0xFF;
+					uint32_t s3 = s2 ^ s;
+					uint32_t word = s2 | (s << 8) | (s << 16) | (s3 << 24);
+
+					encrypt[0][i] = word;
+					encrypt[1][i] = rotate(word, 8);
+					encrypt[2][i] = rotate(word, 16);
+					encrypt[3][i] = rotate(word, 24);
+				}
+
+				for (size_t i = 0; i < 4 * (ROUNDS + 1); i++)
+					roundkeys[i] = load(maplekey + 4 * i);
+
+				hardware = false;
+#if defined(AES_NI_MSVC)
+				int info[4];
+				__cpuid(info, 1);
+				hardware = (info[2] & (1 << 25)) != 0;
+#elif defined(AES_NI_GCC)
+				unsigned int eax, ebx, ecx, edx;
+
+				if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+					hardware = (ecx & bit_AES) != 0;
+#endif
+			}
+		};
+
+		const AESTables& aestables()
+		{
+			static const AESTables tables;
+
+			return tables;
+		}
+	}
+
 	Cryptography::Cryptography(const int8_t* handshake)
 	{
 #ifdef USE_CRYPTO
@@ -38,6 +300,7 @@ namespace ms
 #ifdef USE_CRYPTO
 		mapleencrypt(bytes, length);
 		aesofb(bytes, length, sendiv);
+		updateiv(sendiv);
 #endif
 	}
 
@@ -45,6 +308,7 @@ namespace ms
 	{
 #ifdef USE_CRYPTO
 		aesofb(bytes, length, recviv);
+		updateiv(recviv);
 		mapledecrypt(bytes, length);
 #endif
 	}
@@ -91,59 +355,70 @@ namespace ms
 #endif
 	}
 
-	void Cryptography::mapleencrypt(int8_t* bytes, size_t length) const
+	void Cryptography::mapleencrypt(int8_t* signedbytes, size_t length)
 	{
+		const MapleTables& tables = mapletables();
+		uint8_t* bytes = reinterpret_cast<uint8_t*>(signedbytes);
+
+		// Each pass depends on the whole result of the one before it, running in the opposite direction
 		for (size_t j = 0; j < 3; j++)
 		{
-			int8_t remember = 0;
-			int8_t datalen = static_cast<int8_t>(length & 0xFF);
+			uint8_t remember = 0;
+			uint8_t datalen = static_cast<uint8_t>(length & 0xFF);
 
 			for (size_t i = 0; i < length; i++)
 			{
-				int8_t cur = (rollleft(bytes[i], 3) + datalen) ^ remember;
+				uint8_t cur = static_cast<uint8_t>(tables.rollleft3[bytes[i]] + datalen) ^ remember;
 				remember = cur;
-				cur = rollright(cur, static_cast<int32_t>(datalen) & 0xFF);
-				bytes[i] = static_cast<int8_t>((~cur) & 0xFF) + 0x48;
+				bytes[i] = tables.encryptfinish[datalen & 7][cur];
 				datalen--;
 			}
 
 			remember = 0;
-			datalen = static_cast<int8_t>(length & 0xFF);
+			datalen = static_cast<uint8_t>(length & 0xFF);
 
 			for (size_t i = length; i--;)
 			{
-				int8_t cur = (rollleft(bytes[i], 4) + datalen) ^ remember;
+				uint8_t cur = static_cast<uint8_t>(tables.rollleft4[bytes[i]] + datalen) ^ remember;
 				remember = cur;
-				bytes[i] = rollright(cur ^ 0x13, 3);
+				bytes[i] = tables.encryptreverse[cur];
 				datalen--;
 			}
 		}
 	}
 
-	void Cryptography::mapledecrypt(int8_t* bytes, size_t length) const
+	void Cryptography::mapledecrypt(int8_t* signedbytes, size_t length)
 	{
+		const MapleTables& tables = mapletables();
+		uint8_t* bytes = reinterpret_cast<uint8_t*>(signedbytes);
+
+		// In the reverse pass, remember only holds the transformed input byte after the current one.
+		// Both passes of a round therefore only depend on neighbouring input bytes
+		// and are fused into a single forward sweep.
 		for (size_t i = 0; i < 3; i++)
 		{
 			uint8_t remember = 0;
-			uint8_t datalen = static_cast<uint8_t>(length & 0xFF);
+			size_t j = 0;
 
-			for (size_t j = length; j--;)
-			{
-				uint8_t cur = rollleft(bytes[j], 3) ^ 0x13;
-				bytes[j] = rollright((cur ^ remember) - datalen, 4);
-				remember = cur;
-				datalen--;
-			}
+#ifdef MAPLE_SSE2
+			j = mapledecrypt_sse2(bytes, length, remember);
+#endif
 
-			remember = 0;
-			datalen = static_cast<uint8_t>(length & 0xFF);
+			uint8_t datalen = static_cast<uint8_t>(length - j);
+			uint8_t next = j < length ? tables.decryptreverse[bytes[j]] : 0;
 
-			for (size_t j = 0; j < length; j++)
+			for (; j < length; j++)
 			{
-				uint8_t cur = (~(bytes[j] - 0x48)) & 0xFF;
-				cur = rollleft(cur, static_cast<int32_t>(datalen) & 0xFF);
-				bytes[j] = rollright((cur ^ remember) - datalen, 3);
-				remember = cur;
+				uint8_t cur = next;
+				next = j + 1 < length ? tables.decryptreverse[bytes[j + 1]] : 0;
+
+				// The reverse pass counts up from the end, the forward pass down from the start
+				uint8_t reverselen = static_cast<uint8_t>(j + 1);
+				uint8_t reversed = tables.rollright4[static_cast<uint8_t>((cur ^ next) - reverselen)];
+
+				uint8_t forward = tables.decryptstart[datalen & 7][reversed];
+				bytes[j] = tables.rollright3[static_cast<uint8_t>((forward ^ remember) - datalen)];
+				remember = forward;
 				datalen--;
 			}
 		}
@@ -202,175 +477,141 @@ namespace ms
 			iv[i] = mbytes[i];
 	}
 
-	int8_t Cryptography::rollleft(int8_t data, size_t count) const
-	{
-		int32_t mask = (data & 0xFF) << (count % 8);
-
-		return static_cast<int8_t>((mask & 0xFF) | (mask >> 8));
-	}
-
-	int8_t Cryptography::rollright(int8_t data, size_t count) const
+	void Cryptography::aesofb(int8_t* bytes, size_t length, const uint8_t* iv)
 	{
-		int32_t mask = ((data & 0xFF) << 8) >> (count % 8);
-
-		return static_cast<int8_t>((mask & 0xFF) | (mask >> 8));
-	}
+		uint8_t keystream[BLOCK_LENGTH];
+		size_t streamlength = aeskeystream(iv, keystream, length);
 
-	void Cryptography::aesofb(int8_t* bytes, size_t length, uint8_t* iv) const
-	{
-		size_t blocklength = 0x5B0;
+		size_t blocklength = FIRST_BLOCK_LENGTH;
 		size_t offset = 0;
 
 		while (offset < length)
 		{
-			uint8_t miv[16];
-
-			for (size_t i = 0; i < 16; i++)
-				miv[i] = iv[i % 4];
-
 			size_t remaining = length - offset;
 
 			if (remaining > blocklength)
 				remaining = blocklength;
 
-			for (size_t x = 0; x < remaining; x++)
-			{
-				size_t relpos = x % 16;
+			if (remaining > streamlength)
+				remaining = streamlength;
+
+			int8_t* block = bytes + offset;
+			size_t x = 0;
 
-				if (relpos == 0)
-					aesencrypt(miv);
+			for (; x + sizeof(uint64_t) <= remaining; x += sizeof(uint64_t))
+			{
+				uint64_t data;
+				uint64_t stream;
+				std::memcpy(&data, block + x, sizeof(data));
+				std::memcpy(&stream, keystream + x, sizeof(stream));
 
-				bytes[x + offset] ^= miv[relpos];
+				data ^= stream;
+				std::memcpy(block + x, &data, sizeof(data));
 			}
 
+			for (; x < remaining; x++)
+				block[x] ^= keystream[x];
+
 			offset += blocklength;
-			blocklength = 0x5B4;
+			blocklength = BLOCK_LENGTH;
 		}
-
-		updateiv(iv);
 	}
 
-	void Cryptography::aesencrypt(uint8_t* bytes) const
+	size_t Cryptography::aeskeystream(const uint8_t* iv, uint8_t* keystream, size_t length)
 	{
-		uint8_t round = 0;
-		addroundkey(bytes, round);
+		// Every block restarts from the iv, so later blocks reuse the start of the stream
+		if (length > BLOCK_LENGTH)
+			length = BLOCK_LENGTH;
+
+		uint8_t miv[16];
 
-		for (round = 1; round < 14; round++)
+		for (size_t i = 0; i < 16; i++)
+			miv[i] = iv[i % 4];
+
+		bool hardware = aestables().hardware;
+
+		for (size_t offset = 0; offset < length; offset += 16)
 		{
-			subbytes(bytes);
-			shiftrows(bytes);
-			mixcolumns(bytes);
-			addroundkey(bytes, round);
+			if (hardware)
+				aesencryptni(miv);
+			else
+				aesencrypt(miv);
+
+			size_t count = length - offset < 16 ? length - offset : 16;
+			std::memcpy(keystream + offset, miv, count);
 		}
 
-		subbytes(bytes);
-		shiftrows(bytes);
-		addroundkey(bytes, round);
+		return length;
 	}
 
-	void Cryptography::addroundkey(uint8_t* bytes, uint8_t round) const
+	const char* Cryptography::aesbackend()
 	{
-		// This key is already expanded
-		// Only works for versions lower than version 118
-		static const uint8_t maplekey[256] =
-		{
-			0x13, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0xB4, 0x00, 0x00, 0x00,
-			0x1B, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x33, 0x00, 0x00, 0x00, 0x52, 0x00, 0x00, 0x00,
-			0x71, 0x63, 0x63, 0x00, 0x79, 0x63, 0x63, 0x00, 0x7F, 0x63, 0x63, 0x00, 0xCB, 0x63, 0x63, 0x00,
-			0x04, 0xFB, 0xFB, 0x63, 0x0B, 0xFB, 0xFB, 0x63, 0x38, 0xFB, 0xFB, 0x63, 0x6A, 0xFB, 0xFB, 0x63,
-			0x7C, 0x6C, 0x98, 0x02, 0x05, 0x0F, 0xFB, 0x02, 0x7A, 0x6C, 0x98, 0x02, 0xB1, 0x0F, 0xFB, 0x02,
-			0xCC, 0x8D, 0xF4, 0x14, 0xC7, 0x76, 0x0F, 0x77, 0xFF, 0x8D, 0xF4, 0x14, 0x95, 0x76, 0x0F, 0x77,
-			0x40, 0x1A, 0x6D, 0x28, 0x45, 0x15, 0x96, 0x2A, 0x3F, 0x79, 0x0E, 0x28, 0x8E, 0x76, 0xF5, 0x2A,
-			0xD5, 0xB5, 0x12, 0xF1, 0x12, 0xC3, 0x1D, 0x86, 0xED, 0x4E, 0xE9, 0x92, 0x78, 0x38, 0xE6, 0xE5,
-			0x4F, 0x94, 0xB4, 0x94, 0x0A, 0x81, 0x22, 0xBE, 0x35, 0xF8, 0x2C, 0x96, 0xBB, 0x8E, 0xD9, 0xBC,
-			0x3F, 0xAC, 0x27, 0x94, 0x2D, 0x6F, 0x3A, 0x12, 0xC0, 0x21, 0xD3, 0x80, 0xB8, 0x19, 0x35, 0x65,
-			0x8B, 0x02, 0xF9, 0xF8, 0x81, 0x83, 0xDB, 0x46, 0xB4, 0x7B, 0xF7, 0xD0, 0x0F, 0xF5, 0x2E, 0x6C,
-			0x49, 0x4A, 0x16, 0xC4, 0x64, 0x25, 0x2C, 0xD6, 0xA4, 0x04, 0xFF, 0x56, 0x1C, 0x1D, 0xCA, 0x33,
-			0x0F, 0x76, 0x3A, 0x64, 0x8E, 0xF5, 0xE1, 0x22, 0x3A, 0x8E, 0x16, 0xF2, 0x35, 0x7B, 0x38, 0x9E,
-			0xDF, 0x6B, 0x11, 0xCF, 0xBB, 0x4E, 0x3D, 0x19, 0x1F, 0x4A, 0xC2, 0x4F, 0x03, 0x57, 0x08, 0x7C,
-			0x14, 0x46, 0x2A, 0x1F, 0x9A, 0xB3, 0xCB, 0x3D, 0xA0, 0x3D, 0xDD, 0xCF, 0x95, 0x46, 0xE5, 0x51,
-			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-		};
-
-		uint8_t offset = round * 16;
-
-		for (uint8_t i = 0; i < 16; i++)
-			bytes[i] ^= maplekey[i + offset];
+		return aestables().hardware ? "AES-NI" : "T-tables";
 	}
 
-	void Cryptography::subbytes(uint8_t* bytes) const
+	void Cryptography::aesencrypt(uint8_t* block)
 	{
-		// Rijndael substitution box
-		static const uint8_t subbox[256] =
+		const AESTables& tables = aestables();
+		const uint32_t(&te)[4][256] = tables.encrypt;
+		const uint32_t* rk = tables.roundkeys;
+
+		uint32_t s0 = load(block) ^ rk[0];
+		uint32_t s1 = load(block + 4) ^ rk[1];
+		uint32_t s2 = load(block + 8) ^ rk[2];
+		uint32_t s3 = load(block + 12) ^ rk[3];
+
+		for (size_t round = 1; round < ROUNDS; round++)
 		{
-			0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
-			0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
-			0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
-			0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
-			0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
-			0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
-			0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
-			0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
-			0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
-			0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
-			0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
-			0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
-			0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
-			0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
-			0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
-			0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
-		};
+			rk += 4;
 
-		for (uint8_t i = 0; i < 16; i++)
-			bytes[i] = subbox[bytes[i]];
-	}
+			uint32_t t0 = te[0][s0 & 0xFF] ^ te[1][(s1 >> 8) & 0xFF] ^ te[2][(s2 >> 16) & 0xFF] ^ te[3][s3 >> 24] ^ rk[0];
+			uint32_t t1 = te[0][s1 & 0xFF] ^ te[1][(s2 >> 8) & 0xFF] ^ te[2][(s3 >> 16) & 0xFF] ^ te[3][s0 >> 24] ^ rk[1];
+			uint32_t t2 = te[0][s2 & 0xFF] ^ te[1][(s3 >> 8) & 0xFF] ^ te[2][(s0 >> 16) & 0xFF] ^ te[3][s1 >> 24] ^ rk[2];
+			uint32_t t3 = te[0][s3 & 0xFF] ^ te[1][(s0 >> 8) & 0xFF] ^ te[2][(s1 >> 16) & 0xFF] ^ te[3][s2 >> 24] ^ rk[3];
 
-	void Cryptography::shiftrows(uint8_t* bytes) const
-	{
-		uint8_t remember = bytes[1];
-		bytes[1] = bytes[5];
-		bytes[5] = bytes[9];
-		bytes[9] = bytes[13];
-		bytes[13] = remember;
-
-		remember = bytes[10];
-		bytes[10] = bytes[2];
-		bytes[2] = remember;
-
-		remember = bytes[3];
-		bytes[3] = bytes[15];
-		bytes[15] = bytes[11];
-		bytes[11] = bytes[7];
-		bytes[7] = remember;
-
-		remember = bytes[14];
-		bytes[14] = bytes[6];
-		bytes[6] = remember;
-	}
+			s0 = t0;
+			s1 = t1;
+			s2 = t2;
+			s3 = t3;
+		}
 
-	uint8_t Cryptography::gmul(uint8_t x) const
-	{
-		return (x << 1) ^ (0x1B & (uint8_t)((int8_t)x >> 7));
-	}
+		rk += 4;
 
-	void Cryptography::mixcolumns(uint8_t* bytes) const
-	{
-		for (uint8_t i = 0; i < 16; i += 4)
+		// The last round has no mix columns step
+		uint32_t state[4] = { s0, s1, s2, s3 };
+
+		for (size_t i = 0; i < 4; i++)
 		{
-			uint8_t cpy0 = bytes[i];
-			uint8_t cpy1 = bytes[i + 1];
-			uint8_t cpy2 = bytes[i + 2];
-			uint8_t cpy3 = bytes[i + 3];
-
-			uint8_t mul0 = gmul(bytes[i]);
-			uint8_t mul1 = gmul(bytes[i + 1]);
-			uint8_t mul2 = gmul(bytes[i + 2]);
-			uint8_t mul3 = gmul(bytes[i + 3]);
-
-			bytes[i] = mul0 ^ cpy3 ^ cpy2 ^ mul1 ^ cpy1;
-			bytes[i + 1] = mul1 ^ cpy0 ^ cpy3 ^ mul2 ^ cpy2;
-			bytes[i + 2] = mul2 ^ cpy1 ^ cpy0 ^ mul3 ^ cpy3;
-			bytes[i + 3] = mul3 ^ cpy2 ^ cpy1 ^ mul0 ^ cpy0;
+			uint32_t word =
+				static_cast<uint32_t>(subbox[state[i] & 0xFF]) |
+				(static_cast<uint32_t>(subbox[(state[(i + 1) % 4] >> 8) & 0xFF]) << 8) |
+				(static_cast<uint32_t>(subbox[(state[(i + 2) % 4] >> 16) & 0xFF]) << 16) |
+				(static_cast<uint32_t>(subbox[state[(i + 3) % 4] >> 24]) << 24);
+
+			word ^= rk[i];
+			std::memcpy(block + 4 * i, &word, sizeof(word));
 		}
 	}
-}
\ No newline at end of file
+
+#if defined(AES_NI_GCC)
+	__attribute__((target("aes,sse2")))
+#endif
+	void Cryptography::aesencryptni(uint8_t* block)
+	{
+#if defined(AES_NI_MSVC) || defined(AES_NI_GCC)
+		const __m128i* rk = reinterpret_cast<const __m128i*>(maplekey);
+
+		__m128i state = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+		state = _mm_xor_si128(state, _mm_loadu_si128(rk));
+
+		for (size_t round = 1; round < ROUNDS; round++)
+			state = _mm_aesenc_si128(state, _mm_loadu_si128(rk + round));
+
+		state = _mm_aesenclast_si128(state, _mm_loadu_si128(rk + ROUNDS));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(block), state);
+#else
+		aesencrypt(block);
+#endif
+	}
+}
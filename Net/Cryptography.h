@@ -41,32 +41,33 @@ namespace ms
 		// Use the 4-byte header of a received packet to determine its length
 		size_t check_length(const int8_t* header) const;
 
-	private:
+		// Apply AES OFB with the given iv to a byte array
+		// The keystream is generated once up front as every block of a packet starts over with the same iv.
+		static void aesofb(int8_t* bytes, size_t length, const uint8_t* iv);
+		// Generate the AES OFB keystream of an iv and return the number of bytes written
+		// At most BLOCK_LENGTH bytes are needed, no matter how long a packet is.
+		static size_t aeskeystream(const uint8_t* iv, uint8_t* keystream, size_t length);
+		// Return the name of the AES implementation in use
+		static const char* aesbackend();
+
+		// Length of the first block of a packet
+		static const size_t FIRST_BLOCK_LENGTH = 0x5B0;
+		// Length of all following blocks of a packet
+		static const size_t BLOCK_LENGTH = 0x5B4;
+
 		// Add the maple custom encryption
-		void mapleencrypt(int8_t* bytes, size_t length) const;
+		static void mapleencrypt(int8_t* bytes, size_t length);
 		// Remove the maple custom encryption
-		void mapledecrypt(int8_t* bytes, size_t length) const;
+		static void mapledecrypt(int8_t* bytes, size_t length);
+
+	private:
 		// Update a key
 		void updateiv(uint8_t* iv) const;
-		// Perform a roll-left operation
-		int8_t rollleft(int8_t byte, size_t count) const;
-		// Perform a roll-right operation
-		int8_t rollright(int8_t byte, size_t count) const;
 
-		// Apply AES OFB to a byte array
-		void aesofb(int8_t* bytes, size_t length, uint8_t* iv) const;
-		// Encrypt a byte array with AES
-		void aesencrypt(uint8_t* bytes) const;
-		// AES add round key step
-		void addroundkey(uint8_t* bytes, uint8_t round) const;
-		// AES sub bytes step
-		void subbytes(uint8_t* bytes) const;
-		// AES shift rows step
-		void shiftrows(uint8_t* bytes) const;
-		// AES mix columns step
-		void mixcolumns(uint8_t* bytes) const;
-		// Perform a Galois multiplication
-		uint8_t gmul(uint8_t byte) const;
+		// Encrypt a block with AES using lookup tables
+		static void aesencrypt(uint8_t* block);
+		// Encrypt a block with AES using the AES-NI instructions
+		static void aesencryptni(uint8_t* block);
 
 #ifdef USE_CRYPTO
 		uint8_t sendiv[HEADER_LENGTH];
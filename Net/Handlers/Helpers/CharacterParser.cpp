@@ -29,11 +29,14 @@ namespace ms
 		invent.set_meso(recv.read_int());
 		LOG(LOG_DEBUG, "[CharacterParser] Meso set");
 		
-		invent.set_slotmax(InventoryType::EQUIP, recv.read_byte());
-		invent.set_slotmax(InventoryType::USE, recv.read_byte());
-		invent.set_slotmax(InventoryType::SETUP, recv.read_byte());
-		invent.set_slotmax(InventoryType::ETC, recv.read_byte());
-		invent.set_slotmax(InventoryType::CASH, recv.read_byte());
+		uint8_t slotmax[5];
+		recv.read_array(slotmax, 5);
+
+		invent.set_slotmax(InventoryType::EQUIP, slotmax[0]);
+		invent.set_slotmax(InventoryType::USE, slotmax[1]);
+		invent.set_slotmax(InventoryType::SETUP, slotmax[2]);
+		invent.set_slotmax(InventoryType::ETC, slotmax[3]);
+		invent.set_slotmax(InventoryType::CASH, slotmax[4]);
 		LOG(LOG_DEBUG, "[CharacterParser] Slot maxes set");
 
 		recv.skip(8);
@@ -117,8 +120,11 @@ namespace ms
 
 		for (int16_t i = 0; i < size; i++)
 		{
-			int32_t skill_id = recv.read_int();
-			int32_t level = recv.read_int();
+			int32_t entry[2];
+			recv.read_array(entry, 2);
+
+			int32_t skill_id = entry[0];
+			int32_t level = entry[1];
 			int64_t expiration = recv.read_long();
 			bool fourthtjob = ((skill_id % 100000) / 10000 == 2);
 			int32_t masterlevel = fourthtjob ? recv.read_int() : 0;
@@ -187,12 +193,9 @@ namespace ms
 
 		for (int16_t i = 0; i < rsize; i++)
 		{
-			recv.read_int();
-			recv.read_padded_string(13);
-			recv.read_int();
-			recv.read_int();
-			recv.read_int();
-			recv.read_int();
+			recv.skip_int();
+			recv.skip_padded_string(13);
+			recv.skip(4 * sizeof(int32_t));
 		}
 	}
 
@@ -202,13 +205,9 @@ namespace ms
 
 		for (int16_t i = 0; i < rsize; i++)
 		{
-			recv.read_int();
-			recv.read_padded_string(13);
-			recv.read_int();
-			recv.read_int();
-			recv.read_int();
-			recv.read_int();
-			recv.read_int();
+			recv.skip_int();
+			recv.skip_padded_string(13);
+			recv.skip(5 * sizeof(int32_t));
 		}
 	}
 
@@ -218,14 +217,11 @@ namespace ms
 
 		for (int16_t i = 0; i < rsize; i++)
 		{
-			recv.read_int();
-			recv.read_int();
-			recv.read_int();
-			recv.read_short();
-			recv.read_int();
-			recv.read_int();
-			recv.read_padded_string(13);
-			recv.read_padded_string(13);
+			recv.skip(3 * sizeof(int32_t));
+			recv.skip_short();
+			recv.skip(2 * sizeof(int32_t));
+			recv.skip_padded_string(13);
+			recv.skip_padded_string(13);
 		}
 	}
 
@@ -278,11 +274,14 @@ namespace ms
 
 	void CharacterParser::parse_teleportrock(InPacket& recv, TeleportRock& teleportrock)
 	{
+		int32_t locations[15];
+		recv.read_array(locations, 15);
+
 		for (size_t i = 0; i < 5; i++)
-			teleportrock.addlocation(recv.read_int());
+			teleportrock.addlocation(locations[i]);
 
-		for (size_t i = 0; i < 10; i++)
-			teleportrock.addviplocation(recv.read_int());
+		for (size_t i = 5; i < 15; i++)
+			teleportrock.addviplocation(locations[i]);
 	}
 
 	void CharacterParser::parse_nyinfo(InPacket& recv)
@@ -291,29 +290,29 @@ namespace ms
 
 		for (int16_t i = 0; i < nysize; i++)
 		{
-			recv.read_int();	// NewYear Id
-			recv.read_int();	// NewYear SenderId
-			recv.read_string();	// NewYear SenderName
-			recv.read_bool();	// NewYear enderCardDiscarded
-			recv.read_long();	// NewYear DateSent
-			recv.read_int();	// NewYear ReceiverId
-			recv.read_string();	// NewYear ReceiverName
-			recv.read_bool();	// NewYear eceiverCardDiscarded
-			recv.read_bool();	// NewYear eceiverCardReceived
-			recv.read_long();	// NewYear DateReceived
-			recv.read_string();	// NewYear Message
+			recv.skip_int();	// NewYear Id
+			recv.skip_int();	// NewYear SenderId
+			recv.skip_string();	// NewYear SenderName
+			recv.skip_bool();	// NewYear enderCardDiscarded
+			recv.skip_long();	// NewYear DateSent
+			recv.skip_int();	// NewYear ReceiverId
+			recv.skip_string();	// NewYear ReceiverName
+			recv.skip_bool();	// NewYear eceiverCardDiscarded
+			recv.skip_bool();	// NewYear eceiverCardReceived
+			recv.skip_long();	// NewYear DateReceived
+			recv.skip_string();	// NewYear Message
 		}
 	}
 
 	void CharacterParser::parse_areainfo(InPacket& recv)
 	{
-		std::map<int16_t, std::string> areainfo;
 		int16_t arsize = recv.read_short();
 
+		// The area info is not used yet
 		for (int16_t i = 0; i < arsize; i++)
 		{
-			int16_t area = recv.read_short();
-			areainfo[area] = recv.read_string();
+			recv.skip_short();	// Area
+			recv.skip_string();	// Info
 		}
 	}
 }
\ No newline at end of file
@@ -33,8 +33,8 @@ namespace ms
 				// Still need to read the data to keep packet aligned, but handle carefully
 				bool cash = recv.read_bool();
 				if (cash) recv.skip(8);
-				recv.read_long(); // expire
-				recv.read_short(); // count
+				recv.skip_long(); // expire
+				recv.skip_short(); // count
 				
 				// Try to read owner string safely - manual approach for problematic items
 				int16_t string_length = recv.read_short();
@@ -45,7 +45,7 @@ namespace ms
 					return;
 				}
 				
-				recv.read_short(); // flag
+				recv.skip_short(); // flag
 				
 				// Skip adding to inventory for problematic items
 				LOG(LOG_DEBUG, "[ItemParser] Skipped adding problematic item to inventory");
@@ -121,10 +121,13 @@ namespace ms
 			uint8_t level = recv.read_byte();
 
 			// Read equip stats
+			uint16_t statvalues[EquipStat::Id::LENGTH];
+			recv.read_array(statvalues, EquipStat::Id::LENGTH);
+
 			EnumMap<EquipStat::Id, uint16_t> stats;
 
 			for (auto iter : stats)
-				iter.second = recv.read_short();
+				iter.second = statvalues[iter.first];
 
 			// Some more information
 			std::string owner = recv.read_string();
@@ -140,12 +143,12 @@ namespace ms
 			}
 			else
 			{
-				recv.read_byte();
+				recv.skip_byte();
 				itemlevel = recv.read_byte();
-				recv.read_short();
+				recv.skip_short();
 				itemexp = recv.read_short();
 				vicious = recv.read_int();
-				recv.read_long();
+				recv.skip_long();
 			}
 
 			recv.skip(12);
@@ -164,7 +167,7 @@ namespace ms
 			LOG(LOG_DEBUG, "[ItemParser] Starting parse_item for slot " << slot);
 			
 			// Read type and item id
-			recv.read_byte(); // 'type' byte
+			recv.skip_byte(); // 'type' byte
 			int32_t iid = recv.read_int();
 			LOG(LOG_DEBUG, "[ItemParser] Item ID: " << iid << " for slot " << slot);
 
@@ -94,16 +94,19 @@ namespace ms
 			LookEntry look = parse_look(recv);
 
 			// Server writes a 0 byte after look data when !viewall
-			recv.read_byte();
+			recv.skip_byte();
 
-			recv.read_bool(); // 'rankinfo' bool
+			recv.skip_bool(); // 'rankinfo' bool
 
 			if (recv.read_bool())
 			{
-				int32_t currank = recv.read_int();
-				int32_t rankmv = recv.read_int();
-				int32_t curjobrank = recv.read_int();
-				int32_t jobrankmv = recv.read_int();
+				int32_t rankinfo[4];
+				recv.read_array(rankinfo, 4);
+
+				int32_t currank = rankinfo[0];
+				int32_t rankmv = rankinfo[1];
+				int32_t curjobrank = rankinfo[2];
+				int32_t jobrankmv = rankinfo[3];
 				int8_t rankmc = (rankmv > 0) ? '+' : (rankmv < 0) ? '-' : '=';
 				int8_t jobrankmc = (jobrankmv > 0) ? '+' : (jobrankmv < 0) ? '-' : '=';
 
@@ -130,25 +133,28 @@ namespace ms
 		
 		statsentry.female = recv.read_bool();
 
-		recv.read_byte();	// skin
-		recv.read_int();	// face
-		recv.read_int();	// hair
+		recv.skip_byte();	// skin
+		recv.skip_int();	// face
+		recv.skip_int();	// hair
 
-		for (size_t i = 0; i < 3; i++)
-			statsentry.petids.push_back(recv.read_long());
+		statsentry.petids = recv.read_array<int64_t>(3);
 
 		// v83 server writes level as byte, not short
 		statsentry.stats[MapleStat::Id::LEVEL] = recv.read_byte();
-		statsentry.stats[MapleStat::Id::JOB] = recv.read_short();
-		statsentry.stats[MapleStat::Id::STR] = recv.read_short();
-		statsentry.stats[MapleStat::Id::DEX] = recv.read_short();
-		statsentry.stats[MapleStat::Id::INT] = recv.read_short();
-		statsentry.stats[MapleStat::Id::LUK] = recv.read_short();
-		statsentry.stats[MapleStat::Id::HP] = recv.read_short();
-		statsentry.stats[MapleStat::Id::MAXHP] = recv.read_short();
-		statsentry.stats[MapleStat::Id::MP] = recv.read_short();
-		statsentry.stats[MapleStat::Id::MAXMP] = recv.read_short();
-		statsentry.stats[MapleStat::Id::AP] = recv.read_short();
+
+		int16_t stats[10];
+		recv.read_array(stats, 10);
+
+		statsentry.stats[MapleStat::Id::JOB] = stats[0];
+		statsentry.stats[MapleStat::Id::STR] = stats[1];
+		statsentry.stats[MapleStat::Id::DEX] = stats[2];
+		statsentry.stats[MapleStat::Id::INT] = stats[3];
+		statsentry.stats[MapleStat::Id::LUK] = stats[4];
+		statsentry.stats[MapleStat::Id::HP] = stats[5];
+		statsentry.stats[MapleStat::Id::MAXHP] = stats[6];
+		statsentry.stats[MapleStat::Id::MP] = stats[7];
+		statsentry.stats[MapleStat::Id::MAXMP] = stats[8];
+		statsentry.stats[MapleStat::Id::AP] = stats[9];
 		
 		// Handle SP based on job type - v83 compatibility
 		int16_t job = statsentry.stats[MapleStat::Id::JOB];
@@ -156,10 +162,7 @@ namespace ms
 		if (job >= 2200 && job <= 2218) {
 			// Jobs with SP table write: byte(effectiveLength) + pairs of byte(i+1), byte(sp[i])
 			uint8_t sp_count = recv.read_byte();
-			for (uint8_t i = 0; i < sp_count; i++) {
-				recv.read_byte(); // skill book id
-				recv.read_byte(); // remaining sp for this book
-			}
+			recv.skip(sp_count * 2); // pairs of skill book id and remaining sp for this book
 			statsentry.stats[MapleStat::Id::SP] = 0; // Evans don't use regular SP
 		} else {
 			statsentry.stats[MapleStat::Id::SP] = recv.read_short();
@@ -259,10 +262,12 @@ namespace ms
 		// Read the IPv4 address in a string
 		std::string addrstr;
 
+		uint8_t address[4];
+		recv.read_array(address, 4);
+
 		for (size_t i = 0; i < 4; i++)
 		{
-			uint8_t num = static_cast<uint8_t>(recv.read_byte());
-			addrstr.append(std::to_string(num));
+			addrstr.append(std::to_string(address[i]));
 
 			if (i < 3)
 				addrstr.push_back('.');
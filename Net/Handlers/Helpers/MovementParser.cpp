@@ -23,6 +23,7 @@ namespace ms
 	{
 		std::vector<Movement> movements;
 		uint8_t length = recv.read_byte();
+		movements.reserve(length);
 
 		for (uint8_t i = 0; i < length; ++i)
 		{
@@ -34,15 +35,20 @@ namespace ms
 			case 0:
 			case 5:
 			case 17:
+			{
+				int16_t values[5];
+				recv.read_array(values, 5);
+
 				fragment.type = Movement::ABSOLUTE;
-				fragment.xpos = recv.read_short();
-				fragment.ypos = recv.read_short();
-				fragment.lastx = recv.read_short();
-				fragment.lasty = recv.read_short();
-				fragment.fh = recv.read_short();
+				fragment.xpos = values[0];
+				fragment.ypos = values[1];
+				fragment.lastx = values[2];
+				fragment.lasty = values[3];
+				fragment.fh = values[4];
 				fragment.newstate = recv.read_byte();
 				fragment.duration = recv.read_short();
 				break;
+			}
 			case 1:
 			case 2:
 			case 6:
@@ -64,16 +70,20 @@ namespace ms
 				fragment.duration = recv.read_short();
 				break;
 			case 15:
+			{
+				int16_t values[6];
+				recv.read_array(values, 6);
+
 				fragment.type = Movement::JUMPDOWN;
-				fragment.xpos = recv.read_short();
-				fragment.ypos = recv.read_short();
-				fragment.lastx = recv.read_short();
-				fragment.lasty = recv.read_short();
-				recv.skip(2);
-				fragment.fh = recv.read_short();
+				fragment.xpos = values[0];
+				fragment.ypos = values[1];
+				fragment.lastx = values[2];
+				fragment.lasty = values[3];
+				fragment.fh = values[5];
 				fragment.newstate = recv.read_byte();
 				fragment.duration = recv.read_short();
 				break;
+			}
 			case 3:
 			case 4:
 			case 7:
@@ -59,7 +59,22 @@ namespace ms
 				// Only clear and reload if not already in game
 				// UIStateGame may have already loaded the Stage
 				LOG(LOG_DEBUG, "[SetFieldHandler] Loading map " << mapid << " with portal " << (int)portalid);
-				Stage::get().load(mapid, portalid);
+				Stage::get().load_staged(mapid, portalid);
+			},
+			[mapid]()
+			{
+				// The map is loaded over the next frames while the screen stays black
+				if (Stage::get().is_loading())
+					return false;
+
+				// The stage was cleared before the map finished, whatever cleared it takes over the screen
+				if (!Stage::get().is_loaded(mapid))
+				{
+					LOG(LOG_ERROR, "[SetFieldHandler] Map " << mapid << " was cleared before it finished loading");
+
+					return true;
+				}
+
 				LOG(LOG_DEBUG, "[SetFieldHandler] Map loaded successfully");
 
 				// Calling UI::enable()
@@ -81,6 +96,8 @@ namespace ms
 				
 				LOG(LOG_DEBUG, "[SetFieldHandler] Fadeout callback completed successfully");
 				// Fadeout callback completed
+
+				return true;
 			});
 			
 		LOG(LOG_DEBUG, "[SetFieldHandler] Fadeout scheduled");
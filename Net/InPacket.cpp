@@ -17,6 +17,8 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "InPacket.h"
 
+#include <algorithm>
+
 namespace ms
 {
 	InPacket::InPacket(const int8_t* recv, size_t length)
@@ -38,10 +40,7 @@ namespace ms
 
 	void InPacket::skip(size_t count)
 	{
-		if (count > length())
-			throw PacketError("Stack underflow at " + std::to_string(pos));
-
-		pos += count;
+		advance(count);
 	}
 
 	bool InPacket::read_bool()
@@ -86,15 +85,10 @@ namespace ms
 
 	std::string InPacket::read_padded_string(uint16_t count)
 	{
-		std::string ret;
-
-		for (int16_t i = 0; i < count; i++)
-		{
-			char letter = read_byte();
+		const char* begin = reinterpret_cast<const char*>(advance(count));
 
-			if (letter != '\0')
-				ret.push_back(letter);
-		}
+		std::string ret(begin, count);
+		ret.erase(std::remove(ret.begin(), ret.end(), '\0'), ret.end());
 
 		return ret;
 	}
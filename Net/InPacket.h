@@ -22,6 +22,10 @@
 #include "../Template/Point.h"
 
 #include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace ms
 {
@@ -59,6 +63,25 @@ namespace ms
 		// Read a fixed-length string
 		std::string read_padded_string(uint16_t length);
 
+		template <typename T>
+		// Read a number of values of the same type with a single bounds check
+		void read_array(T* values, size_t count)
+		{
+			static_assert(std::is_arithmetic<T>::value, "Only numbers can be read in bulk");
+
+			std::memcpy(values, advance(sizeof(T) * count), sizeof(T) * count);
+		}
+
+		template <typename T>
+		// Read a number of values of the same type with a single bounds check
+		std::vector<T> read_array(size_t count)
+		{
+			std::vector<T> values(count);
+			read_array(values.data(), count);
+
+			return values;
+		}
+
 		// Skip a byte
 		void skip_bool();
 		// Skip a byte
@@ -90,22 +113,27 @@ namespace ms
 		int64_t inspect_long();
 
 	private:
+		// Check that enough bytes are left, return a pointer to them and advance the buffer position
+		const int8_t* advance(size_t count)
+		{
+			if (count > length())
+				throw PacketError("Stack underflow at " + std::to_string(pos));
+
+			const int8_t* begin = bytes + pos;
+			pos += count;
+
+			return begin;
+		}
+
 		template <typename T>
 		// Read a number and advance the buffer position
+		// Packets are little-endian, as are all platforms the client runs on.
 		T read()
 		{
-			size_t count = sizeof(T) / sizeof(int8_t);
-			T all = 0;
-
-			for (size_t i = 0; i < count; i++)
-			{
-				T val = static_cast<uint8_t>(bytes[pos]);
-				all += val << (8 * i);
+			T value;
+			std::memcpy(&value, advance(sizeof(T)), sizeof(T));
 
-				skip(1);
-			}
-
-			return static_cast<T>(all);
+			return value;
 		}
 
 		template <typename T>
@@ -17,6 +17,7 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "OutPacket.h"
 
+#include "PacketPool.h"
 #include "Session.h"
 
 #include "../Configuration.h"
@@ -28,11 +29,41 @@
 
 namespace ms
 {
-	OutPacket::OutPacket(int16_t opc) : opcode(opc)
+	OutPacket::OutPacket(int16_t opc) : bytes(PacketPool::get().acquire(size_hint(opc))), opcode(opc)
 	{
 		write_short(opcode);
 	}
 
+	OutPacket::~OutPacket()
+	{
+		PacketPool::get().release(std::move(bytes));
+	}
+
+	size_t OutPacket::size_hint(int16_t opc)
+	{
+		switch (opc)
+		{
+		case CHANGE_KEYMAP:
+			// Up to 90 keys with 9 bytes each
+			return 1024;
+		case MOVE_PLAYER:
+		case MOVE_MONSTER:
+			// Several movement fragments
+			return 256;
+		case LOGIN:
+		case CLOSE_ATTACK:
+		case RANGED_ATTACK:
+		case MAGIC_ATTACK:
+		case GENERAL_CHAT:
+		case MULTI_CHAT:
+		case SPOUSE_CHAT:
+		case ADMIN_COMMAND:
+			return 128;
+		default:
+			return 32;
+		}
+	}
+
 	void OutPacket::dispatch()
 	{
 		// Always log LOGIN packets for debugging
@@ -60,8 +91,7 @@ namespace ms
 
 	void OutPacket::skip(size_t count)
 	{
-		for (size_t i = 0; i < count; i++)
-			bytes.push_back(0);
+		bytes.insert(bytes.end(), count, 0);
 	}
 
 	void OutPacket::write_byte(int8_t ch)
@@ -29,10 +29,16 @@ namespace ms
 	{
 	public:
 		// Construct a packet by writing its opcode
+		// The buffer is taken from the packet pool, sized for what is usually sent with this opcode.
 		OutPacket(int16_t opcode);
+		// Return the buffer to the packet pool
+		~OutPacket();
 
 		void dispatch();
 
+		// Return the number of bytes usually sent with an opcode
+		static size_t size_hint(int16_t opcode);
+
 		// Opcodes for OutPackets associated with version 83 of the game
 		enum Opcode : uint16_t
 		{
@@ -0,0 +1,194 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "PacketCapture.h"
+
+#include "NetConstants.h"
+
+#include "../Constants.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <thread>
+
+namespace ms
+{
+	namespace
+	{
+		const size_t MAGIC_LENGTH = 4;
+
+		int64_t microseconds(std::chrono::steady_clock::duration duration)
+		{
+			return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+		}
+
+		bool read_varint(const std::vector<int8_t>& data, size_t& pos, uint64_t& value)
+		{
+			value = 0;
+
+			for (uint32_t shift = 0; shift < 64 && pos < data.size(); shift += 7)
+			{
+				uint8_t byte = static_cast<uint8_t>(data[pos++]);
+				value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+				if (!(byte & 0x80))
+					return true;
+			}
+
+			return false;
+		}
+	}
+
+	PacketRecorder::PacketRecorder() : last(0) {}
+
+	bool PacketRecorder::open(const std::string& path)
+	{
+		close();
+
+		file.open(path, std::ios::binary | std::ios::trunc);
+
+		if (!file)
+			return false;
+
+		file.write(PacketReplay::MAGIC, MAGIC_LENGTH);
+		file.put(static_cast<char>(PacketReplay::VERSION));
+
+		start = std::chrono::steady_clock::now();
+		last = 0;
+
+		return true;
+	}
+
+	void PacketRecorder::close()
+	{
+		if (file.is_open())
+			file.close();
+	}
+
+	bool PacketRecorder::is_open() const
+	{
+		return file.is_open();
+	}
+
+	void PacketRecorder::record(const int8_t* bytes, size_t length)
+	{
+		record(bytes, length, microseconds(std::chrono::steady_clock::now() - start));
+	}
+
+	void PacketRecorder::record(const int8_t* bytes, size_t length, int64_t time)
+	{
+		if (!file.is_open())
+			return;
+
+		// Times only increase, so the difference to the previous packet stays small
+		time = std::max(time, last);
+
+		write_varint(time - last);
+		write_varint(length);
+		file.write(reinterpret_cast<const char*>(bytes), length);
+
+		last = time;
+	}
+
+	void PacketRecorder::write_varint(uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			file.put(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+
+		file.put(static_cast<char>(value));
+	}
+
+	bool PacketReplay::load(const std::string& path)
+	{
+		data.clear();
+		packets.clear();
+
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file)
+			return false;
+
+		data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+		if (data.size() < MAGIC_LENGTH + 1 || std::memcmp(data.data(), MAGIC, MAGIC_LENGTH) != 0 || data[MAGIC_LENGTH] != VERSION)
+			return false;
+
+		size_t pos = MAGIC_LENGTH + 1;
+		int64_t time = 0;
+
+		while (pos < data.size())
+		{
+			uint64_t delta;
+			uint64_t length;
+
+			if (!read_varint(data, pos, delta) || !read_varint(data, pos, length))
+				return false;
+
+			if (length > MAX_PACKET_LENGTH || length > data.size() - pos)
+				return false;
+
+			time += delta;
+			packets.push_back({ time, data.data() + pos, static_cast<size_t>(length) });
+			pos += length;
+		}
+
+		return true;
+	}
+
+	const std::vector<PacketReplay::Packet>& PacketReplay::get_packets() const
+	{
+		return packets;
+	}
+
+	PacketReplay::Result PacketReplay::run(std::function<void(const int8_t*, size_t)> forward, std::function<void()> update, Speed speed) const
+	{
+		const int64_t timestep = Constants::TIMESTEP * 1000;
+
+		Result result = {};
+		auto start = std::chrono::steady_clock::now();
+
+		while (result.packets < packets.size())
+		{
+			if (speed == Speed::REALTIME)
+				std::this_thread::sleep_until(start + std::chrono::microseconds(result.updates * timestep));
+
+			auto before = std::chrono::steady_clock::now();
+
+			update();
+			result.updates++;
+
+			// Everything which arrived before the end of this timestep is read after its update
+			int64_t until = result.updates * timestep;
+
+			for (; result.packets < packets.size() && packets[result.packets].time < until; result.packets++)
+				forward(packets[result.packets].bytes, packets[result.packets].length);
+
+			int64_t busy = microseconds(std::chrono::steady_clock::now() - before);
+
+			result.busy += busy;
+			result.slowest = std::max(result.slowest, busy);
+		}
+
+		result.elapsed = microseconds(std::chrono::steady_clock::now() - start);
+
+		return result;
+	}
+}
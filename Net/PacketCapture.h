@@ -0,0 +1,107 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ms
+{
+	// Writes decrypted packets and the time they arrived to a capture file
+	// The file starts with "MSPC" and a version byte. Each packet follows as the microseconds since
+	// the previous packet and its length, both as variable length integers, and then its bytes.
+	class PacketRecorder
+	{
+	public:
+		PacketRecorder();
+
+		// Start a new capture file, return whether it could be created
+		bool open(const std::string& path);
+		// Finish the capture file
+		void close();
+		// Return whether packets are being recorded
+		bool is_open() const;
+
+		// Record a packet which arrived just now
+		void record(const int8_t* bytes, size_t length);
+		// Record a packet with the microseconds since the start of the capture
+		void record(const int8_t* bytes, size_t length, int64_t time);
+
+	private:
+		void write_varint(uint64_t value);
+
+		std::ofstream file;
+		std::chrono::steady_clock::time_point start;
+		int64_t last;
+	};
+
+	// Feeds a capture file back into the game
+	class PacketReplay
+	{
+	public:
+		// A recorded packet, time is in microseconds since the start of the capture
+		struct Packet
+		{
+			int64_t time;
+			const int8_t* bytes;
+			size_t length;
+		};
+
+		enum class Speed
+		{
+			// Wait between updates like the game loop does
+			REALTIME,
+			// Run the updates back to back
+			FAST
+		};
+
+		struct Result
+		{
+			size_t packets;
+			size_t updates;
+			// Time spent in updates and handlers, in microseconds
+			int64_t busy;
+			// Longest time spent on a single update and its packets, in microseconds
+			int64_t slowest;
+			// Time from start to finish, in microseconds
+			int64_t elapsed;
+		};
+
+		// Load a capture file, return whether it is valid
+		bool load(const std::string& path);
+
+		// Return all packets of the capture
+		const std::vector<Packet>& get_packets() const;
+
+		// Replay the capture with one call to update per timestep
+		// Packets are forwarded after the update of the timestep they arrived in, as Session::read does.
+		// Which update a packet follows only depends on its recorded time, so runs are reproducible.
+		Result run(std::function<void(const int8_t*, size_t)> forward, std::function<void()> update, Speed speed) const;
+
+		static constexpr const char* MAGIC = "MSPC";
+		static constexpr uint8_t VERSION = 1;
+
+	private:
+		std::vector<int8_t> data;
+		std::vector<Packet> packets;
+	};
+}
@@ -0,0 +1,58 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "PacketPool.h"
+
+#include <algorithm>
+
+namespace ms
+{
+	PacketPool::PacketPool()
+	{
+		buffers.reserve(MAX_BUFFERS);
+	}
+
+	std::vector<int8_t> PacketPool::acquire(size_t hint)
+	{
+		std::vector<int8_t> buffer;
+
+		if (!buffers.empty())
+		{
+			buffer = std::move(buffers.back());
+			buffers.pop_back();
+		}
+
+		// Only a buffer which has never been used, or a packet larger than any before, needs memory here
+		buffer.reserve(std::max(hint, MIN_CAPACITY));
+
+		return buffer;
+	}
+
+	void PacketPool::release(std::vector<int8_t>&& buffer)
+	{
+		if (buffer.capacity() == 0 || buffers.size() == MAX_BUFFERS)
+			return;
+
+		buffer.clear();
+		buffers.push_back(std::move(buffer));
+	}
+
+	size_t PacketPool::available() const
+	{
+		return buffers.size();
+	}
+}
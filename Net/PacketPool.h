@@ -0,0 +1,50 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "../Template/Singleton.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ms
+{
+	// Keeps the buffers of sent packets so new packets can reuse their memory
+	// Packets are only built on the main thread, so the pool is not synchronized.
+	class PacketPool : public Singleton<PacketPool>
+	{
+	public:
+		PacketPool();
+
+		// Return an empty buffer with room for at least the given number of bytes
+		std::vector<int8_t> acquire(size_t hint);
+		// Take back a buffer which is no longer needed
+		void release(std::vector<int8_t>&& buffer);
+
+		// Return the number of buffers which are ready to be reused
+		size_t available() const;
+
+	private:
+		// More packets than this are rarely alive at once, buffers beyond it are freed
+		static constexpr size_t MAX_BUFFERS = 64;
+		// The smallest buffer handed out, enough for most packets
+		static constexpr size_t MIN_CAPACITY = 64;
+
+		std::vector<std::vector<int8_t>> buffers;
+	};
+}
@@ -17,8 +17,6 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "PacketSwitch.h"
 
-#include <chrono>
-
 #include "Handlers/AttackHandlers.h"
 #include "Handlers/CashShopHandlers.h"
 #include "Handlers/CommonHandlers.h"
@@ -35,191 +33,389 @@
 #include "../Configuration.h"
 #include "../Util/Misc.h"
 
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+
 namespace ms
 {
-	// Opcodes for InPackets
-	enum Opcode : uint16_t
+	namespace
 	{
-		/// Login 1
-		LOGIN_RESULT = 0,
-		SERVERSTATUS = 3,
-		SELECT_CHARACTER_BY_VAC = 9,
-		SERVERLIST = 10,
-		CHARLIST = 11,
-		SERVER_IP = 12,
-		CHARNAME_RESPONSE = 13,
-		ADD_NEWCHAR_ENTRY = 14,
-		DELCHAR_RESPONSE = 15,
-		PING = 17,
-
-		/// Login 2
-		CHECK_SPW_RESULT = 28,
-
-		/// Inventory 1
-		MODIFY_INVENTORY = 29,
-
-		/// Player 2
-		CHANGE_CHANNEL = 16,
-		CHANGE_STATS = 31,
-		GIVE_BUFF = 32,
-		CANCEL_BUFF = 33,
-		RECALCULATE_STATS = 35,
-		UPDATE_SKILL = 36,
-
-		/// Messaging 1
-		SHOW_STATUS_INFO = 39,
-
-		/// Inventory 2
-		GATHER_RESULT = 52,
-		SORT_RESULT = 53,
-
-		/// Player 3
-
-		/// Messaging 2
-		SERVER_MESSAGE = 68,
-		WEEK_EVENT_MESSAGE = 77,
-
-		SKILL_MACROS = 124,
-		SET_FIELD = 125,
-		FIELD_EFFECT = 138,
-
-		/// MapObject
-		SPAWN_CHAR = 160,
-		REMOVE_CHAR = 161,
-
-		/// Messaging
-		CHAT_RECEIVED = 162,
-		SCROLL_RESULT = 167,
-
-		/// MapObject
-		SPAWN_PET = 168,
-		CHAR_MOVED = 185,
-
-		/// Attack
-		ATTACKED_CLOSE = 186,
-		ATTACKED_RANGED = 187,
-		ATTACKED_MAGIC = 188,
-
-		UPDATE_CHARLOOK = 197,
-		SHOW_FOREIGN_EFFECT = 198,
-		SHOW_ITEM_GAIN_INCHAT = 206, // TODO: Rename this (Terribly named)
-
-		/// Player
-		ADD_COOLDOWN = 234,
-
-		/// MapObject
-		SPAWN_MOB = 236,
-		KILL_MOB = 237,
-		SPAWN_MOB_C = 238,
-		MOB_MOVED = 239,
-		APPLY_MONSTER_STATUS = 242,
-		SHOW_MOB_HP = 250,
-		SPAWN_NPC = 257,
-		SPAWN_NPC_C = 259,
-		DROP_LOOT = 268,
-		REMOVE_LOOT = 269,
-		HIT_REACTOR = 277,
-		SPAWN_REACTOR = 279,
-		REMOVE_REACTOR = 280,
-
-		/// NPC Interaction
-		NPC_DIALOGUE = 304,
-		OPEN_NPC_SHOP = 305,
-		CONFIRM_SHOP_TRANSACTION = 306,
-		KEYMAP = 335,
-
-		/// Player Interaction
-		CHAR_INFO = 61,
-
-		/// Cash Shop
-		SET_CASH_SHOP = 127
-	};
+		// Handle a packet with a handler of type T
+		// Handlers have no state, so a single instance is created on first use.
+		template <typename T>
+		void handle(InPacket& recv)
+		{
+			static_assert(std::is_base_of<PacketHandler, T>::value, "Error: Packet handlers must derive from PacketHandler");
+
+			static const T handler{};
+			static_cast<const PacketHandler&>(handler).handle(recv);
+		}
+
+		struct Registration
+		{
+			uint16_t opcode;
+			const char* name;
+			// Opcodes which are only named have no handler
+			PacketSwitch::Handler handler = nullptr;
+		};
+
+		// Opcodes of InPackets associated with version 83 of the game
+		// This is the only place where opcodes are named and handlers are registered.
+		constexpr Registration REGISTRY[] =
+		{
+			{ 0, "LOGIN_STATUS", handle<LoginResultHandler> },
+			{ 1, "GUEST_ID_LOGIN" },
+			{ 2, "ACCOUNT_INFO" },
+			{ 3, "SERVERSTATUS", handle<ServerStatusHandler> },
+			{ 4, "GENDER_DONE" },
+			{ 5, "CONFIRM_EULA_RESULT" },
+			{ 6, "CHECK_PINCODE" },
+			{ 7, "UPDATE_PINCODE" },
+			{ 8, "VIEW_ALL_CHAR" },
+			{ 9, "SELECT_CHARACTER_BY_VAC", handle<SelectCharacterHandler> },
+			{ 10, "SERVERLIST", handle<ServerlistHandler> },
+			{ 11, "CHARLIST", handle<CharlistHandler> },
+			{ 12, "SERVER_IP", handle<ServerIPHandler> },
+			{ 13, "CHAR_NAME_RESPONSE", handle<CharnameResponseHandler> },
+			{ 14, "ADD_NEW_CHAR_ENTRY", handle<AddNewCharEntryHandler> },
+			{ 15, "DELETE_CHAR_RESPONSE", handle<DeleteCharResponseHandler> },
+			{ 16, "CHANGE_CHANNEL", handle<ChangeChannelHandler> },
+			{ 17, "PING", handle<PingHandler> },
+			{ 18, "KOREAN_INTERNET_CAFE_SHIT" },
+			{ 20, "CHANNEL_SELECTED" },
+			{ 21, "HACKSHIELD_REQUEST" },
+			{ 22, "RELOG_RESPONSE" },
+			{ 25, "CHECK_CRC_RESULT" },
+			{ 26, "LAST_CONNECTED_WORLD" },
+			{ 27, "RECOMMENDED_WORLD_MESSAGE" },
+			{ 28, "CHECK_SPW_RESULT", handle<CheckSpwResultHandler> },
+			{ 29, "INVENTORY_OPERATION", handle<ModifyInventoryHandler> },
+			{ 30, "INVENTORY_GROW" },
+			{ 31, "STAT_CHANGED", handle<ChangeStatsHandler> },
+			{ 32, "GIVE_BUFF", handle<ApplyBuffHandler> },
+			{ 33, "CANCEL_BUFF", handle<CancelBuffHandler> },
+			{ 34, "FORCED_STAT_SET" },
+			{ 35, "FORCED_STAT_RESET", handle<RecalculateStatsHandler> },
+			{ 36, "UPDATE_SKILLS", handle<UpdateSkillHandler> },
+			{ 37, "SKILL_USE_RESULT" },
+			{ 38, "FAME_RESPONSE" },
+			{ 39, "SHOW_STATUS_INFO", handle<ShowStatusInfoHandler> },
+			{ 40, "OPEN_FULL_CLIENT_DOWNLOAD_LINK" },
+			{ 41, "MEMO_RESULT" },
+			{ 42, "MAP_TRANSFER_RESULT" },
+			{ 43, "WEDDING_PHOTO" },
+			{ 45, "CLAIM_RESULT" },
+			{ 46, "CLAIM_AVAILABLE_TIME" },
+			{ 47, "CLAIM_STATUS_CHANGED" },
+			{ 48, "SET_TAMING_MOB_INFO" },
+			{ 49, "QUEST_CLEAR" },
+			{ 50, "ENTRUSTED_SHOP_CHECK_RESULT" },
+			{ 51, "SKILL_LEARN_ITEM_RESULT" },
+			{ 52, "GATHER_ITEM_RESULT", handle<GatherResultHandler> },
+			{ 53, "SORT_ITEM_RESULT", handle<SortResultHandler> },
+			{ 55, "SUE_CHARACTER_RESULT" },
+			{ 57, "TRADE_MONEY_LIMIT" },
+			{ 58, "SET_GENDER" },
+			{ 59, "GUILD_BBS_PACKET" },
+			{ 61, "CHAR_INFO", handle<CharInfoHandler> },
+			{ 62, "PARTY_OPERATION" },
+			{ 63, "BUDDYLIST" },
+			{ 65, "GUILD_OPERATION" },
+			{ 66, "ALLIANCE_OPERATION" },
+			{ 67, "SPAWN_PORTAL" },
+			{ 68, "SERVERMESSAGE", handle<ServerMessageHandler> },
+			{ 69, "INCUBATOR_RESULT" },
+			{ 70, "SHOP_SCANNER_RESULT" },
+			{ 71, "SHOP_LINK_RESULT" },
+			{ 72, "MARRIAGE_REQUEST" },
+			{ 73, "MARRIAGE_RESULT" },
+			{ 74, "WEDDING_GIFT_RESULT" },
+			{ 75, "NOTIFY_MARRIED_PARTNER_MAP_TRANSFER" },
+			{ 76, "CASH_PET_FOOD_RESULT" },
+			{ 77, "SET_WEEK_EVENT_MESSAGE", handle<WeekEventMessageHandler> },
+			{ 78, "SET_POTION_DISCOUNT_RATE" },
+			{ 79, "BRIDLE_MOB_CATCH_FAIL" },
+			{ 80, "IMITATED_NPC_RESULT" },
+			{ 81, "IMITATED_NPC_DATA" },
+			{ 82, "LIMITED_NPC_DISABLE_INFO" },
+			{ 83, "MONSTER_BOOK_SET_CARD" },
+			{ 84, "MONSTER_BOOK_SET_COVER" },
+			{ 85, "HOUR_CHANGED" },
+			{ 86, "MINIMAP_ON_OFF" },
+			{ 87, "CONSULT_AUTHKEY_UPDATE" },
+			{ 88, "CLASS_COMPETITION_AUTHKEY_UPDATE" },
+			{ 89, "WEB_BOARD_AUTHKEY_UPDATE" },
+			{ 90, "SESSION_VALUE" },
+			{ 91, "PARTY_VALUE" },
+			{ 92, "FIELD_SET_VARIABLE" },
+			{ 93, "BONUS_EXP_CHANGED" },
+			{ 94, "FAMILY_CHART_RESULT" },
+			{ 95, "FAMILY_INFO_RESULT" },
+			{ 96, "FAMILY_RESULT" },
+			{ 97, "FAMILY_JOIN_REQUEST" },
+			{ 98, "FAMILY_JOIN_REQUEST_RESULT" },
+			{ 99, "FAMILY_JOIN_ACCEPTED" },
+			{ 100, "FAMILY_PRIVILEGE_LIST" },
+			{ 101, "FAMILY_FAMOUS_POINT_INC_RESULT" },
+			{ 102, "FAMILY_NOTIFY_LOGIN_OR_LOGOUT" },
+			{ 103, "FAMILY_SET_PRIVILEGE" },
+			{ 104, "FAMILY_SUMMON_REQUEST" },
+			{ 105, "NOTIFY_LEVELUP" },
+			{ 106, "NOTIFY_MARRIAGE" },
+			{ 107, "NOTIFY_JOB_CHANGE" },
+			{ 108, "SET_BUY_EQUIP_EXT" },
+			{ 109, "MAPLE_TV_USE_RES" },
+			{ 110, "AVATAR_MEGAPHONE_RESULT" },
+			{ 111, "SET_AVATAR_MEGAPHONE" },
+			{ 112, "CLEAR_AVATAR_MEGAPHONE" },
+			{ 113, "CANCEL_NAME_CHANGE_RESULT" },
+			{ 114, "CANCEL_TRANSFER_WORLD_RESULT" },
+			{ 115, "DESTROY_SHOP_RESULT" },
+			{ 116, "FAKE_GM_NOTICE" },
+			{ 117, "SUCCESS_IN_USE_GACHAPON_BOX" },
+			{ 118, "NEW_YEAR_CARD_RES" },
+			{ 119, "RANDOM_MORPH_RES" },
+			{ 120, "CANCEL_NAME_CHANGE_BY_OTHER" },
+			{ 121, "SET_EXTRA_PENDANT_SLOT" },
+			{ 122, "SCRIPT_PROGRESS_MESSAGE" },
+			{ 123, "DATA_CRC_CHECK_FAILED" },
+			{ 124, "MACRO_SYS_DATA_INIT", handle<SkillMacrosHandler> },
+			{ 125, "SET_FIELD", handle<SetFieldHandler> },
+			{ 126, "SET_ITC" },
+			{ 127, "SET_CASH_SHOP", handle<SetCashShopHandler> },
+			{ 128, "SET_BACK_EFFECT" },
+			{ 129, "SET_MAP_OBJECT_VISIBLE" },
+			{ 130, "CLEAR_BACK_EFFECT" },
+			{ 131, "BLOCKED_MAP" },
+			{ 132, "BLOCKED_SERVER" },
+			{ 133, "FORCED_MAP_EQUIP" },
+			{ 134, "MULTICHAT" },
+			{ 135, "WHISPER" },
+			{ 136, "SPOUSE_CHAT" },
+			{ 137, "SUMMON_ITEM_INAVAILABLE" },
+			{ 138, "FIELD_EFFECT", handle<FieldEffectHandler> },
+			{ 139, "FIELD_OBSTACLE_ONOFF" },
+			{ 140, "FIELD_OBSTACLE_ONOFF_LIST" },
+			{ 141, "FIELD_OBSTACLE_ALL_RESET" },
+			{ 142, "BLOW_WEATHER" },
+			{ 143, "PLAY_JUKEBOX" },
+			{ 144, "ADMIN_RESULT" },
+			{ 145, "OX_QUIZ" },
+			{ 146, "GMEVENT_INSTRUCTIONS" },
+			{ 147, "CLOCK" },
+			{ 148, "CONTI_MOVE" },
+			{ 149, "CONTI_STATE" },
+			{ 150, "SET_QUEST_CLEAR" },
+			{ 151, "SET_QUEST_TIME" },
+			{ 152, "WARN_MESSAGE" },
+			{ 153, "SET_OBJECT_STATE" },
+			{ 154, "STOP_CLOCK" },
+			{ 155, "ARIANT_ARENA_SHOW_RESULT" },
+			{ 157, "PYRAMID_GAUGE" },
+			{ 158, "PYRAMID_SCORE" },
+			{ 160, "SPAWN_PLAYER", handle<SpawnCharHandler> },
+			{ 161, "REMOVE_PLAYER_FROM_MAP", handle<RemoveCharHandler> },
+			{ 162, "CHATTEXT", handle<ChatReceivedHandler> },
+			{ 163, "CHATTEXT1" },
+			{ 164, "CHALKBOARD" },
+			{ 165, "UPDATE_CHAR_BOX" },
+			{ 166, "SHOW_CONSUME_EFFECT" },
+			{ 167, "SHOW_SCROLL_EFFECT", handle<ScrollResultHandler> },
+			{ 168, "SPAWN_PET", handle<SpawnPetHandler> },
+			{ 170, "MOVE_PET" },
+			{ 171, "PET_CHAT" },
+			{ 172, "PET_NAMECHANGE" },
+			{ 173, "PET_EXCEPTION_LIST" },
+			{ 174, "PET_COMMAND" },
+			{ 175, "SPAWN_SPECIAL_MAPOBJECT" },
+			{ 176, "REMOVE_SPECIAL_MAPOBJECT" },
+			{ 177, "MOVE_SUMMON" },
+			{ 178, "SUMMON_ATTACK" },
+			{ 179, "DAMAGE_SUMMON" },
+			{ 180, "SUMMON_SKILL" },
+			{ 181, "SPAWN_DRAGON" },
+			{ 182, "MOVE_DRAGON" },
+			{ 183, "REMOVE_DRAGON" },
+			{ 185, "MOVE_PLAYER", handle<CharMovedHandler> },
+			{ 186, "CLOSE_RANGE_ATTACK", handle<CloseAttackHandler> },
+			{ 187, "RANGED_ATTACK", handle<RangedAttackHandler> },
+			{ 188, "MAGIC_ATTACK", handle<MagicAttackHandler> },
+			{ 189, "ENERGY_ATTACK" },
+			{ 190, "SKILL_EFFECT" },
+			{ 191, "CANCEL_SKILL_EFFECT" },
+			{ 192, "DAMAGE_PLAYER" },
+			{ 193, "FACIAL_EXPRESSION" },
+			{ 194, "SHOW_ITEM_EFFECT" },
+			{ 196, "SHOW_CHAIR" },
+			{ 197, "UPDATE_CHAR_LOOK", handle<UpdateCharLookHandler> },
+			{ 198, "SHOW_FOREIGN_EFFECT", handle<ShowForeignEffectHandler> },
+			{ 199, "GIVE_FOREIGN_BUFF" },
+			{ 200, "CANCEL_FOREIGN_BUFF" },
+			{ 201, "UPDATE_PARTYMEMBER_HP" },
+			{ 202, "GUILD_NAME_CHANGED" },
+			{ 203, "GUILD_MARK_CHANGED" },
+			{ 204, "THROW_GRENADE" },
+			{ 205, "CANCEL_CHAIR" },
+			{ 206, "SHOW_ITEM_GAIN_INCHAT", handle<ShowItemGainInChatHandler> },
+			{ 207, "DOJO_WARP_UP" },
+			{ 208, "LUCKSACK_PASS" },
+			{ 209, "LUCKSACK_FAIL" },
+			{ 210, "MESO_BAG_MESSAGE" },
+			{ 211, "UPDATE_QUEST_INFO" },
+			{ 214, "PLAYER_HINT" },
+			{ 219, "KOREAN_EVENT" },
+			{ 220, "OPEN_UI" },
+			{ 221, "LOCK_UI" },
+			{ 222, "DISABLE_UI" },
+			{ 223, "SPAWN_GUIDE" },
+			{ 224, "TALK_GUIDE" },
+			{ 225, "SHOW_COMBO" },
+			{ 234, "COOLDOWN", handle<AddCooldownHandler> },
+			{ 236, "SPAWN_MONSTER", handle<SpawnMobHandler> },
+			{ 237, "KILL_MONSTER", handle<KillMobHandler> },
+			{ 238, "SPAWN_MONSTER_CONTROL", handle<SpawnMobControllerHandler> },
+			{ 239, "MOVE_MONSTER", handle<MobMovedHandler> },
+			{ 240, "MOVE_MONSTER_RESPONSE" },
+			{ 242, "APPLY_MONSTER_STATUS", handle<ApplyMonsterStatusHandler> },
+			{ 243, "CANCEL_MONSTER_STATUS" },
+			{ 244, "RESET_MONSTER_ANIMATION" },
+			{ 246, "DAMAGE_MONSTER" },
+			{ 249, "ARIANT_THING" },
+			{ 250, "SHOW_MONSTER_HP", handle<ShowMobHpHandler> },
+			{ 251, "CATCH_MONSTER" },
+			{ 252, "CATCH_MONSTER_WITH_ITEM" },
+			{ 253, "SHOW_MAGNET" },
+			{ 257, "SPAWN_NPC", handle<SpawnNpcHandler> },
+			{ 258, "REMOVE_NPC" },
+			{ 259, "SPAWN_NPC_REQUEST_CONTROLLER", handle<SpawnNpcControllerHandler> },
+			{ 260, "NPC_ACTION" },
+			{ 265, "SPAWN_HIRED_MERCHANT" },
+			{ 266, "DESTROY_HIRED_MERCHANT" },
+			{ 267, "UPDATE_HIRED_MERCHANT" },
+			{ 268, "DROP_ITEM_FROM_MAPOBJECT", handle<DropLootHandler> },
+			{ 269, "REMOVE_ITEM_FROM_MAP", handle<RemoveLootHandler> },
+			{ 270, "CANNOT_SPAWN_KITE" },
+			{ 271, "SPAWN_KITE" },
+			{ 272, "REMOVE_KITE" },
+			{ 273, "SPAWN_MIST" },
+			{ 274, "REMOVE_MIST" },
+			{ 275, "SPAWN_DOOR" },
+			{ 276, "REMOVE_DOOR" },
+			{ 277, "REACTOR_HIT", handle<HitReactorHandler> },
+			{ 279, "REACTOR_SPAWN", handle<SpawnReactorHandler> },
+			{ 280, "REACTOR_DESTROY", handle<RemoveReactorHandler> },
+			{ 281, "SNOWBALL_STATE" },
+			{ 282, "HIT_SNOWBALL" },
+			{ 283, "SNOWBALL_MESSAGE" },
+			{ 284, "LEFT_KNOCK_BACK" },
+			{ 285, "COCONUT_HIT" },
+			{ 286, "COCONUT_SCORE" },
+			{ 287, "GUILD_BOSS_HEALER_MOVE" },
+			{ 288, "GUILD_BOSS_PULLEY_STATE_CHANGE" },
+			{ 289, "MONSTER_CARNIVAL_START" },
+			{ 290, "MONSTER_CARNIVAL_OBTAINED_CP" },
+			{ 291, "MONSTER_CARNIVAL_PARTY_CP" },
+			{ 292, "MONSTER_CARNIVAL_SUMMON" },
+			{ 293, "MONSTER_CARNIVAL_MESSAGE" },
+			{ 294, "MONSTER_CARNIVAL_DIED" },
+			{ 295, "MONSTER_CARNIVAL_LEAVE" },
+			{ 297, "ARIANT_ARENA_USER_SCORE" },
+			{ 299, "SHEEP_RANCH_INFO" },
+			{ 300, "SHEEP_RANCH_CLOTHES" },
+			{ 301, "ARIANT_SCORE" },
+			{ 302, "HORNTAIL_CAVE" },
+			{ 303, "ZAKUM_SHRINE" },
+			{ 304, "NPC_TALK", handle<NpcDialogueHandler> },
+			{ 305, "OPEN_NPC_SHOP", handle<OpenNpcShopHandler> },
+			{ 306, "CONFIRM_SHOP_TRANSACTION" },
+			{ 307, "ADMIN_SHOP_MESSAGE" },
+			{ 308, "ADMIN_SHOP" },
+			{ 309, "STORAGE" },
+			{ 310, "FREDRICK_MESSAGE" },
+			{ 311, "FREDRICK" },
+			{ 312, "RPS_GAME" },
+			{ 313, "MESSENGER" },
+			{ 314, "PLAYER_INTERACTION" },
+			{ 315, "TOURNAMENT" },
+			{ 316, "TOURNAMENT_MATCH_TABLE" },
+			{ 317, "TOURNAMENT_SET_PRIZE" },
+			{ 318, "TOURNAMENT_UEW" },
+			{ 319, "TOURNAMENT_CHARACTERS" },
+			{ 320, "WEDDING_PROGRESS" },
+			{ 321, "WEDDING_CEREMONY_END" },
+			{ 322, "PARCEL" },
+			{ 323, "CHARGE_PARAM_RESULT" },
+			{ 324, "QUERY_CASH_RESULT" },
+			{ 325, "CASHSHOP_OPERATION" },
+			{ 327, "CASHSHOP_GIFT_INFO_RESULT" },
+			{ 328, "CASHSHOP_CHECK_NAME_CHANGE" },
+			{ 329, "CASHSHOP_CHECK_NAME_CHANGE_POSSIBLE_RESULT" },
+			{ 330, "CASHSHOP_REGISTER_NEW_CHARACTER_RESULT" },
+			{ 331, "CASHSHOP_CHECK_TRANSFER_WORLD_POSSIBLE_RESULT" },
+			{ 332, "CASHSHOP_GACHAPON_STAMP_RESULT" },
+			{ 333, "CASHSHOP_CASH_ITEM_GACHAPON_RESULT" },
+			{ 334, "CASHSHOP_CASH_GACHAPON_OPEN_RESULT" },
+			{ 335, "KEYMAP", handle<KeymapHandler> },
+			{ 336, "AUTO_HP_POT" },
+			{ 337, "AUTO_MP_POT" },
+			{ 341, "SEND_TV" },
+			{ 342, "REMOVE_TV" },
+			{ 343, "ENABLE_TV" },
+			{ 347, "MTS_OPERATION2" },
+			{ 348, "MTS_OPERATION" },
+			{ 349, "MAPLELIFE_RESULT" },
+			{ 350, "MAPLELIFE_ERROR" },
+			{ 354, "VICIOUS_HAMMER" },
+			{ 358, "VEGA_SCROLL" }
+		};
+
+		struct Entry
+		{
+			const char* name;
+			// Opcodes which are only named have no handler
+			PacketSwitch::Handler handler = nullptr;
+		};
+
+		struct Table
+		{
+			Entry entries[PacketSwitch::NUM_HANDLERS];
+			bool valid;
+		};
+
+		// Arrange the registry by opcode, so forwarding a packet is a single lookup
+		constexpr Table create_table()
+		{
+			Table table = {};
+			table.valid = true;
+
+			for (const Registration& registration : REGISTRY)
+			{
+				if (registration.opcode >= PacketSwitch::NUM_HANDLERS || table.entries[registration.opcode].name)
+				{
+					table.valid = false;
+				}
+				else
+				{
+					table.entries[registration.opcode] = { registration.name, registration.handler };
+				}
+			}
+
+			return table;
+		}
+
+		constexpr Table TABLE = create_table();
+
+		static_assert(TABLE.valid, "PacketSwitch - Opcodes must be registered once and be smaller than NUM_HANDLERS");
+	}
 
 	PacketSwitch::PacketSwitch()
 	{
-		// Common handlers
-		emplace<PING, PingHandler>();
-
-		// Login handlers
-		emplace<LOGIN_RESULT, LoginResultHandler>();
-		emplace<SERVERSTATUS, ServerStatusHandler>();
-		emplace<SELECT_CHARACTER_BY_VAC, SelectCharacterHandler>();
-		emplace<SERVERLIST, ServerlistHandler>();
-		emplace<CHARLIST, CharlistHandler>();
-		emplace<SERVER_IP, ServerIPHandler>();
-		emplace<CHARNAME_RESPONSE, CharnameResponseHandler>();
-		emplace<ADD_NEWCHAR_ENTRY, AddNewCharEntryHandler>();
-		emplace<DELCHAR_RESPONSE, DeleteCharResponseHandler>();
-
-		// SetField handlers
-		emplace<SET_FIELD, SetFieldHandler>();
-
-		// MapObject handlers
-		emplace<SPAWN_CHAR, SpawnCharHandler>();
-		emplace<CHAR_MOVED, CharMovedHandler>();
-		emplace<UPDATE_CHARLOOK, UpdateCharLookHandler>();
-		emplace<SHOW_FOREIGN_EFFECT, ShowForeignEffectHandler>();
-		emplace<REMOVE_CHAR, RemoveCharHandler>();
-		emplace<SPAWN_PET, SpawnPetHandler>();
-		emplace<SPAWN_NPC, SpawnNpcHandler>();
-		emplace<SPAWN_NPC_C, SpawnNpcControllerHandler>();
-		emplace<SPAWN_MOB, SpawnMobHandler>();
-		emplace<SPAWN_MOB_C, SpawnMobControllerHandler>();
-		emplace<MOB_MOVED, MobMovedHandler>();
-		emplace<SHOW_MOB_HP, ShowMobHpHandler>();
-		emplace<KILL_MOB, KillMobHandler>();
-		emplace<APPLY_MONSTER_STATUS, ApplyMonsterStatusHandler>();
-		emplace<DROP_LOOT, DropLootHandler>();
-		emplace<REMOVE_LOOT, RemoveLootHandler>();
-		emplace<HIT_REACTOR, HitReactorHandler>();
-		emplace<SPAWN_REACTOR, SpawnReactorHandler>();
-		emplace<REMOVE_REACTOR, RemoveReactorHandler>();
-
-		// Attack handlers
-		emplace<ATTACKED_CLOSE, CloseAttackHandler>();
-		emplace<ATTACKED_RANGED, RangedAttackHandler>();
-		emplace<ATTACKED_MAGIC, MagicAttackHandler>();
-
-		// Player handlers
-		emplace<CHANGE_CHANNEL, ChangeChannelHandler>();
-		emplace<KEYMAP, KeymapHandler>();
-		emplace<SKILL_MACROS, SkillMacrosHandler>();
-		emplace<CHANGE_STATS, ChangeStatsHandler>();
-		emplace<GIVE_BUFF, ApplyBuffHandler>();
-		emplace<CANCEL_BUFF, CancelBuffHandler>();
-		emplace<RECALCULATE_STATS, RecalculateStatsHandler>();
-		emplace<UPDATE_SKILL, UpdateSkillHandler>();
-		emplace<ADD_COOLDOWN, AddCooldownHandler>();
-
-		// Messaging handlers
-		emplace<SHOW_STATUS_INFO, ShowStatusInfoHandler>();
-		emplace<CHAT_RECEIVED, ChatReceivedHandler>();
-		emplace<SCROLL_RESULT, ScrollResultHandler>();
-		emplace<SERVER_MESSAGE, ServerMessageHandler>();
-		emplace<WEEK_EVENT_MESSAGE, WeekEventMessageHandler>();
-		emplace<SHOW_ITEM_GAIN_INCHAT, ShowItemGainInChatHandler>();
-
-		// Inventory Handlers
-		emplace<MODIFY_INVENTORY, ModifyInventoryHandler>();
-		emplace<GATHER_RESULT, GatherResultHandler>();
-		emplace<SORT_RESULT, SortResultHandler>();
-
-		// NPC Interaction Handlers
-		emplace<NPC_DIALOGUE, NpcDialogueHandler>();
-		emplace<OPEN_NPC_SHOP, OpenNpcShopHandler>();
-
-		// Player Interaction
-		emplace<CHAR_INFO, CharInfoHandler>();
-
-		// Cash Shop
-		emplace<SET_CASH_SHOP, SetCashShopHandler>();
-
-		// TODO: New handlers, they need coded and moved to a proper file.
-		emplace<CHECK_SPW_RESULT, CheckSpwResultHandler>();
-		emplace<FIELD_EFFECT, FieldEffectHandler>();
+		reset_profile();
 	}
 
-	void PacketSwitch::forward(const int8_t* bytes, size_t length) const
+	void PacketSwitch::forward(const int8_t* bytes, size_t length)
 	{
 		// Wrap the bytes with a parser
 		InPacket recv = { bytes, length };
@@ -227,20 +423,22 @@ namespace ms
 		// Read the opcode to determine handler responsible
 		uint16_t opcode = recv.read_short();
 
-		// Debug log received packets
-		
-
 		bool opcode_error = false;
 
 		if (opcode < NUM_HANDLERS)
 		{
-			if (auto& handler = handlers[opcode])
+			Profile& profile = profiles[opcode];
+			profile.count++;
+			profile.bytes += length;
+
+			if (Handler handler = TABLE.entries[opcode].handler)
 			{
 				// Handler is good, packet is passed on
+				auto start = std::chrono::steady_clock::now();
 
 				try
 				{
-					handler->handle(recv);
+					handler(recv);
 				}
 				catch (const PacketError& err)
 				{
@@ -248,6 +446,13 @@ namespace ms
 					warn(err.what(), opcode);
 					opcode_error = true;
 				}
+
+				int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+				profile.total += elapsed;
+
+				if (elapsed > profile.max)
+					profile.max = elapsed;
 			}
 			else
 			{
@@ -269,6 +474,54 @@ namespace ms
 #endif
 	}
 
+	void PacketSwitch::dump_profile(std::ostream& out) const
+	{
+		std::vector<uint16_t> received;
+
+		for (uint16_t opcode = 0; opcode < NUM_HANDLERS; opcode++)
+			if (profiles[opcode].count > 0)
+				received.push_back(opcode);
+
+		// The opcodes which cost the most time in total come first
+		std::sort(received.begin(), received.end(),
+			[&](uint16_t a, uint16_t b)
+			{
+				return profiles[a].total > profiles[b].total;
+			}
+		);
+
+		out << std::left << std::setw(32) << "Opcode" << std::right
+			<< std::setw(10) << "Count" << std::setw(12) << "Bytes"
+			<< std::setw(14) << "Total (us)" << std::setw(12) << "Avg (us)" << std::setw(12) << "Max (us)" << std::endl;
+
+		for (uint16_t opcode : received)
+		{
+			const Profile& profile = profiles[opcode];
+
+			out << std::left << std::setw(32) << (OpcodeName(opcode) + " (" + std::to_string(opcode) + ")") << std::right
+				<< std::setw(10) << profile.count << std::setw(12) << profile.bytes
+				<< std::setw(14) << profile.total / 1000 << std::setw(12) << profile.total / 1000 / profile.count << std::setw(12) << profile.max / 1000 << std::endl;
+		}
+	}
+
+	void PacketSwitch::reset_profile()
+	{
+		for (Profile& profile : profiles)
+			profile = {};
+	}
+
+	const PacketSwitch::Profile& PacketSwitch::get_profile(uint16_t opcode) const
+	{
+		static const Profile empty = {};
+
+		return opcode < NUM_HANDLERS ? profiles[opcode] : empty;
+	}
+
+	const char* PacketSwitch::name_of(uint16_t opcode)
+	{
+		return opcode < NUM_HANDLERS ? TABLE.entries[opcode].name : nullptr;
+	}
+
 	void PacketSwitch::warn(const std::string& message, size_t opcode) const
 	{
 		std::string opcode_msg = OpcodeName(opcode);
@@ -277,317 +530,8 @@ namespace ms
 
 	std::string PacketSwitch::OpcodeName(size_t opcode) const
 	{
-		std::string opcode_msg = std::to_string(opcode);
-
-		switch (opcode)
-		{
-			case 0: opcode_msg = "LOGIN_STATUS"; break;
-			case 1: opcode_msg = "GUEST_ID_LOGIN"; break;
-			case 2: opcode_msg = "ACCOUNT_INFO"; break;
-			case 3: opcode_msg = "SERVERSTATUS"; break;
-			case 4: opcode_msg = "GENDER_DONE"; break;
-			case 5: opcode_msg = "CONFIRM_EULA_RESULT"; break;
-			case 6: opcode_msg = "CHECK_PINCODE"; break;
-			case 7: opcode_msg = "UPDATE_PINCODE"; break;
-			case 8: opcode_msg = "VIEW_ALL_CHAR"; break;
-			case 9: opcode_msg = "SELECT_CHARACTER_BY_VAC"; break;
-			case 10: opcode_msg = "SERVERLIST"; break;
-			case 11: opcode_msg = "CHARLIST"; break;
-			case 12: opcode_msg = "SERVER_IP"; break;
-			case 13: opcode_msg = "CHAR_NAME_RESPONSE"; break;
-			case 14: opcode_msg = "ADD_NEW_CHAR_ENTRY"; break;
-			case 15: opcode_msg = "DELETE_CHAR_RESPONSE"; break;
-			case 16: opcode_msg = "CHANGE_CHANNEL"; break;
-			case 17: opcode_msg = "PING"; break;
-			case 18: opcode_msg = "KOREAN_INTERNET_CAFE_SHIT"; break;
-			case 20: opcode_msg = "CHANNEL_SELECTED"; break;
-			case 21: opcode_msg = "HACKSHIELD_REQUEST"; break;
-			case 22: opcode_msg = "RELOG_RESPONSE"; break;
-			case 25: opcode_msg = "CHECK_CRC_RESULT"; break;
-			case 26: opcode_msg = "LAST_CONNECTED_WORLD"; break;
-			case 27: opcode_msg = "RECOMMENDED_WORLD_MESSAGE"; break;
-			case 28: opcode_msg = "CHECK_SPW_RESULT"; break;
-			case 29: opcode_msg = "INVENTORY_OPERATION"; break;
-			case 30: opcode_msg = "INVENTORY_GROW"; break;
-			case 31: opcode_msg = "STAT_CHANGED"; break;
-			case 32: opcode_msg = "GIVE_BUFF"; break;
-			case 33: opcode_msg = "CANCEL_BUFF"; break;
-			case 34: opcode_msg = "FORCED_STAT_SET"; break;
-			case 35: opcode_msg = "FORCED_STAT_RESET"; break;
-			case 36: opcode_msg = "UPDATE_SKILLS"; break;
-			case 37: opcode_msg = "SKILL_USE_RESULT"; break;
-			case 38: opcode_msg = "FAME_RESPONSE"; break;
-			case 39: opcode_msg = "SHOW_STATUS_INFO"; break;
-			case 40: opcode_msg = "OPEN_FULL_CLIENT_DOWNLOAD_LINK"; break;
-			case 41: opcode_msg = "MEMO_RESULT"; break;
-			case 42: opcode_msg = "MAP_TRANSFER_RESULT"; break;
-			case 43: opcode_msg = "WEDDING_PHOTO"; break;
-			case 45: opcode_msg = "CLAIM_RESULT"; break;
-			case 46: opcode_msg = "CLAIM_AVAILABLE_TIME"; break;
-			case 47: opcode_msg = "CLAIM_STATUS_CHANGED"; break;
-			case 48: opcode_msg = "SET_TAMING_MOB_INFO"; break;
-			case 49: opcode_msg = "QUEST_CLEAR"; break;
-			case 50: opcode_msg = "ENTRUSTED_SHOP_CHECK_RESULT"; break;
-			case 51: opcode_msg = "SKILL_LEARN_ITEM_RESULT"; break;
-			case 52: opcode_msg = "GATHER_ITEM_RESULT"; break;
-			case 53: opcode_msg = "SORT_ITEM_RESULT"; break;
-			case 55: opcode_msg = "SUE_CHARACTER_RESULT"; break;
-			case 57: opcode_msg = "TRADE_MONEY_LIMIT"; break;
-			case 58: opcode_msg = "SET_GENDER"; break;
-			case 59: opcode_msg = "GUILD_BBS_PACKET"; break;
-			case 61: opcode_msg = "CHAR_INFO"; break;
-			case 62: opcode_msg = "PARTY_OPERATION"; break;
-			case 63: opcode_msg = "BUDDYLIST"; break;
-			case 65: opcode_msg = "GUILD_OPERATION"; break;
-			case 66: opcode_msg = "ALLIANCE_OPERATION"; break;
-			case 67: opcode_msg = "SPAWN_PORTAL"; break;
-			case 68: opcode_msg = "SERVERMESSAGE"; break;
-			case 69: opcode_msg = "INCUBATOR_RESULT"; break;
-			case 70: opcode_msg = "SHOP_SCANNER_RESULT"; break;
-			case 71: opcode_msg = "SHOP_LINK_RESULT"; break;
-			case 72: opcode_msg = "MARRIAGE_REQUEST"; break;
-			case 73: opcode_msg = "MARRIAGE_RESULT"; break;
-			case 74: opcode_msg = "WEDDING_GIFT_RESULT"; break;
-			case 75: opcode_msg = "NOTIFY_MARRIED_PARTNER_MAP_TRANSFER"; break;
-			case 76: opcode_msg = "CASH_PET_FOOD_RESULT"; break;
-			case 77: opcode_msg = "SET_WEEK_EVENT_MESSAGE"; break;
-			case 78: opcode_msg = "SET_POTION_DISCOUNT_RATE"; break;
-			case 79: opcode_msg = "BRIDLE_MOB_CATCH_FAIL"; break;
-			case 80: opcode_msg = "IMITATED_NPC_RESULT"; break;
-			case 81: opcode_msg = "IMITATED_NPC_DATA"; break;
-			case 82: opcode_msg = "LIMITED_NPC_DISABLE_INFO"; break;
-			case 83: opcode_msg = "MONSTER_BOOK_SET_CARD"; break;
-			case 84: opcode_msg = "MONSTER_BOOK_SET_COVER"; break;
-			case 85: opcode_msg = "HOUR_CHANGED"; break;
-			case 86: opcode_msg = "MINIMAP_ON_OFF"; break;
-			case 87: opcode_msg = "CONSULT_AUTHKEY_UPDATE"; break;
-			case 88: opcode_msg = "CLASS_COMPETITION_AUTHKEY_UPDATE"; break;
-			case 89: opcode_msg = "WEB_BOARD_AUTHKEY_UPDATE"; break;
-			case 90: opcode_msg = "SESSION_VALUE"; break;
-			case 91: opcode_msg = "PARTY_VALUE"; break;
-			case 92: opcode_msg = "FIELD_SET_VARIABLE"; break;
-			case 93: opcode_msg = "BONUS_EXP_CHANGED"; break;
-			case 94: opcode_msg = "FAMILY_CHART_RESULT"; break;
-			case 95: opcode_msg = "FAMILY_INFO_RESULT"; break;
-			case 96: opcode_msg = "FAMILY_RESULT"; break;
-			case 97: opcode_msg = "FAMILY_JOIN_REQUEST"; break;
-			case 98: opcode_msg = "FAMILY_JOIN_REQUEST_RESULT"; break;
-			case 99: opcode_msg = "FAMILY_JOIN_ACCEPTED"; break;
-			case 100: opcode_msg = "FAMILY_PRIVILEGE_LIST"; break;
-			case 101: opcode_msg = "FAMILY_FAMOUS_POINT_INC_RESULT"; break;
-			case 102: opcode_msg = "FAMILY_NOTIFY_LOGIN_OR_LOGOUT"; break;
-			case 103: opcode_msg = "FAMILY_SET_PRIVILEGE"; break;
-			case 104: opcode_msg = "FAMILY_SUMMON_REQUEST"; break;
-			case 105: opcode_msg = "NOTIFY_LEVELUP"; break;
-			case 106: opcode_msg = "NOTIFY_MARRIAGE"; break;
-			case 107: opcode_msg = "NOTIFY_JOB_CHANGE"; break;
-			case 108: opcode_msg = "SET_BUY_EQUIP_EXT"; break;
-			case 109: opcode_msg = "MAPLE_TV_USE_RES"; break;
-			case 110: opcode_msg = "AVATAR_MEGAPHONE_RESULT"; break;
-			case 111: opcode_msg = "SET_AVATAR_MEGAPHONE"; break;
-			case 112: opcode_msg = "CLEAR_AVATAR_MEGAPHONE"; break;
-			case 113: opcode_msg = "CANCEL_NAME_CHANGE_RESULT"; break;
-			case 114: opcode_msg = "CANCEL_TRANSFER_WORLD_RESULT"; break;
-			case 115: opcode_msg = "DESTROY_SHOP_RESULT"; break;
-			case 116: opcode_msg = "FAKE_GM_NOTICE"; break;
-			case 117: opcode_msg = "SUCCESS_IN_USE_GACHAPON_BOX"; break;
-			case 118: opcode_msg = "NEW_YEAR_CARD_RES"; break;
-			case 119: opcode_msg = "RANDOM_MORPH_RES"; break;
-			case 120: opcode_msg = "CANCEL_NAME_CHANGE_BY_OTHER"; break;
-			case 121: opcode_msg = "SET_EXTRA_PENDANT_SLOT"; break;
-			case 122: opcode_msg = "SCRIPT_PROGRESS_MESSAGE"; break;
-			case 123: opcode_msg = "DATA_CRC_CHECK_FAILED"; break;
-			case 124: opcode_msg = "MACRO_SYS_DATA_INIT"; break;
-			case 125: opcode_msg = "SET_FIELD"; break;
-			case 126: opcode_msg = "SET_ITC"; break;
-			case 127: opcode_msg = "SET_CASH_SHOP"; break;
-			case 128: opcode_msg = "SET_BACK_EFFECT"; break;
-			case 129: opcode_msg = "SET_MAP_OBJECT_VISIBLE"; break;
-			case 130: opcode_msg = "CLEAR_BACK_EFFECT"; break;
-			case 131: opcode_msg = "BLOCKED_MAP"; break;
-			case 132: opcode_msg = "BLOCKED_SERVER"; break;
-			case 133: opcode_msg = "FORCED_MAP_EQUIP"; break;
-			case 134: opcode_msg = "MULTICHAT"; break;
-			case 135: opcode_msg = "WHISPER"; break;
-			case 136: opcode_msg = "SPOUSE_CHAT"; break;
-			case 137: opcode_msg = "SUMMON_ITEM_INAVAILABLE"; break;
-			case 138: opcode_msg = "FIELD_EFFECT"; break;
-			case 139: opcode_msg = "FIELD_OBSTACLE_ONOFF"; break;
-			case 140: opcode_msg = "FIELD_OBSTACLE_ONOFF_LIST"; break;
-			case 141: opcode_msg = "FIELD_OBSTACLE_ALL_RESET"; break;
-			case 142: opcode_msg = "BLOW_WEATHER"; break;
-			case 143: opcode_msg = "PLAY_JUKEBOX"; break;
-			case 144: opcode_msg = "ADMIN_RESULT"; break;
-			case 145: opcode_msg = "OX_QUIZ"; break;
-			case 146: opcode_msg = "GMEVENT_INSTRUCTIONS"; break;
-			case 147: opcode_msg = "CLOCK"; break;
-			case 148: opcode_msg = "CONTI_MOVE"; break;
-			case 149: opcode_msg = "CONTI_STATE"; break;
-			case 150: opcode_msg = "SET_QUEST_CLEAR"; break;
-			case 151: opcode_msg = "SET_QUEST_TIME"; break;
-			case 152: opcode_msg = "WARN_MESSAGE"; break;
-			case 153: opcode_msg = "SET_OBJECT_STATE"; break;
-			case 154: opcode_msg = "STOP_CLOCK"; break;
-			case 155: opcode_msg = "ARIANT_ARENA_SHOW_RESULT"; break;
-			case 157: opcode_msg = "PYRAMID_GAUGE"; break;
-			case 158: opcode_msg = "PYRAMID_SCORE"; break;
-			case 160: opcode_msg = "SPAWN_PLAYER"; break;
-			case 161: opcode_msg = "REMOVE_PLAYER_FROM_MAP"; break;
-			case 162: opcode_msg = "CHATTEXT"; break;
-			case 163: opcode_msg = "CHATTEXT1"; break;
-			case 164: opcode_msg = "CHALKBOARD"; break;
-			case 165: opcode_msg = "UPDATE_CHAR_BOX"; break;
-			case 166: opcode_msg = "SHOW_CONSUME_EFFECT"; break;
-			case 167: opcode_msg = "SHOW_SCROLL_EFFECT"; break;
-			case 168: opcode_msg = "SPAWN_PET"; break;
-			case 170: opcode_msg = "MOVE_PET"; break;
-			case 171: opcode_msg = "PET_CHAT"; break;
-			case 172: opcode_msg = "PET_NAMECHANGE"; break;
-			case 173: opcode_msg = "PET_EXCEPTION_LIST"; break;
-			case 174: opcode_msg = "PET_COMMAND"; break;
-			case 175: opcode_msg = "SPAWN_SPECIAL_MAPOBJECT"; break;
-			case 176: opcode_msg = "REMOVE_SPECIAL_MAPOBJECT"; break;
-			case 177: opcode_msg = "MOVE_SUMMON"; break;
-			case 178: opcode_msg = "SUMMON_ATTACK"; break;
-			case 179: opcode_msg = "DAMAGE_SUMMON"; break;
-			case 180: opcode_msg = "SUMMON_SKILL"; break;
-			case 181: opcode_msg = "SPAWN_DRAGON"; break;
-			case 182: opcode_msg = "MOVE_DRAGON"; break;
-			case 183: opcode_msg = "REMOVE_DRAGON"; break;
-			case 185: opcode_msg = "MOVE_PLAYER"; break;
-			case 186: opcode_msg = "CLOSE_RANGE_ATTACK"; break;
-			case 187: opcode_msg = "RANGED_ATTACK"; break;
-			case 188: opcode_msg = "MAGIC_ATTACK"; break;
-			case 189: opcode_msg = "ENERGY_ATTACK"; break;
-			case 190: opcode_msg = "SKILL_EFFECT"; break;
-			case 191: opcode_msg = "CANCEL_SKILL_EFFECT"; break;
-			case 192: opcode_msg = "DAMAGE_PLAYER"; break;
-			case 193: opcode_msg = "FACIAL_EXPRESSION"; break;
-			case 194: opcode_msg = "SHOW_ITEM_EFFECT"; break;
-			case 196: opcode_msg = "SHOW_CHAIR"; break;
-			case 197: opcode_msg = "UPDATE_CHAR_LOOK"; break;
-			case 198: opcode_msg = "SHOW_FOREIGN_EFFECT"; break;
-			case 199: opcode_msg = "GIVE_FOREIGN_BUFF"; break;
-			case 200: opcode_msg = "CANCEL_FOREIGN_BUFF"; break;
-			case 201: opcode_msg = "UPDATE_PARTYMEMBER_HP"; break;
-			case 202: opcode_msg = "GUILD_NAME_CHANGED"; break;
-			case 203: opcode_msg = "GUILD_MARK_CHANGED"; break;
-			case 204: opcode_msg = "THROW_GRENADE"; break;
-			case 205: opcode_msg = "CANCEL_CHAIR"; break;
-			case 206: opcode_msg = "SHOW_ITEM_GAIN_INCHAT"; break;
-			case 207: opcode_msg = "DOJO_WARP_UP"; break;
-			case 208: opcode_msg = "LUCKSACK_PASS"; break;
-			case 209: opcode_msg = "LUCKSACK_FAIL"; break;
-			case 210: opcode_msg = "MESO_BAG_MESSAGE"; break;
-			case 211: opcode_msg = "UPDATE_QUEST_INFO"; break;
-			case 214: opcode_msg = "PLAYER_HINT"; break;
-			case 219: opcode_msg = "KOREAN_EVENT"; break;
-			case 220: opcode_msg = "OPEN_UI"; break;
-			case 221: opcode_msg = "LOCK_UI"; break;
-			case 222: opcode_msg = "DISABLE_UI"; break;
-			case 223: opcode_msg = "SPAWN_GUIDE"; break;
-			case 224: opcode_msg = "TALK_GUIDE"; break;
-			case 225: opcode_msg = "SHOW_COMBO"; break;
-			case 234: opcode_msg = "COOLDOWN"; break;
-			case 236: opcode_msg = "SPAWN_MONSTER"; break;
-			case 237: opcode_msg = "KILL_MONSTER"; break;
-			case 238: opcode_msg = "SPAWN_MONSTER_CONTROL"; break;
-			case 239: opcode_msg = "MOVE_MONSTER"; break;
-			case 240: opcode_msg = "MOVE_MONSTER_RESPONSE"; break;
-			case 242: opcode_msg = "APPLY_MONSTER_STATUS"; break;
-			case 243: opcode_msg = "CANCEL_MONSTER_STATUS"; break;
-			case 244: opcode_msg = "RESET_MONSTER_ANIMATION"; break;
-			case 246: opcode_msg = "DAMAGE_MONSTER"; break;
-			case 249: opcode_msg = "ARIANT_THING"; break;
-			case 250: opcode_msg = "SHOW_MONSTER_HP"; break;
-			case 251: opcode_msg = "CATCH_MONSTER"; break;
-			case 252: opcode_msg = "CATCH_MONSTER_WITH_ITEM"; break;
-			case 253: opcode_msg = "SHOW_MAGNET"; break;
-			case 257: opcode_msg = "SPAWN_NPC"; break;
-			case 258: opcode_msg = "REMOVE_NPC"; break;
-			case 259: opcode_msg = "SPAWN_NPC_REQUEST_CONTROLLER"; break;
-			case 260: opcode_msg = "NPC_ACTION"; break;
-			case 265: opcode_msg = "SPAWN_HIRED_MERCHANT"; break;
-			case 266: opcode_msg = "DESTROY_HIRED_MERCHANT"; break;
-			case 267: opcode_msg = "UPDATE_HIRED_MERCHANT"; break;
-			case 268: opcode_msg = "DROP_ITEM_FROM_MAPOBJECT"; break;
-			case 269: opcode_msg = "REMOVE_ITEM_FROM_MAP"; break;
-			case 270: opcode_msg = "CANNOT_SPAWN_KITE"; break;
-			case 271: opcode_msg = "SPAWN_KITE"; break;
-			case 272: opcode_msg = "REMOVE_KITE"; break;
-			case 273: opcode_msg = "SPAWN_MIST"; break;
-			case 274: opcode_msg = "REMOVE_MIST"; break;
-			case 275: opcode_msg = "SPAWN_DOOR"; break;
-			case 276: opcode_msg = "REMOVE_DOOR"; break;
-			case 277: opcode_msg = "REACTOR_HIT"; break;
-			case 279: opcode_msg = "REACTOR_SPAWN"; break;
-			case 280: opcode_msg = "REACTOR_DESTROY"; break;
-			case 281: opcode_msg = "SNOWBALL_STATE"; break;
-			case 282: opcode_msg = "HIT_SNOWBALL"; break;
-			case 283: opcode_msg = "SNOWBALL_MESSAGE"; break;
-			case 284: opcode_msg = "LEFT_KNOCK_BACK"; break;
-			case 285: opcode_msg = "COCONUT_HIT"; break;
-			case 286: opcode_msg = "COCONUT_SCORE"; break;
-			case 287: opcode_msg = "GUILD_BOSS_HEALER_MOVE"; break;
-			case 288: opcode_msg = "GUILD_BOSS_PULLEY_STATE_CHANGE"; break;
-			case 289: opcode_msg = "MONSTER_CARNIVAL_START"; break;
-			case 290: opcode_msg = "MONSTER_CARNIVAL_OBTAINED_CP"; break;
-			case 291: opcode_msg = "MONSTER_CARNIVAL_PARTY_CP"; break;
-			case 292: opcode_msg = "MONSTER_CARNIVAL_SUMMON"; break;
-			case 293: opcode_msg = "MONSTER_CARNIVAL_MESSAGE"; break;
-			case 294: opcode_msg = "MONSTER_CARNIVAL_DIED"; break;
-			case 295: opcode_msg = "MONSTER_CARNIVAL_LEAVE"; break;
-			case 297: opcode_msg = "ARIANT_ARENA_USER_SCORE"; break;
-			case 299: opcode_msg = "SHEEP_RANCH_INFO"; break;
-			case 300: opcode_msg = "SHEEP_RANCH_CLOTHES"; break;
-			case 301: opcode_msg = "ARIANT_SCORE"; break;
-			case 302: opcode_msg = "HORNTAIL_CAVE"; break;
-			case 303: opcode_msg = "ZAKUM_SHRINE"; break;
-			case 304: opcode_msg = "NPC_TALK"; break;
-			case 305: opcode_msg = "OPEN_NPC_SHOP"; break;
-			case 306: opcode_msg = "CONFIRM_SHOP_TRANSACTION"; break;
-			case 307: opcode_msg = "ADMIN_SHOP_MESSAGE"; break;
-			case 308: opcode_msg = "ADMIN_SHOP"; break;
-			case 309: opcode_msg = "STORAGE"; break;
-			case 310: opcode_msg = "FREDRICK_MESSAGE"; break;
-			case 311: opcode_msg = "FREDRICK"; break;
-			case 312: opcode_msg = "RPS_GAME"; break;
-			case 313: opcode_msg = "MESSENGER"; break;
-			case 314: opcode_msg = "PLAYER_INTERACTION"; break;
-			case 315: opcode_msg = "TOURNAMENT"; break;
-			case 316: opcode_msg = "TOURNAMENT_MATCH_TABLE"; break;
-			case 317: opcode_msg = "TOURNAMENT_SET_PRIZE"; break;
-			case 318: opcode_msg = "TOURNAMENT_UEW"; break;
-			case 319: opcode_msg = "TOURNAMENT_CHARACTERS"; break;
-			case 320: opcode_msg = "WEDDING_PROGRESS"; break;
-			case 321: opcode_msg = "WEDDING_CEREMONY_END"; break;
-			case 322: opcode_msg = "PARCEL"; break;
-			case 323: opcode_msg = "CHARGE_PARAM_RESULT"; break;
-			case 324: opcode_msg = "QUERY_CASH_RESULT"; break;
-			case 325: opcode_msg = "CASHSHOP_OPERATION"; break;
-			case 327: opcode_msg = "CASHSHOP_GIFT_INFO_RESULT"; break;
-			case 328: opcode_msg = "CASHSHOP_CHECK_NAME_CHANGE"; break;
-			case 329: opcode_msg = "CASHSHOP_CHECK_NAME_CHANGE_POSSIBLE_RESULT"; break;
-			case 330: opcode_msg = "CASHSHOP_REGISTER_NEW_CHARACTER_RESULT"; break;
-			case 331: opcode_msg = "CASHSHOP_CHECK_TRANSFER_WORLD_POSSIBLE_RESULT"; break;
-			case 332: opcode_msg = "CASHSHOP_GACHAPON_STAMP_RESULT"; break;
-			case 333: opcode_msg = "CASHSHOP_CASH_ITEM_GACHAPON_RESULT"; break;
-			case 334: opcode_msg = "CASHSHOP_CASH_GACHAPON_OPEN_RESULT"; break;
-			case 335: opcode_msg = "KEYMAP"; break;
-			case 336: opcode_msg = "AUTO_HP_POT"; break;
-			case 337: opcode_msg = "AUTO_MP_POT"; break;
-			case 341: opcode_msg = "SEND_TV"; break;
-			case 342: opcode_msg = "REMOVE_TV"; break;
-			case 343: opcode_msg = "ENABLE_TV"; break;
-			case 347: opcode_msg = "MTS_OPERATION2"; break;
-			case 348: opcode_msg = "MTS_OPERATION"; break;
-			case 349: opcode_msg = "MAPLELIFE_RESULT"; break;
-			case 350: opcode_msg = "MAPLELIFE_ERROR"; break;
-			case 354: opcode_msg = "VICIOUS_HAMMER"; break;
-			case 358: opcode_msg = "VEGA_SCROLL"; break;
-			default: break;
-		}
+		const char* name = opcode < NUM_HANDLERS ? name_of(static_cast<uint16_t>(opcode)) : nullptr;
 
-		return opcode_msg;
+		return name ? name : std::to_string(opcode);
 	}
 }
\ No newline at end of file
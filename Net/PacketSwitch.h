@@ -19,19 +19,45 @@
 
 #include "PacketHandler.h"
 
-#include <memory>
+#include <ostream>
+#include <string>
 
 namespace ms
 {
-	// Class which contains the array of handler classes to use
+	// Class which forwards packets to their handlers and measures how long handling takes
 	class PacketSwitch
 	{
 	public:
-		// Register all handlers
+		// Function which handles the packets with one opcode
+		using Handler = void(*)(InPacket& recv);
+
+		// Measurements for the packets received with one opcode
+		// Times are in nanoseconds and only include the handler.
+		struct Profile
+		{
+			uint64_t count;
+			uint64_t bytes;
+			int64_t total;
+			int64_t max;
+		};
+
 		PacketSwitch();
 
 		// Forward a packet to the correct handler
-		void forward(const int8_t* bytes, size_t length) const;
+		void forward(const int8_t* bytes, size_t length);
+
+		// Write the measurements of every opcode received so far, the most expensive ones first
+		void dump_profile(std::ostream& out) const;
+		// Discard all measurements
+		void reset_profile();
+		// Return the measurements for an opcode
+		const Profile& get_profile(uint16_t opcode) const;
+
+		// Return the name of an opcode, or nullptr if it is not registered
+		static const char* name_of(uint16_t opcode);
+
+		// Maximum number of handlers needed
+		static constexpr const size_t NUM_HANDLERS = 500;
 
 	private:
 		// Print a warning
@@ -40,33 +66,11 @@ namespace ms
 		// Get the string value of the Opcode
 		std::string OpcodeName(size_t opcode) const;
 
-		// Opcodes for which handlers can be registered
-		enum Opcode : uint16_t;
-
 		// Message when an unhandled packet is received
 		static constexpr const char* MSG_UNHANDLED = "Unhandled packet detected";
 		// Message when a packet with a larger opcode than the array size is received
 		static constexpr const char* MSG_OUTOFBOUNDS = "Large opcode detected";
-		// Message when a packet with a larger opcode than the array size is received
-		static constexpr const char* MSG_REREGISTER = "Handler was registered twice";
-		// Maximum number of handlers needed
-		static constexpr const size_t NUM_HANDLERS = 500;
-
-		std::unique_ptr<PacketHandler> handlers[NUM_HANDLERS];
-
-		// Register a handler for the specified opcode
-		template <size_t O, typename T, typename...Args>
-		void emplace(Args&& ...args)
-		{
-			static_assert(O < NUM_HANDLERS, "PacketSwitch::emplace - Opcode out of array bounds");
-			static_assert(std::is_base_of<PacketHandler, T>::value, "Error: Packet handlers must derive from PacketHandler");
-
-			if (handlers[O])
-				warn(MSG_REREGISTER, O);
 
-			handlers[O] = std::make_unique<T>(
-				std::forward<Args>(args)...
-				);
-		}
+		Profile profiles[NUM_HANDLERS];
 	};
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "ReceiveBuffer.h"
+
+#include <cstring>
+
+namespace ms
+{
+	ReceiveBuffer::ReceiveBuffer()
+	{
+		clear();
+	}
+
+	int8_t* ReceiveBuffer::reserve(size_t& available)
+	{
+		// Make sure a whole packet always fits behind the pending bytes
+		if (begin > 0 && CAPACITY - end < MAX_PACKET_LENGTH + HEADER_LENGTH)
+		{
+			size_t count = end - begin;
+			std::memmove(bytes, bytes + begin, count);
+
+			begin = 0;
+			end = count;
+		}
+
+		available = CAPACITY - end;
+
+		return bytes + end;
+	}
+
+	void ReceiveBuffer::commit(size_t count)
+	{
+		end += count;
+	}
+
+	int8_t* ReceiveBuffer::next(const Cryptography& cryptography, size_t& length)
+	{
+		if (corrupted || end - begin < HEADER_LENGTH)
+			return nullptr;
+
+		length = cryptography.check_length(bytes + begin);
+
+		if (length > MAX_PACKET_LENGTH)
+		{
+			corrupted = true;
+
+			return nullptr;
+		}
+
+		if (end - begin - HEADER_LENGTH < length)
+			return nullptr;
+
+		int8_t* packet = bytes + begin + HEADER_LENGTH;
+		begin += HEADER_LENGTH + length;
+
+		if (begin == end)
+		{
+			begin = 0;
+			end = 0;
+		}
+
+		return packet;
+	}
+
+	void ReceiveBuffer::clear()
+	{
+		begin = 0;
+		end = 0;
+		corrupted = false;
+	}
+
+	bool ReceiveBuffer::is_corrupted() const
+	{
+		return corrupted;
+	}
+
+	size_t ReceiveBuffer::pending() const
+	{
+		return end - begin;
+	}
+}
@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Cryptography.h"
+#include "NetConstants.h"
+
+namespace ms
+{
+	// Holds bytes received from the server until they form complete packets
+	// Packets are handed out where they lie in the buffer and are never copied.
+	// When the space at the end runs out, the partial packet left over is moved to the front.
+	class ReceiveBuffer
+	{
+	public:
+		ReceiveBuffer();
+
+		// Return where the next bytes can be received to and how many fit
+		int8_t* reserve(size_t& available);
+		// Add bytes which were received into the reserved space
+		void commit(size_t count);
+		// Return the next complete packet and its length, or nullptr if there is none
+		// The length is read from the header, the packet itself is still encrypted.
+		int8_t* next(const Cryptography& cryptography, size_t& length);
+		// Discard all bytes, e.g. after reconnecting
+		void clear();
+
+		// Return whether a header announced a packet which can not be valid
+		bool is_corrupted() const;
+		// Return the number of bytes waiting for the rest of their packet
+		size_t pending() const;
+
+		static const size_t CAPACITY = 4 * MAX_PACKET_LENGTH;
+
+	private:
+		int8_t bytes[CAPACITY];
+		size_t begin;
+		size_t end;
+		bool corrupted;
+	};
+}
@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "SendBuffer.h"
+
+#include <cstring>
+
+namespace ms
+{
+	SendBuffer::SendBuffer() : packets(0)
+	{
+		// Enough for everything sent during a typical frame
+		bytes.reserve(16384);
+	}
+
+	void SendBuffer::append(Cryptography& cryptography, const int8_t* packet, size_t length)
+	{
+		size_t offset = bytes.size();
+		bytes.resize(offset + HEADER_LENGTH + length);
+
+		int8_t* header = bytes.data() + offset;
+		int8_t* body = header + HEADER_LENGTH;
+
+		// The header must be created before encrypting, as encrypting updates the iv
+		cryptography.create_header(header, length);
+		std::memcpy(body, packet, length);
+		cryptography.encrypt(body, length);
+
+		packets++;
+	}
+
+	void SendBuffer::clear()
+	{
+		bytes.clear();
+		packets = 0;
+	}
+
+	const int8_t* SendBuffer::data() const
+	{
+		return bytes.data();
+	}
+
+	size_t SendBuffer::size() const
+	{
+		return bytes.size();
+	}
+
+	size_t SendBuffer::count() const
+	{
+		return packets;
+	}
+
+	bool SendBuffer::empty() const
+	{
+		return packets == 0;
+	}
+}
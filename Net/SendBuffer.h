@@ -0,0 +1,51 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Cryptography.h"
+
+#include <vector>
+
+namespace ms
+{
+	// Collects outgoing packets so they can be sent together
+	// Each packet is copied behind its header and encrypted where it lies, so the batch is one contiguous block.
+	class SendBuffer
+	{
+	public:
+		SendBuffer();
+
+		// Add the header and the encrypted packet to the batch
+		void append(Cryptography& cryptography, const int8_t* bytes, size_t length);
+		// Discard the batch, keeping the memory for the next one
+		void clear();
+
+		// Return the start of the batch
+		const int8_t* data() const;
+		// Return the number of bytes in the batch, including headers
+		size_t size() const;
+		// Return the number of packets in the batch
+		size_t count() const;
+		// Return whether there is nothing to send
+		bool empty() const;
+
+	private:
+		std::vector<int8_t> bytes;
+		size_t packets;
+	};
+}
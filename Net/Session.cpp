@@ -19,24 +19,46 @@
 
 #include "../Configuration.h"
 #include "../Util/Misc.h"
+#include "../Util/Profiler.h"
+
+#include <chrono>
 
 namespace ms
 {
 	Session::Session()
 	{
 		connected = false;
-		length = 0;
-		pos = 0;
+		running = false;
+		threaded = false;
+		generation = 0;
+
+		sentpackets = 0;
+		sentbytes = 0;
+		sends = 0;
+		flushed = {};
+		lastframe = {};
 	}
 
 	Session::~Session()
 	{
+		stop_thread();
+
 		if (connected)
+		{
+			send();
 			socket.close();
+		}
 	}
 
 	bool Session::init(const char* host, const char* port)
 	{
+		stop_thread();
+
+		// Bytes left over from a previous connection can not be decrypted anymore
+		receivebuffer.clear();
+		sendbuffer.clear();
+		generation++;
+
 		// Connect to the server
 		connected = socket.open(host, port);
 
@@ -44,6 +66,17 @@ namespace ms
 		{
 			// Read keys necessary for communicating with the server
 			cryptography = { socket.get_buffer() };
+
+			// A capture continues across reconnects, so it contains the whole session
+			std::string capture = Setting<PacketCapture>::get().load();
+
+			if (!capture.empty() && !recorder.is_open() && !recorder.open(capture))
+				LOG(LOG_NETWORK, "Could not create the packet capture file " << capture);
+
+			threaded = Setting<NetworkThread>::get().load();
+
+			if (threaded)
+				start_thread();
 		}
 
 		return connected;
@@ -62,6 +95,13 @@ namespace ms
 
 	void Session::reconnect(const char* address, const char* port)
 	{
+		// The socket may only be closed once the network thread let go of it
+		stop_thread();
+
+		// Packets written before reconnecting are still meant for the current server
+		if (connected)
+			send();
+
 		// Close the current connection and open a new one
 		bool success = socket.close();
 
@@ -75,78 +115,212 @@ namespace ms
 		}
 	}
 
-	void Session::process(const int8_t* bytes, size_t available)
+	void Session::write(int8_t* packet_bytes, size_t packet_length)
 	{
-		if (pos == 0)
+		if (!connected)
+			return;
+
+		if (!threaded)
 		{
-			// Position is zero, meaning this is the start of a new packet. Start by determining length.
-			length = cryptography.check_length(bytes);
-			// Reading the length means we processed the header. Move forward by the header length.
-			bytes = bytes + HEADER_LENGTH;
-			available -= HEADER_LENGTH;
+			sendbuffer.append(cryptography, packet_bytes, packet_length);
+
+			return;
 		}
 
-		// Determine how much we can write. Write data into the buffer.
-		size_t towrite = length - pos;
+		// The network thread empties the queue at least once per wait, so a full queue frees up quickly
+		std::vector<int8_t>* slot = outgoing.back();
 
-		if (towrite > available)
-			towrite = available;
+		while (!slot && running && connected)
+		{
+			std::this_thread::yield();
 
-		memcpy(buffer + pos, bytes, towrite);
-		pos += towrite;
+			slot = outgoing.back();
+		}
 
-		// Check if the current packet has been fully processed
-		if (pos >= length)
+		if (slot)
 		{
-			cryptography.decrypt(buffer, length);
+			slot->assign(packet_bytes, packet_bytes + packet_length);
+			outgoing.push();
+		}
+	}
 
-			try
-			{
-				packetswitch.forward(buffer, length);
-			}
-			catch (const PacketError& err)
+	void Session::read()
+	{
+		ScopedTimer timer(Profiler::Section::NETWORK);
+
+		if (threaded)
+		{
+			uint32_t current = generation;
+
+			while (std::vector<int8_t>* packet = incoming.front())
 			{
-				LOG(LOG_NETWORK, err.what());
+				handle(packet->data(), packet->size());
+
+				// A handler reconnected, which discarded the remaining packets
+				if (generation != current)
+					break;
+
+				incoming.pop();
 			}
 
-			pos = 0;
-			length = 0;
+			return;
+		}
+
+		// Receive everything the server has sent so far, handling complete packets in between
+		bool received = true;
 
-			// Check if there is more available
-			size_t remaining = available - towrite;
+		while (received && connected)
+		{
+			received = receive();
 
-			if (remaining >= MIN_PACKET_LENGTH)
-			{
-				// More packets are available, so we start over.
-				process(bytes + towrite, remaining);
-			}
+			size_t length;
+
+			while (int8_t* packet = next(length))
+				handle(packet, length);
 		}
 	}
 
-	void Session::write(int8_t* packet_bytes, size_t packet_length)
+	bool Session::receive()
 	{
-		if (!connected)
+		size_t available;
+		int8_t* bytes = receivebuffer.reserve(available);
+
+		// A full buffer must be framed first, receiving nothing would look like a closed connection
+		if (available == 0)
+			return false;
+
+		bool alive = true;
+		size_t result = socket.receive(bytes, available, &alive);
+
+		if (!alive)
+			connected = false;
+
+		receivebuffer.commit(result);
+
+		return result > 0;
+	}
+
+	int8_t* Session::next(size_t& length)
+	{
+		// Packets are decrypted where they lie in the buffer
+		if (int8_t* packet = receivebuffer.next(cryptography, length))
+		{
+			cryptography.decrypt(packet, length);
+			recorder.record(packet, length);
+
+			return packet;
+		}
+
+		if (receivebuffer.is_corrupted())
+		{
+			LOG(LOG_NETWORK, "Received a packet header with an invalid length, closing the connection.");
+
+			receivebuffer.clear();
+			socket.close();
+			connected = false;
+		}
+
+		return nullptr;
+	}
+
+	void Session::flush()
+	{
+		// The network thread sends its own batches
+		if (!threaded && connected)
+			send();
+
+		Counters total = { sentpackets, sentbytes, sends };
+
+		lastframe.packets = total.packets - flushed.packets;
+		lastframe.bytes = total.bytes - flushed.bytes;
+		lastframe.sends = total.sends - flushed.sends;
+
+		flushed = total;
+	}
+
+	void Session::send()
+	{
+		if (sendbuffer.empty())
 			return;
 
-		int8_t header[HEADER_LENGTH];
-		cryptography.create_header(header, packet_length);
-		cryptography.encrypt(packet_bytes, packet_length);
+		socket.dispatch(sendbuffer.data(), sendbuffer.size());
 
-		socket.dispatch(header, HEADER_LENGTH);
-		socket.dispatch(packet_bytes, packet_length);
+		sentpackets += sendbuffer.count();
+		sentbytes += sendbuffer.size();
+		sends++;
+
+		sendbuffer.clear();
 	}
 
-	void Session::read()
+	void Session::handle(const int8_t* bytes, size_t length)
 	{
-		// Check if a packet has arrived. Handle if data is sufficient: 4 bytes (header) + 2 bytes (opcode) = 6 bytes.
-		size_t result = socket.receive(&connected);
+		try
+		{
+			packetswitch.forward(bytes, length);
+		}
+		catch (const PacketError& err)
+		{
+			LOG(LOG_NETWORK, err.what());
+		}
+	}
+
+	void Session::start_thread()
+	{
+		running = true;
+		worker = std::thread(&Session::run, this);
+	}
 
-		if (result >= MIN_PACKET_LENGTH || length > 0)
+	void Session::stop_thread()
+	{
+		if (worker.joinable())
 		{
-			// Retrieve buffer from the socket and process it
-			const int8_t* bytes = socket.get_buffer();
-			process(bytes, result);
+			running = false;
+			worker.join();
 		}
+
+		incoming.clear();
+		outgoing.clear();
+	}
+
+	void Session::run()
+	{
+		while (running && connected)
+		{
+			// Send everything the main thread wrote since the last pass as one batch
+			while (std::vector<int8_t>* packet = outgoing.front())
+			{
+				sendbuffer.append(cryptography, packet->data(), packet->size());
+				outgoing.pop();
+			}
+
+			send();
+
+			// Pass on complete packets for as long as the main thread has room for them
+			while (std::vector<int8_t>* slot = incoming.back())
+			{
+				size_t length;
+				int8_t* packet = next(length);
+
+				if (!packet)
+					break;
+
+				slot->assign(packet, packet + length);
+				incoming.push();
+			}
+
+			if (socket.wait(WAIT_MICROSECONDS) && !receive())
+				std::this_thread::sleep_for(std::chrono::microseconds(WAIT_MICROSECONDS));
+		}
+
+		// Packets written before stopping still belong to this connection
+		while (std::vector<int8_t>* packet = outgoing.front())
+		{
+			sendbuffer.append(cryptography, packet->data(), packet->size());
+			outgoing.pop();
+		}
+
+		if (connected)
+			send();
 	}
 
 	void Session::reconnect()
@@ -161,4 +335,14 @@ namespace ms
 	{
 		return connected;
 	}
+
+	Session::Counters Session::get_sent() const
+	{
+		return lastframe;
+	}
+
+	void Session::dump_profile(std::ostream& out) const
+	{
+		packetswitch.dump_profile(out);
+	}
 }
\ No newline at end of file
@@ -18,12 +18,16 @@
 #pragma once
 
 #include "Cryptography.h"
+#include "PacketCapture.h"
 #include "PacketSwitch.h"
+#include "ReceiveBuffer.h"
+#include "SendBuffer.h"
 
 #include "../Error.h"
 #include "../MapleStory.h"
 
 #include "../Template/Singleton.h"
+#include "../Template/SpscQueue.h"
 
 #ifdef USE_ASIO
 #include "SocketAsio.h"
@@ -31,19 +35,37 @@
 #include "SocketWinsock.h"
 #endif
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace ms
 {
 	class Session : public Singleton<Session>
 	{
 	public:
+		// Traffic sent to the server
+		struct Counters
+		{
+			uint64_t packets;
+			uint64_t bytes;
+			uint64_t sends;
+		};
+
 		Session();
 		~Session();
 
 		// Connect using host and port from the configuration file
 		Error init();
-		// Send a packet to the server
+		// Connect to the specified host and port
+		bool init(const char* host, const char* port);
+		// Add a packet to the batch which is sent with the next flush
+		// With the network thread enabled the packet is queued and sent by that thread.
 		void write(int8_t* bytes, size_t length);
+		// Send all packets written since the last flush with a single call, once per frame
+		void flush();
 		// Check for incoming packets and handle them
+		// With the network thread enabled only packets which that thread already decrypted are handled.
 		void read();
 		// Closes the current connection and opens a new one with default connection settings
 		void reconnect();
@@ -51,18 +73,55 @@ namespace ms
 		void reconnect(const char* address, const char* port);
 		// Check if the connection is alive
 		bool is_connected() const;
+		// Return what was sent between the last two flushes
+		Counters get_sent() const;
+		// Write how much time the handler of each opcode took so far
+		void dump_profile(std::ostream& out) const;
 
 	private:
-		bool init(const char* host, const char* port);
-		void process(const int8_t* bytes, size_t available);
+		// Receive what the socket has waiting, return whether anything arrived
+		bool receive();
+		// Return the next complete packet decrypted, or nullptr if there is none
+		int8_t* next(size_t& length);
+		// Send the batch of encrypted packets
+		void send();
+		// Pass a decrypted packet to its handler
+		void handle(const int8_t* bytes, size_t length);
+
+		// Start the network thread, which owns the socket until it is stopped
+		void start_thread();
+		// Stop the network thread and discard all queued packets
+		void stop_thread();
+		// Main loop of the network thread
+		void run();
+
+		static constexpr size_t QUEUE_LENGTH = 1024;
+		// How long the network thread waits for data before sending queued packets again
+		static constexpr int32_t WAIT_MICROSECONDS = 1000;
 
 		Cryptography cryptography;
 		PacketSwitch packetswitch;
+		ReceiveBuffer receivebuffer;
+		SendBuffer sendbuffer;
+		// Records received packets when a capture file is configured
+		PacketRecorder recorder;
+
+		SpscQueue<std::vector<int8_t>, QUEUE_LENGTH> incoming;
+		SpscQueue<std::vector<int8_t>, QUEUE_LENGTH> outgoing;
+		std::thread worker;
+		std::atomic<bool> running;
+		bool threaded;
+		// Counts connections, so packets of a previous one are not handled after reconnecting
+		uint32_t generation;
+
+		// Totals since starting, updated by whichever thread sends
+		std::atomic<uint64_t> sentpackets;
+		std::atomic<uint64_t> sentbytes;
+		std::atomic<uint64_t> sends;
+		Counters flushed;
+		Counters lastframe;
 
-		int8_t buffer[MAX_PACKET_LENGTH];
-		size_t length;
-		size_t pos;
-		bool connected;
+		std::atomic<bool> connected;
 
 #ifdef USE_ASIO
 		SocketAsio socket;
@@ -17,6 +17,9 @@
 //////////////////////////////////////////////////////////////////////////////////
 #include "SocketAsio.h"
 
+#include <chrono>
+#include <thread>
+
 #ifdef USE_ASIO
 namespace ms
 {
@@ -56,12 +59,12 @@ namespace ms
 		return !error;
 	}
 
-	size_t SocketAsio::receive(bool* recvok)
+	size_t SocketAsio::receive(int8_t* bytes, size_t length, bool* recvok)
 	{
 		if (socket.available() > 0)
 		{
 			error_code error;
-			size_t result = socket.read_some(asio::buffer(buffer), error);
+			size_t result = socket.read_some(asio::buffer(bytes, length), error);
 			*recvok = !error;
 
 			return result;
@@ -70,6 +73,16 @@ namespace ms
 		return 0;
 	}
 
+	bool SocketAsio::wait(int32_t microseconds)
+	{
+		if (socket.available() > 0)
+			return true;
+
+		std::this_thread::sleep_for(std::chrono::microseconds(microseconds));
+
+		return socket.available() > 0;
+	}
+
 	const int8_t* SocketAsio::get_buffer() const
 	{
 		return buffer;
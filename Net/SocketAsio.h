@@ -47,7 +47,11 @@ namespace ms
 
 		bool open(const char* address, const char* port);
 		bool close();
-		size_t receive(bool* connected);
+		// Receive at most length bytes, return zero if nothing is waiting
+		size_t receive(int8_t* bytes, size_t length, bool* connected);
+		// Wait until data arrives or the timeout elapses, return whether the socket is readable
+		bool wait(int32_t microseconds);
+		// Return the handshake received when opening the connection
 		const int8_t* get_buffer() const;
 		bool dispatch(const int8_t* bytes, size_t length);
 
@@ -55,7 +59,7 @@ namespace ms
 		io_service ioservice;
 		tcp::resolver resolver;
 		tcp::socket socket;
-		int8_t buffer[MAX_PACKET_LENGTH];
+		int8_t buffer[32];
 	};
 }
 #endif
\ No newline at end of file
@@ -116,7 +116,7 @@ namespace ms
 		return send(sock, (char*)bytes, static_cast<int>(length), 0) != SOCKET_ERROR;
 	}
 
-	size_t SocketWinsock::receive(bool* success)
+	size_t SocketWinsock::receive(int8_t* bytes, size_t length, bool* success)
 	{
 		timeval timeout = { 0, 0 };
 		fd_set sockset = { 0 };
@@ -126,7 +126,17 @@ namespace ms
 		int result = select(0, &sockset, 0, 0, &timeout);
 
 		if (result > 0)
-			result = recv(sock, (char*)buffer, MAX_PACKET_LENGTH, 0);
+		{
+			result = recv(sock, (char*)bytes, static_cast<int>(length), 0);
+
+			// A readable socket without data means the server closed the connection
+			if (result == 0)
+			{
+				*success = false;
+
+				return 0;
+			}
+		}
 
 		if (result == SOCKET_ERROR)
 		{
@@ -140,6 +150,17 @@ namespace ms
 		}
 	}
 
+	bool SocketWinsock::wait(int32_t microseconds) const
+	{
+		timeval timeout = { 0, microseconds };
+		fd_set sockset = { 0 };
+
+		FD_SET(sock, &sockset);
+
+		// Errors also count as readable, so the following receive reports them
+		return select(0, &sockset, 0, 0, &timeout) != 0;
+	}
+
 	const int8_t* SocketWinsock::get_buffer() const
 	{
 		return buffer;
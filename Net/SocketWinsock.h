@@ -37,12 +37,16 @@ namespace ms
 		bool close();
 
 		bool dispatch(const int8_t* bytes, size_t length) const;
-		size_t receive(bool* connected);
+		// Receive at most length bytes, return zero if nothing is waiting
+		size_t receive(int8_t* bytes, size_t length, bool* connected);
+		// Wait until data arrives or the timeout elapses, return whether the socket is readable
+		bool wait(int32_t microseconds) const;
+		// Return the handshake received when opening the connection
 		const int8_t* get_buffer() const;
 
 	private:
 		uint64_t sock;
-		int8_t buffer[MAX_PACKET_LENGTH];
+		int8_t buffer[32];
 	};
 }
 #endif
\ No newline at end of file
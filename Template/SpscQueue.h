@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace ms
+{
+	// Fixed size queue between exactly one producer and one consumer thread
+	// Slots are reused, so a producer can fill the slot returned by back() in place before pushing it.
+	template <typename T, size_t N>
+	class SpscQueue
+	{
+		static_assert(N > 0 && (N & (N - 1)) == 0, "The length of an SpscQueue must be a power of two.");
+
+	public:
+		SpscQueue() : head(0), tail(0) {}
+
+		// Producer: Return the slot to fill next, or nullptr if the queue is full
+		T* back()
+		{
+			size_t t = tail.load(std::memory_order_relaxed);
+
+			if (t - head.load(std::memory_order_acquire) == N)
+				return nullptr;
+
+			return &slots[t & (N - 1)];
+		}
+
+		// Producer: Make the slot returned by back() visible to the consumer
+		void push()
+		{
+			tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		// Consumer: Return the oldest slot, or nullptr if the queue is empty
+		T* front()
+		{
+			size_t h = head.load(std::memory_order_relaxed);
+
+			if (h == tail.load(std::memory_order_acquire))
+				return nullptr;
+
+			return &slots[h & (N - 1)];
+		}
+
+		// Consumer: Release the slot returned by front() to the producer
+		void pop()
+		{
+			head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		// Discard all elements, only allowed while neither thread is using the queue
+		void clear()
+		{
+			head.store(0);
+			tail.store(0);
+		}
+
+		bool empty() const
+		{
+			return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+		}
+
+	private:
+		T slots[N];
+		// Keep the two indices on separate cache lines so the threads do not contend
+		alignas(64) std::atomic<size_t> head;
+		alignas(64) std::atomic<size_t> tail;
+	};
+}
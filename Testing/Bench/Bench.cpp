@@ -0,0 +1,105 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "Bench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+namespace ms {
+namespace Bench {
+
+void Samples::reserve(size_t count) {
+    values.reserve(count);
+}
+
+void Samples::add(int64_t nanoseconds) {
+    values.push_back(nanoseconds);
+    sorted = false;
+}
+
+size_t Samples::size() const {
+    return values.size();
+}
+
+int64_t Samples::mean() const {
+    if (values.empty())
+        return 0;
+
+    int64_t total = 0;
+
+    for (int64_t value : values)
+        total += value;
+
+    return total / static_cast<int64_t>(values.size());
+}
+
+int64_t Samples::percentile(double fraction) {
+    if (values.empty())
+        return 0;
+
+    if (!sorted) {
+        std::sort(values.begin(), values.end());
+        sorted = true;
+    }
+
+    // Nearest rank, so p100 is the maximum and p0 the minimum
+    size_t rank = static_cast<size_t>(std::ceil(fraction * values.size()));
+    size_t index = rank > 0 ? rank - 1 : 0;
+
+    return values[std::min(index, values.size() - 1)];
+}
+
+namespace {
+    const int NAME_WIDTH = 20;
+    const int COLUMN_WIDTH = 12;
+
+    void column(std::ostream& out, int64_t nanoseconds) {
+        out << std::setw(COLUMN_WIDTH) << std::fixed << std::setprecision(1) << nanoseconds / 1000.0;
+    }
+}
+
+void print_header(std::ostream& out) {
+    out << std::left << std::setw(NAME_WIDTH) << "scenario" << std::right
+        << std::setw(COLUMN_WIDTH) << "samples"
+        << std::setw(COLUMN_WIDTH) << "mean us"
+        << std::setw(COLUMN_WIDTH) << "p50 us"
+        << std::setw(COLUMN_WIDTH) << "p90 us"
+        << std::setw(COLUMN_WIDTH) << "p99 us"
+        << std::setw(COLUMN_WIDTH) << "max us" << std::endl;
+}
+
+void print_results(std::ostream& out, Results& results) {
+    for (auto& result : results) {
+        Samples& samples = result.second;
+
+        out << std::left << std::setw(NAME_WIDTH) << result.first << std::right
+            << std::setw(COLUMN_WIDTH) << samples.size();
+
+        column(out, samples.mean());
+        column(out, samples.percentile(0.5));
+        column(out, samples.percentile(0.9));
+        column(out, samples.percentile(0.99));
+        column(out, samples.percentile(1.0));
+
+        out << std::endl;
+    }
+}
+
+} // namespace Bench
+} // namespace ms
@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ms {
+namespace Bench {
+
+// Durations measured by a scenario, in nanoseconds
+class Samples {
+public:
+    void reserve(size_t count);
+    void add(int64_t nanoseconds);
+
+    size_t size() const;
+    int64_t mean() const;
+    // Return the sample which the given fraction of all samples does not exceed
+    int64_t percentile(double fraction);
+
+private:
+    std::vector<int64_t> values;
+    bool sorted = true;
+};
+
+// Run a function once and return how long it took
+template <typename F>
+int64_t measure(F&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+struct Options {
+    size_t iterations = 1000;
+    int32_t mapid = 100000000;
+    int32_t mobid = 100100;
+    size_t mobs = 200;
+    std::string replay;
+};
+
+// Each scenario reports one or more rows of samples
+using Results = std::vector<std::pair<std::string, Samples>>;
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    // Whether the scenario needs the NX files
+    bool nx;
+    // Return false with a reason if the scenario cannot run
+    std::function<bool(const Options&, Results&, std::string&)> run;
+};
+
+// Print a header and one row per result with the mean and the percentiles in microseconds
+void print_header(std::ostream& out);
+void print_results(std::ostream& out, Results& results);
+
+} // namespace Bench
+} // namespace ms
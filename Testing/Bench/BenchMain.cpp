@@ -0,0 +1,561 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "Bench.h"
+
+#include "../../Character/Char.h"
+#include "../../Gameplay/Combat/DamageNumber.h"
+#include "../../Gameplay/MapleMap/MapPrefetcher.h"
+#include "../../Gameplay/Stage.h"
+#include "../../IO/UI.h"
+#include "../../IO/Window.h"
+#include "../../Net/Cryptography.h"
+#include "../../Net/PacketCapture.h"
+#include "../../Net/PacketSwitch.h"
+#include "../../Net/ReceiveBuffer.h"
+#include "../../Net/SendBuffer.h"
+#include "../../Util/NxFiles.h"
+
+#include <nlnx/file.hpp>
+#include <nlnx/nx.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+// Runs named scenarios against the game code without a window, sound or server
+// Usage: bench [options] [scenario...], all scenarios run when none are named.
+namespace ms {
+namespace Bench {
+
+namespace {
+    const int16_t PING = 17;
+    const size_t BURST = 64;
+    const size_t LENGTHS[] = { 2, 16, 64, 256, 1500 };
+
+    const int8_t HANDSHAKE[16] = {
+        0x0E, 0x00, 0x53, 0x00, 0x01, 0x00, 0x31,
+        0x46, 0x72, 0x7A, 0x18,
+        0x52, 0x30, 0x78, 0x14,
+        0x08
+    };
+
+    // Cryptography of the server, which receives with the iv the client sends with
+    Cryptography server_cryptography() {
+        int8_t swapped[16];
+        std::memcpy(swapped, HANDSHAKE, 16);
+
+        for (size_t i = 0; i < HEADER_LENGTH; i++) {
+            swapped[i + 7] = HANDSHAKE[i + 11];
+            swapped[i + 11] = HANDSHAKE[i + 7];
+        }
+
+        return Cryptography(swapped);
+    }
+
+    std::vector<std::vector<int8_t>> burst() {
+        std::vector<std::vector<int8_t>> packets;
+
+        for (size_t i = 0; i < BURST; i++) {
+            std::vector<int8_t> bytes(LENGTHS[i % 5]);
+
+            for (size_t j = 0; j < bytes.size(); j++)
+                bytes[j] = static_cast<int8_t>(i + j * 7);
+
+            packets.push_back(bytes);
+        }
+
+        return packets;
+    }
+
+    // Encrypt and decrypt a burst of packets of mixed sizes
+    bool crypto(const Options& options, Results& results, std::string&) {
+        Cryptography client(HANDSHAKE);
+        Cryptography server = server_cryptography();
+        auto packets = burst();
+
+        Samples samples;
+        samples.reserve(options.iterations);
+
+        for (size_t i = 0; i < options.iterations; i++) {
+            samples.add(measure([&]() {
+                for (auto& packet : packets) {
+                    client.encrypt(packet.data(), packet.size());
+                    server.decrypt(packet.data(), packet.size());
+                }
+            }));
+        }
+
+        results.emplace_back("crypto", std::move(samples));
+
+        return true;
+    }
+
+    // Batch a burst like a frame's worth of packets, then frame and decrypt it on the other side
+    bool framing(const Options& options, Results& results, std::string&) {
+        Cryptography client(HANDSHAKE);
+        Cryptography server = server_cryptography();
+        auto packets = burst();
+        auto sendbuffer = std::make_unique<SendBuffer>();
+        auto receivebuffer = std::make_unique<ReceiveBuffer>();
+
+        Samples samples;
+        samples.reserve(options.iterations);
+
+        for (size_t i = 0; i < options.iterations; i++) {
+            samples.add(measure([&]() {
+                for (auto& packet : packets)
+                    sendbuffer->append(client, packet.data(), packet.size());
+
+                size_t offset = 0;
+
+                while (offset < sendbuffer->size()) {
+                    size_t available;
+                    int8_t* bytes = receivebuffer->reserve(available);
+                    size_t count = std::min(available, sendbuffer->size() - offset);
+
+                    std::memcpy(bytes, sendbuffer->data() + offset, count);
+                    receivebuffer->commit(count);
+                    offset += count;
+
+                    size_t length;
+
+                    while (int8_t* next = receivebuffer->next(server, length))
+                        server.decrypt(next, length);
+                }
+
+                sendbuffer->clear();
+            }));
+        }
+
+        results.emplace_back("framing", std::move(samples));
+
+        return true;
+    }
+
+    // Forward a burst of pings through the opcode table, each handler answers with a pong
+    bool dispatch(const Options& options, Results& results, std::string&) {
+        auto packetswitch = std::make_unique<PacketSwitch>();
+        std::vector<int8_t> ping = { static_cast<int8_t>(PING), 0 };
+
+        Samples samples;
+        samples.reserve(options.iterations);
+
+        for (size_t i = 0; i < options.iterations; i++) {
+            samples.add(measure([&]() {
+                for (size_t j = 0; j < BURST; j++)
+                    packetswitch->forward(ping.data(), ping.size());
+            }));
+        }
+
+        results.emplace_back("dispatch", std::move(samples));
+
+        return true;
+    }
+
+    int64_t nxtime = 0;
+
+    // Load the NX files and set the game up like for playing, only done once
+    bool init_game(std::string& reason) {
+        static bool initialized = false;
+        static std::string error;
+
+        if (initialized) {
+            reason = error;
+
+            return error.empty();
+        }
+
+        initialized = true;
+
+        Error nxerror = Error::Code::NONE;
+        nxtime = measure([&]() { nxerror = NxFiles::init(); });
+
+        if (nxerror) {
+            error = std::string(nxerror.get_message()) + nxerror.get_args();
+            reason = error;
+
+            return false;
+        }
+
+        Char::init();
+        DamageNumber::init();
+        MapPortals::init();
+        Stage::get().init();
+        UI::get().init();
+
+        return true;
+    }
+
+    // Open the NX files, then reload a map from them
+    bool mapload(const Options& options, Results& results, std::string& reason) {
+        if (!init_game(reason))
+            return false;
+
+        Samples nx;
+        nx.add(nxtime);
+        results.emplace_back("nx-init", std::move(nx));
+
+        // Files are opened in parallel, so these add up to more than nx-init
+        for (auto& time : nl::nx::load_times()) {
+            Samples file;
+            file.add(time.microseconds * 1000);
+            results.emplace_back("nx-open-" + time.name, std::move(file));
+        }
+
+        Samples samples;
+        samples.reserve(options.iterations);
+
+        for (size_t i = 0; i < options.iterations; i++) {
+            Stage::get().clear();
+
+            samples.add(measure([&]() { Stage::get().load(options.mapid, 0); }));
+        }
+
+        results.emplace_back("mapload", std::move(samples));
+
+        return true;
+    }
+
+    // Opening an NX file builds its bitmap table on a cold start, which is slow enough to cap the samples
+    const size_t NXSTART_ITERATIONS = 20;
+
+    // Open every NX file present without and with the bitmap table sidecars
+    // Only the sidecars are removed between samples, the operating system's page cache stays warm.
+    bool nxstart(const Options& options, Results& results, std::string& reason) {
+        std::vector<std::string> present;
+
+        for (auto filename : NxFiles::filenames)
+            if (std::filesystem::exists(filename))
+                present.push_back(filename);
+
+        if (present.empty()) {
+            reason = "no NX files in the working directory";
+
+            return false;
+        }
+
+        size_t iterations = std::min(options.iterations, NXSTART_ITERATIONS);
+
+        Samples cold;
+        Samples warm;
+        cold.reserve(iterations);
+        warm.reserve(iterations);
+
+        for (size_t i = 0; i < iterations; i++) {
+            for (auto& filename : present) {
+                std::error_code error;
+                std::filesystem::remove(nl::file::bitmap_sidecar(filename), error);
+            }
+
+            cold.add(measure([&]() {
+                for (auto& filename : present)
+                    nl::file file(filename);
+            }));
+
+            warm.add(measure([&]() {
+                for (auto& filename : present)
+                    nl::file file(filename);
+            }));
+        }
+
+        results.emplace_back("nx-cold", std::move(cold));
+        results.emplace_back("nx-warm", std::move(warm));
+
+        return true;
+    }
+
+    // Every warp loads a whole map, which is slow enough to cap the samples
+    const size_t WARP_ITERATIONS = 20;
+
+    // Warp to the maps behind the portals of a map, cold, staged over frames and after the prefetcher prepared them
+    bool warp(const Options& options, Results& results, std::string& reason) {
+        if (!init_game(reason))
+            return false;
+
+        std::vector<int32_t> targets = MapPortals(Stage::find_map(options.mapid)["portal"], options.mapid).get_target_maps();
+
+        if (targets.empty()) {
+            reason = "map " + std::to_string(options.mapid) + " has no portals to other maps";
+
+            return false;
+        }
+
+        Stage& stage = Stage::get();
+        MapPrefetcher& prefetcher = MapPrefetcher::get();
+        size_t iterations = std::min(options.iterations, WARP_ITERATIONS);
+
+        Samples cold;
+        Samples staged;
+        Samples prefetched;
+        cold.reserve(iterations);
+        prefetched.reserve(iterations);
+
+        for (size_t i = 0; i < iterations; i++) {
+            int32_t target = targets[i % targets.size()];
+
+            prefetcher.clear();
+            stage.clear();
+            cold.add(measure([&]() { stage.load(target, 0); }));
+
+            // Every sample is the slice of one frame
+            prefetcher.clear();
+            stage.clear();
+            stage.load_staged(target, 0);
+
+            while (stage.is_loading())
+                staged.add(measure([&]() { stage.continue_load(); }));
+
+            // Loading the map starts preparing the maps behind its portals
+            prefetcher.clear();
+            stage.clear();
+            stage.load(options.mapid, 0);
+
+            for (int waited = 0; prefetcher.get_ready() < targets.size() && waited < 10000; waited++)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            stage.clear();
+            prefetched.add(measure([&]() { stage.load(target, 0); }));
+        }
+
+        prefetcher.clear();
+        stage.clear();
+
+        results.emplace_back("warp-cold", std::move(cold));
+        results.emplace_back("warp-staged", std::move(staged));
+        results.emplace_back("warp-prefetched", std::move(prefetched));
+
+        return true;
+    }
+
+    // Update a map crowded with controlled mobs, which walk, fall and collide with the player
+    bool mobs(const Options& options, Results& results, std::string& reason) {
+        if (!init_game(reason))
+            return false;
+
+        Stage& stage = Stage::get();
+        stage.clear();
+        stage.load(options.mapid, 0);
+
+        Point<int16_t> center = stage.get_player().get_position();
+
+        for (size_t i = 0; i < options.mobs; i++) {
+            int16_t x = static_cast<int16_t>(center.x() + (i % 40) * 20 - 400);
+            int16_t y = static_cast<int16_t>(center.y() - 50);
+
+            stage.get_mobs().spawn(MobSpawn(static_cast<int32_t>(1000 + i), options.mobid, 1, 0, 0, false, -1, Point<int16_t>(x, y)));
+        }
+
+        // The first update creates the mobs
+        stage.update();
+
+        Samples samples;
+        samples.reserve(options.iterations);
+
+        for (size_t i = 0; i < options.iterations; i++)
+            samples.add(measure([&]() { stage.update(); }));
+
+        results.emplace_back("mobs-" + std::to_string(options.mobs), std::move(samples));
+
+        stage.clear();
+
+        return true;
+    }
+
+    // Replay a capture as fast as possible, timing every update and every packet handler
+    bool replay(const Options& options, Results& results, std::string& reason) {
+        if (options.replay.empty()) {
+            reason = "no capture given with --replay";
+
+            return false;
+        }
+
+        PacketReplay capture;
+
+        if (!capture.load(options.replay)) {
+            reason = "failed to load " + options.replay;
+
+            return false;
+        }
+
+        if (!init_game(reason))
+            return false;
+
+        auto packetswitch = std::make_unique<PacketSwitch>();
+        Samples updates;
+        Samples packets;
+
+        updates.reserve(options.iterations);
+        packets.reserve(capture.get_packets().size());
+
+        capture.run(
+            [&](const int8_t* bytes, size_t length) {
+                packets.add(measure([&]() { packetswitch->forward(bytes, length); }));
+            },
+            [&]() {
+                updates.add(measure([]() {
+                    Window::get().update();
+                    Stage::get().continue_load();
+                    Stage::get().update();
+                    UI::get().update();
+                }));
+            },
+            PacketReplay::Speed::FAST
+        );
+
+        results.emplace_back("replay-update", std::move(updates));
+        results.emplace_back("replay-packet", std::move(packets));
+
+        return true;
+    }
+
+    const Scenario SCENARIOS[] = {
+        { "crypto", "encrypt and decrypt 64 packets of mixed sizes", false, crypto },
+        { "framing", "batch, frame and decrypt 64 packets", false, framing },
+        { "dispatch", "forward 64 pings through the packet switch", false, dispatch },
+        { "nxstart", "open the NX files with and without bitmap table sidecars", true, nxstart },
+        { "mapload", "open the NX files and reload a map", true, mapload },
+        { "warp", "warp through the portals of a map, cold, staged and prefetched", true, warp },
+        { "mobs", "update a map crowded with controlled mobs", true, mobs },
+        { "replay", "replay a packet capture without waiting", true, replay }
+    };
+
+    void usage() {
+        std::cout << "Usage: bench [options] [scenario...]" << std::endl;
+        std::cout << std::endl;
+        std::cout << "Options:" << std::endl;
+        std::cout << "  --iterations <n>   Samples per scenario (default: 1000)" << std::endl;
+        std::cout << "  --data <dir>       Directory with the NX files (default: working directory)" << std::endl;
+        std::cout << "  --map <id>         Map to load (default: 100000000)" << std::endl;
+        std::cout << "  --mob <id>         Mob to spawn (default: 100100)" << std::endl;
+        std::cout << "  --mobs <n>         Number of mobs to spawn (default: 200)" << std::endl;
+        std::cout << "  --replay <file>    Packet capture for the replay scenario" << std::endl;
+        std::cout << "  --verbose          Keep the game's own output" << std::endl;
+        std::cout << "  --list             List the scenarios" << std::endl;
+    }
+
+    void list() {
+        for (const Scenario& scenario : SCENARIOS)
+            std::cout << "  " << scenario.name << (scenario.nx ? " (needs NX files)" : "") << ": " << scenario.description << std::endl;
+    }
+
+    const Scenario* find(const std::string& name) {
+        for (const Scenario& scenario : SCENARIOS)
+            if (name == scenario.name)
+                return &scenario;
+
+        return nullptr;
+    }
+}
+
+} // namespace Bench
+} // namespace ms
+
+int main(int argc, char* argv[]) {
+    using namespace ms::Bench;
+
+    Options options;
+    std::vector<const Scenario*> selected;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--help") {
+            usage();
+            return 0;
+        }
+        else if (arg == "--list") {
+            list();
+            return 0;
+        }
+        else if (arg == "--iterations" && i + 1 < argc) {
+            options.iterations = std::stoul(argv[++i]);
+        }
+        else if (arg == "--data" && i + 1 < argc) {
+            std::error_code error;
+            std::filesystem::current_path(argv[++i], error);
+
+            if (error) {
+                std::cerr << "Failed to change to " << argv[i] << ": " << error.message() << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--map" && i + 1 < argc) {
+            options.mapid = std::stoi(argv[++i]);
+        }
+        else if (arg == "--mob" && i + 1 < argc) {
+            options.mobid = std::stoi(argv[++i]);
+        }
+        else if (arg == "--mobs" && i + 1 < argc) {
+            options.mobs = std::stoul(argv[++i]);
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            options.replay = argv[++i];
+        }
+        else if (arg == "--verbose") {
+            verbose = true;
+        }
+        else if (const Scenario* scenario = find(arg)) {
+            selected.push_back(scenario);
+        }
+        else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            usage();
+            return 1;
+        }
+    }
+
+    bool all = selected.empty();
+
+    if (all)
+        for (const Scenario& scenario : SCENARIOS)
+            selected.push_back(&scenario);
+
+    // The game logs to std::cout, the report gets its own stream so it can be kept apart
+    std::ostream report(std::cout.rdbuf());
+
+    if (!verbose)
+        std::cout.rdbuf(nullptr);
+
+    print_header(report);
+
+    int failed = 0;
+
+    for (const Scenario* scenario : selected) {
+        Results results;
+        std::string reason;
+
+        if (scenario->run(options, results, reason)) {
+            print_results(report, results);
+        }
+        else {
+            report << scenario->name << " skipped: " << reason << std::endl;
+
+            // Skipping is expected when running everything without game data
+            if (!all)
+                failed++;
+        }
+    }
+
+    std::cout.rdbuf(report.rdbuf());
+
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,127 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../../Graphics/GraphicsGL.h"
+#include "../../IO/Window.h"
+
+// Stand-ins for the OpenGL renderer and the GLFW window, nothing is drawn
+// Textures still read their dimensions from the NX files, so layout and culling behave as in the game.
+namespace ms {
+
+bool GraphicsGL::alive = false;
+
+GraphicsGL::GraphicsGL() {
+    alive = true;
+}
+
+GraphicsGL::~GraphicsGL() {
+    alive = false;
+}
+
+Error GraphicsGL::init() {
+    return Error::Code::NONE;
+}
+
+void GraphicsGL::reinit() {}
+void GraphicsGL::clear() {}
+void GraphicsGL::addbitmap(const nl::bitmap&) {}
+void GraphicsGL::draw(const nl::bitmap&, const Rectangle<int16_t>&, const Range<int16_t>&, const Range<int16_t>&, const Color&, float) {}
+
+Text::Layout GraphicsGL::createlayout(const std::string&, Text::Font, Text::Alignment, Color::Name, int16_t, bool, int16_t) {
+    return Text::Layout();
+}
+
+void GraphicsGL::cull(size_t) {}
+
+size_t GraphicsGL::beginblock() {
+    return 0;
+}
+
+void GraphicsGL::endblock() {}
+void GraphicsGL::drawblock(size_t, Point<int16_t>) {}
+void GraphicsGL::releaseblock(size_t) {}
+
+bool GraphicsGL::is_alive() {
+    return alive;
+}
+
+void GraphicsGL::drawtext(const DrawArgument&, const Range<int16_t>&, const std::string&, const Text::Layout&, Text::Font, Color::Name, Text::Background) {}
+void GraphicsGL::drawrectangle(int16_t, int16_t, int16_t, int16_t, float, float, float, float) {}
+void GraphicsGL::drawscreenfill(float, float, float, float) {}
+void GraphicsGL::move_camera(int16_t, int16_t) {}
+void GraphicsGL::reset_camera() {}
+void GraphicsGL::clear_atlas_cache() {}
+void GraphicsGL::toggle_debug_mode() {}
+void GraphicsGL::lock() {}
+void GraphicsGL::unlock() {}
+void GraphicsGL::flush(float) {}
+void GraphicsGL::clearscene() {}
+
+std::vector<GraphicsGL::AtlasInfo> GraphicsGL::get_atlas_info() const {
+    return {};
+}
+
+void GraphicsGL::log_atlas_info() const {}
+
+GraphicsGL::SpriteCounts GraphicsGL::get_sprite_counts() const {
+    return { 0, 0, 0 };
+}
+
+Window::Window() : glwnd(nullptr), context(nullptr), fullscreen(false), opacity(1.0f), opcstep(0.0f), holding(false), width(0), height(0) {}
+
+Window::~Window() {}
+
+Error Window::init() {
+    return Error::Code::NONE;
+}
+
+Error Window::initwindow() {
+    return Error::Code::NONE;
+}
+
+bool Window::not_closed() const {
+    return true;
+}
+
+// Holds end as soon as their procedure is done, there is no fade in to wait for
+void Window::update() {
+    if (holdprocedure && holdprocedure())
+        holdprocedure = nullptr;
+}
+
+void Window::begin() const {}
+void Window::end() const {}
+
+// There is nothing to fade, so the procedure runs right away
+void Window::fadeout(float, std::function<void()> fadeproc, std::function<bool()> holdproc) {
+    holdprocedure = holdproc;
+
+    if (fadeproc)
+        fadeproc();
+}
+
+void Window::check_events() {}
+void Window::setclipboard(const std::string&) const {}
+
+std::string Window::getclipboard() const {
+    return "";
+}
+
+void Window::toggle_fullscreen() {}
+void Window::updateopc() {}
+
+} // namespace ms
@@ -0,0 +1,52 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../../Net/SocketWinsock.h"
+
+// Stand-in for the Winsock connection, the benchmarks never reach a server
+// Opening always fails, so Session stays disconnected and packets only go through the send batch.
+namespace ms {
+
+bool SocketWinsock::open(const char*, const char*) {
+    sock = 0;
+
+    return false;
+}
+
+bool SocketWinsock::close() {
+    return true;
+}
+
+bool SocketWinsock::dispatch(const int8_t*, size_t) const {
+    return false;
+}
+
+size_t SocketWinsock::receive(int8_t*, size_t, bool* connected) {
+    *connected = false;
+
+    return 0;
+}
+
+bool SocketWinsock::wait(int32_t) const {
+    return false;
+}
+
+const int8_t* SocketWinsock::get_buffer() const {
+    return buffer;
+}
+
+} // namespace ms
@@ -0,0 +1,184 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "LoopbackServer.h"
+
+#include <chrono>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#pragma comment (lib, "Ws2_32.lib")
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    // Length, version, patch location and the two initialization vectors, as sent by the server
+    const int8_t HANDSHAKE[16] = {
+        0x0E, 0x00, 0x53, 0x00, 0x01, 0x00, 0x31,
+        0x46, 0x72, 0x7A, 0x18,
+        0x52, 0x30, 0x78, 0x14,
+        0x08
+    };
+
+    // The server sends with the iv the client receives with and the other way around
+    Cryptography serverCryptography() {
+        int8_t swapped[16];
+
+        for (size_t i = 0; i < 16; i++)
+            swapped[i] = HANDSHAKE[i];
+
+        for (size_t i = 0; i < HEADER_LENGTH; i++) {
+            swapped[i + 7] = HANDSHAKE[i + 11];
+            swapped[i + 11] = HANDSHAKE[i + 7];
+        }
+
+        return Cryptography(swapped);
+    }
+}
+
+LoopbackServer::LoopbackServer() :
+    listener_(INVALID_SOCKET), client_(INVALID_SOCKET), connected_(false),
+    cryptography_(serverCryptography()), buffer_(std::make_unique<ReceiveBuffer>()) {}
+
+LoopbackServer::~LoopbackServer() {
+    stop();
+}
+
+bool LoopbackServer::start() {
+    WSADATA wsa_info;
+
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_info) != 0)
+        return false;
+
+    listener_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+    if (listener_ == INVALID_SOCKET)
+        return false;
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = 0;
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+    if (bind(listener_, (sockaddr*)&address, sizeof(address)) == SOCKET_ERROR || listen(listener_, 1) == SOCKET_ERROR)
+        return false;
+
+    int length = sizeof(address);
+    getsockname(listener_, (sockaddr*)&address, &length);
+    port_ = std::to_string(ntohs(address.sin_port));
+
+    acceptor_ = std::thread(&LoopbackServer::accept, this);
+
+    return true;
+}
+
+void LoopbackServer::accept() {
+    uint64_t client = ::accept(listener_, nullptr, nullptr);
+
+    if (client == INVALID_SOCKET)
+        return;
+
+    client_ = client;
+    ::send(client_, (const char*)HANDSHAKE, sizeof(HANDSHAKE), 0);
+    connected_ = true;
+}
+
+void LoopbackServer::stop() {
+    if (client_ != INVALID_SOCKET) {
+        closesocket(client_);
+        client_ = INVALID_SOCKET;
+    }
+
+    if (listener_ != INVALID_SOCKET) {
+        closesocket(listener_);
+        listener_ = INVALID_SOCKET;
+
+        WSACleanup();
+    }
+
+    if (acceptor_.joinable())
+        acceptor_.join();
+
+    connected_ = false;
+}
+
+const std::string& LoopbackServer::getPort() const {
+    return port_;
+}
+
+bool LoopbackServer::waitForClient(int timeout_ms) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    while (!connected_ && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    return connected_;
+}
+
+bool LoopbackServer::send(const std::vector<std::vector<int8_t>>& packets) {
+    std::vector<int8_t> burst;
+
+    for (std::vector<int8_t> packet : packets) {
+        int8_t header[HEADER_LENGTH];
+        cryptography_.create_header(header, packet.size());
+        cryptography_.encrypt(packet.data(), packet.size());
+
+        burst.insert(burst.end(), header, header + HEADER_LENGTH);
+        burst.insert(burst.end(), packet.begin(), packet.end());
+    }
+
+    return ::send(client_, (const char*)burst.data(), static_cast<int>(burst.size()), 0) == static_cast<int>(burst.size());
+}
+
+std::vector<std::vector<int8_t>> LoopbackServer::receive(size_t count, int timeout_ms) {
+    std::vector<std::vector<int8_t>> packets;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    while (packets.size() < count && std::chrono::steady_clock::now() < deadline) {
+        timeval timeout = { 0, 10000 };
+        fd_set sockset = { 0 };
+        FD_SET(client_, &sockset);
+
+        if (select(0, &sockset, 0, 0, &timeout) > 0) {
+            size_t available;
+            int8_t* bytes = buffer_->reserve(available);
+            int result = recv(client_, (char*)bytes, static_cast<int>(available), 0);
+
+            if (result <= 0)
+                break;
+
+            buffer_->commit(result);
+        }
+
+        size_t length;
+
+        while (int8_t* packet = buffer_->next(cryptography_, length)) {
+            cryptography_.decrypt(packet, length);
+            packets.emplace_back(packet, packet + length);
+        }
+    }
+
+    return packets;
+}
+
+const int8_t* LoopbackServer::handshake() {
+    return HANDSHAKE;
+}
+
+}
+}
@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "../Net/Cryptography.h"
+#include "../Net/ReceiveBuffer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ms {
+namespace Testing {
+
+// A server on the loopback interface which stands in for the game server
+// It accepts a single client, sends the handshake and then exchanges encrypted packets.
+class LoopbackServer {
+public:
+    LoopbackServer();
+    ~LoopbackServer();
+
+    // Listen on a free port and accept the client in the background
+    bool start();
+    // Close the listening socket and the client connection
+    void stop();
+
+    // Return the port the server listens on
+    const std::string& getPort() const;
+    // Wait until the client is connected and has received the handshake
+    bool waitForClient(int timeout_ms);
+
+    // Encrypt the packets and send them with a single write, as a burst
+    bool send(const std::vector<std::vector<int8_t>>& packets);
+    // Receive and decrypt packets from the client until count arrived or the timeout elapsed
+    std::vector<std::vector<int8_t>> receive(size_t count, int timeout_ms);
+
+    // Return a handshake with fixed initialization vectors
+    static const int8_t* handshake();
+
+private:
+    void accept();
+
+    uint64_t listener_;
+    uint64_t client_;
+    std::string port_;
+    std::thread acceptor_;
+    std::atomic<bool> connected_;
+
+    Cryptography cryptography_;
+    std::unique_ptr<ReceiveBuffer> buffer_;
+};
+
+}
+}
@@ -0,0 +1,63 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace ms {
+namespace Testing {
+
+// Write a value at an offset of a byte buffer, in the byte order of the machine like the NX reader
+template <typename T>
+void put(std::vector<char>& bytes, size_t offset, T value) {
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+// Builds a synthetic NX file byte by byte, for tests of the NX reader
+class NxFixture {
+public:
+    explicit NxFixture(size_t size) : bytes_(size, 0) {}
+
+    // The PKG4 header with the counts and offsets of the node and string tables
+    void header(uint32_t nodes, uint64_t nodeOffset, uint32_t strings, uint64_t stringOffset) {
+        put<uint32_t>(0, 0x34474B50);
+        put<uint32_t>(4, nodes);
+        put<uint64_t>(8, nodeOffset);
+        put<uint32_t>(16, strings);
+        put<uint64_t>(20, stringOffset);
+    }
+
+    template <typename T>
+    void put(size_t offset, T value) {
+        Testing::put<T>(bytes_, offset, value);
+    }
+
+    void save(const char* path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes_.data(), bytes_.size());
+    }
+
+private:
+    std::vector<char> bytes_;
+};
+
+} // namespace Testing
+} // namespace ms
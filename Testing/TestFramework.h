@@ -22,6 +22,7 @@
 #include <memory>
 #include <functional>
 #include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <sstream>
 
@@ -37,6 +38,11 @@ enum class TestStatus {
     TIMEOUT
 };
 
+// Nanoseconds elapsed since start, for the timings which tests log
+inline int64_t nanosecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 struct TestResult {
     std::string name;
     TestStatus status;
@@ -18,6 +18,10 @@
 #include "TestFramework.h"
 #include "HeadlessMode.h"
 #include "../Configuration.h"
+#include "../Gameplay/Stage.h"
+#include "../IO/UI.h"
+#include "../Net/PacketCapture.h"
+#include "../Net/PacketSwitch.h"
 #include "../Util/NxFiles.h"
 #include <iostream>
 #include <string>
@@ -37,12 +41,61 @@ void printUsage() {
     std::cout << "  --test-list           List all available tests" << std::endl;
     std::cout << "  --test-timeout <ms>   Set test timeout in milliseconds (default: 30000)" << std::endl;
     std::cout << "  --test-graphics       Enable graphics during tests" << std::endl;
+    std::cout << "  --test-replay <file>  Replay a packet capture and report the time spent" << std::endl;
+    std::cout << "  --test-replay-fast    Replay without waiting between updates" << std::endl;
     std::cout << "  --test-help           Show this help message" << std::endl;
     std::cout << std::endl;
     std::cout << "Examples:" << std::endl;
     std::cout << "  MapleStory.exe --test" << std::endl;
     std::cout << "  MapleStory.exe --test-suite MapLoading" << std::endl;
     std::cout << "  MapleStory.exe --test-case MapLoading LoadHenesys" << std::endl;
+    std::cout << "  MapleStory.exe --test-replay bossfight.mspc --test-replay-fast" << std::endl;
+}
+
+int runReplay(const std::string& path, bool fast) {
+    using namespace ms;
+
+    PacketReplay replay;
+
+    if (!replay.load(path)) {
+        std::cerr << "Failed to load packet capture: " << path << std::endl;
+        return 1;
+    }
+
+    // The game is set up like for playing, but without a connection, window or sound
+    Error nxError = NxFiles::init();
+    if (nxError) {
+        std::cerr << "Failed to initialize NX files: " << nxError.get_message() << std::endl;
+        return 1;
+    }
+
+    Char::init();
+    DamageNumber::init();
+    MapPortals::init();
+    Stage::get().init();
+    UI::get().init();
+
+    auto packetswitch = std::make_unique<PacketSwitch>();
+
+    PacketReplay::Result result = replay.run(
+        [&packetswitch](const int8_t* bytes, size_t length) {
+            packetswitch->forward(bytes, length);
+        },
+        []() {
+            Stage::get().update();
+            UI::get().update();
+        },
+        fast ? PacketReplay::Speed::FAST : PacketReplay::Speed::REALTIME
+    );
+
+    std::cout << "Replayed " << result.packets << " packets in " << result.updates << " updates" << std::endl;
+    std::cout << "Elapsed: " << result.elapsed / 1000 << " ms, busy: " << result.busy / 1000 << " ms" << std::endl;
+    std::cout << "Average update: " << result.busy / std::max<size_t>(result.updates, 1) << " us, slowest: " << result.slowest << " us" << std::endl;
+    std::cout << std::endl;
+
+    packetswitch->dump_profile(std::cout);
+
+    return 0;
 }
 
 void listTests() {
@@ -75,6 +128,8 @@ int runTests(int argc, char* argv[]) {
     std::string suiteName;
     std::string testName;
     int timeout = 30000;
+    std::string replayPath;
+    bool replayFast = false;
     
     for (int i = 2; i < argc; i++) {
         std::string arg = argv[i];
@@ -100,7 +155,16 @@ int runTests(int argc, char* argv[]) {
         else if (arg == "--test-graphics") {
             enableGraphics = true;
         }
+        else if (arg == "--test-replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        }
+        else if (arg == "--test-replay-fast") {
+            replayFast = true;
+        }
     }
+
+    if (!replayPath.empty())
+        return runReplay(replayPath, replayFast);
     
     std::cout << "Initializing test environment..." << std::endl;
     
@@ -0,0 +1,220 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../TestFramework.h"
+#include "../../Graphics/BitmapDecoder.h"
+
+#include <nlnx/node.hpp>
+#include <nlnx/nx.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    const size_t MAX_BITMAPS = 4096;
+
+    void collectBitmaps(nl::node node, std::vector<nl::bitmap>& bitmaps) {
+        if (bitmaps.size() >= MAX_BITMAPS)
+            return;
+
+        if (node.data_type() == nl::node::type::bitmap) {
+            nl::bitmap bmp = node;
+
+            if (bmp)
+                bitmaps.push_back(bmp);
+        }
+
+        for (nl::node child : node) {
+            collectBitmaps(child, bitmaps);
+
+            if (bitmaps.size() >= MAX_BITMAPS)
+                return;
+        }
+    }
+
+    double megabytesPerSecond(size_t bytes, std::chrono::microseconds elapsed) {
+        if (elapsed.count() == 0)
+            return 0.0;
+
+        return (bytes / (1024.0 * 1024.0)) / (elapsed.count() / 1000000.0);
+    }
+}
+
+TEST(BitmapDecode, Throughput) {
+    std::vector<nl::bitmap> bitmaps;
+    collectBitmaps(nl::nx::Map["Back"], bitmaps);
+    collectBitmaps(nl::nx::Map["Obj"], bitmaps);
+
+    if (bitmaps.empty())
+        skip("Map.nx has no bitmaps, is the file present?");
+
+    size_t bytes = 0;
+
+    for (const nl::bitmap& bmp : bitmaps)
+        bytes += bmp.length();
+
+    // Decompress everything on this thread, as the render thread used to
+    auto start = std::chrono::steady_clock::now();
+
+    for (const nl::bitmap& bmp : bitmaps)
+        bmp.data();
+
+    auto serial = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    // Decompress everything on the worker pool
+    BitmapDecoder decoder;
+
+    start = std::chrono::steady_clock::now();
+
+    for (const nl::bitmap& bmp : bitmaps)
+        decoder.enqueue(bmp);
+
+    decoder.wait();
+
+    auto pooled = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    size_t decoded_count = 0;
+    size_t mismatches = 0;
+    BitmapDecoder::Decoded decoded;
+
+    while (decoder.poll(decoded)) {
+        if (decoded.pixels.size() != decoded.bitmap.length())
+            mismatches++;
+        else if (decoded_count < 64 && std::memcmp(decoded.pixels.data(), decoded.bitmap.data(), decoded.pixels.size()) != 0)
+            mismatches++;
+
+        decoded_count++;
+        decoder.recycle(std::move(decoded.pixels));
+    }
+
+    std::stringstream ss;
+    ss << bitmaps.size() << " bitmaps, " << bytes / (1024 * 1024) << " MB decompressed";
+    log(ss.str());
+
+    ss.str("");
+    ss << "Render thread: " << megabytesPerSecond(bytes, serial) << " MB/s";
+    log(ss.str());
+
+    ss.str("");
+    ss << decoder.get_threads() << " decoder threads: " << megabytesPerSecond(bytes, pooled) << " MB/s";
+    log(ss.str());
+
+    assertEqual(static_cast<int>(bitmaps.size()), static_cast<int>(decoded_count), "Every queued bitmap should be decoded");
+    assertEqual(0, static_cast<int>(mismatches), "Decoded pixels should match bitmap::data()");
+}
+
+namespace {
+    void benchmarkFile(const std::string& name, nl::node root, std::function<void(const std::string&)> report) {
+        std::vector<nl::bitmap> bitmaps;
+        collectBitmaps(root, bitmaps);
+
+        if (bitmaps.empty()) {
+            report(name + ": no bitmaps found, skipping");
+            return;
+        }
+
+        size_t bytes = 0;
+        size_t largest = 0;
+
+        for (const nl::bitmap& bmp : bitmaps) {
+            bytes += bmp.length();
+            largest = std::max<size_t>(largest, bmp.length());
+        }
+
+        std::vector<uint8_t> buffer(largest);
+        std::vector<std::vector<uint8_t>> outputs(bitmaps.size());
+        std::vector<void*> destinations(bitmaps.size());
+
+        for (size_t i = 0; i < bitmaps.size(); i++) {
+            outputs[i].resize(bitmaps[i].length());
+            destinations[i] = outputs[i].data();
+        }
+
+        auto measure = [&](const std::string& label, std::function<void()> fn) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+            std::stringstream ss;
+            ss << name << " " << label << ": " << megabytesPerSecond(bytes, elapsed) << " MB/s";
+            report(ss.str());
+        };
+
+        measure("data()", [&]() {
+            for (const nl::bitmap& bmp : bitmaps)
+                bmp.data();
+        });
+
+        measure("decode_into", [&]() {
+            for (const nl::bitmap& bmp : bitmaps)
+                bmp.decode_into(buffer.data(), buffer.size());
+        });
+
+        measure("decode_scratch", [&]() {
+            for (const nl::bitmap& bmp : bitmaps)
+                bmp.decode_scratch();
+        });
+
+        size_t decoded = 0;
+
+        measure("decode_batch", [&]() {
+            decoded = nl::bitmap::decode_batch(bitmaps.data(), destinations.data(), bitmaps.size());
+        });
+
+        std::stringstream ss;
+        ss << name << ": " << bitmaps.size() << " bitmaps, " << bytes / (1024 * 1024) << " MB, " << decoded << " decoded by decode_batch";
+        report(ss.str());
+
+        for (size_t i = 0; i < bitmaps.size() && i < 64; i++) {
+            if (std::memcmp(outputs[i].data(), bitmaps[i].data(), outputs[i].size()) != 0) {
+                report(name + ": decode_batch output differs from data()");
+                break;
+            }
+        }
+    }
+}
+
+TEST(BitmapDecode, Benchmark) {
+    auto report = [this](const std::string& line) { log(line); };
+
+    benchmarkFile("Character.nx", nl::nx::Character["00002000.img"], report);
+    benchmarkFile("Character.nx", nl::nx::Character["Weapon"], report);
+    benchmarkFile("Map.nx", nl::nx::Map["Back"], report);
+    benchmarkFile("Map.nx", nl::nx::Map["Tile"], report);
+
+    nl::bitmap null_bitmap;
+    uint8_t byte = 0;
+    assert(!null_bitmap.decode_into(&byte, sizeof(byte)), "A null bitmap should not decode");
+
+    std::vector<nl::bitmap> bitmaps;
+    collectBitmaps(nl::nx::Map["Back"], bitmaps);
+
+    if (!bitmaps.empty() && bitmaps.front().length() > 0) {
+        const nl::bitmap& bmp = bitmaps.front();
+        std::vector<uint8_t> small(bmp.length() - 1);
+
+        assert(!bmp.decode_into(small.data(), small.size()), "decode_into should reject a buffer which is too small");
+    }
+}
+
+} // namespace Testing
+} // namespace ms
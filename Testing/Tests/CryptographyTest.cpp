@@ -0,0 +1,456 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../TestFramework.h"
+#include "../../Net/Cryptography.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    const size_t PACKETS = 20000;
+
+    const uint8_t SUBBOX[256] = {
+        0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+        0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+        0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+        0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+        0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+        0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+        0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+        0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+        0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+        0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+        0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+        0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+        0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+        0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+        0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+        0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16
+    };
+
+    const uint8_t MAPLEKEY[256] = {
+        0x13, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0xB4, 0x00, 0x00, 0x00,
+        0x1B, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x33, 0x00, 0x00, 0x00, 0x52, 0x00, 0x00, 0x00,
+        0x71, 0x63, 0x63, 0x00, 0x79, 0x63, 0x63, 0x00, 0x7F, 0x63, 0x63, 0x00, 0xCB, 0x63, 0x63, 0x00,
+        0x04, 0xFB, 0xFB, 0x63, 0x0B, 0xFB, 0xFB, 0x63, 0x38, 0xFB, 0xFB, 0x63, 0x6A, 0xFB, 0xFB, 0x63,
+        0x7C, 0x6C, 0x98, 0x02, 0x05, 0x0F, 0xFB, 0x02, 0x7A, 0x6C, 0x98, 0x02, 0xB1, 0x0F, 0xFB, 0x02,
+        0xCC, 0x8D, 0xF4, 0x14, 0xC7, 0x76, 0x0F, 0x77, 0xFF, 0x8D, 0xF4, 0x14, 0x95, 0x76, 0x0F, 0x77,
+        0x40, 0x1A, 0x6D, 0x28, 0x45, 0x15, 0x96, 0x2A, 0x3F, 0x79, 0x0E, 0x28, 0x8E, 0x76, 0xF5, 0x2A,
+        0xD5, 0xB5, 0x12, 0xF1, 0x12, 0xC3, 0x1D, 0x86, 0xED, 0x4E, 0xE9, 0x92, 0x78, 0x38, 0xE6, 0xE5,
+        0x4F, 0x94, 0xB4, 0x94, 0x0A, 0x81, 0x22, 0xBE, 0x35, 0xF8, 0x2C, 0x96, 0xBB, 0x8E, 0xD9, 0xBC,
+        0x3F, 0xAC, 0x27, 0x94, 0x2D, 0x6F, 0x3A, 0x12, 0xC0, 0x21, 0xD3, 0x80, 0xB8, 0x19, 0x35, 0x65,
+        0x8B, 0x02, 0xF9, 0xF8, 0x81, 0x83, 0xDB, 0x46, 0xB4, 0x7B, 0xF7, 0xD0, 0x0F, 0xF5, 0x2E, 0x6C,
+        0x49, 0x4A, 0x16, 0xC4, 0x64, 0x25, 0x2C, 0xD6, 0xA4, 0x04, 0xFF, 0x56, 0x1C, 0x1D, 0xCA, 0x33,
+        0x0F, 0x76, 0x3A, 0x64, 0x8E, 0xF5, 0xE1, 0x22, 0x3A, 0x8E, 0x16, 0xF2, 0x35, 0x7B, 0x38, 0x9E,
+        0xDF, 0x6B, 0x11, 0xCF, 0xBB, 0x4E, 0x3D, 0x19, 0x1F, 0x4A, 0xC2, 0x4F, 0x03, 0x57, 0x08, 0x7C,
+        0x14, 0x46, 0x2A, 0x1F, 0x9A, 0xB3, 0xCB, 0x3D, 0xA0, 0x3D, 0xDD, 0xCF, 0x95, 0x46, 0xE5, 0x51,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+
+    // The byte-wise AES as it was before the lookup tables
+    void referenceEncrypt(uint8_t* bytes) {
+        auto addroundkey = [&](size_t round) {
+            for (size_t i = 0; i < 16; i++)
+                bytes[i] ^= MAPLEKEY[i + round * 16];
+        };
+
+        auto subbytes = [&]() {
+            for (size_t i = 0; i < 16; i++)
+                bytes[i] = SUBBOX[bytes[i]];
+        };
+
+        auto shiftrows = [&]() {
+            uint8_t copy[16];
+            std::memcpy(copy, bytes, 16);
+
+            for (size_t column = 0; column < 4; column++)
+                for (size_t row = 0; row < 4; row++)
+                    bytes[column * 4 + row] = copy[((column + row) % 4) * 4 + row];
+        };
+
+        auto gmul = [](uint8_t x) {
+            return static_cast<uint8_t>((x << 1) ^ (0x1B & static_cast<uint8_t>(static_cast<int8_t>(x) >> 7)));
+        };
+
+        auto mixcolumns = [&]() {
+            for (size_t i = 0; i < 16; i += 4) {
+                uint8_t cpy0 = bytes[i];
+                uint8_t cpy1 = bytes[i + 1];
+                uint8_t cpy2 = bytes[i + 2];
+                uint8_t cpy3 = bytes[i + 3];
+
+                uint8_t mul0 = gmul(cpy0);
+                uint8_t mul1 = gmul(cpy1);
+                uint8_t mul2 = gmul(cpy2);
+                uint8_t mul3 = gmul(cpy3);
+
+                bytes[i] = mul0 ^ cpy3 ^ cpy2 ^ mul1 ^ cpy1;
+                bytes[i + 1] = mul1 ^ cpy0 ^ cpy3 ^ mul2 ^ cpy2;
+                bytes[i + 2] = mul2 ^ cpy1 ^ cpy0 ^ mul3 ^ cpy3;
+                bytes[i + 3] = mul3 ^ cpy2 ^ cpy1 ^ mul0 ^ cpy0;
+            }
+        };
+
+        addroundkey(0);
+
+        for (size_t round = 1; round < 14; round++) {
+            subbytes();
+            shiftrows();
+            mixcolumns();
+            addroundkey(round);
+        }
+
+        subbytes();
+        shiftrows();
+        addroundkey(14);
+    }
+
+    // AES OFB as it was before, restarting from the iv for every block
+    void referenceOfb(int8_t* bytes, size_t length, const uint8_t* iv) {
+        size_t blocklength = 0x5B0;
+        size_t offset = 0;
+
+        while (offset < length) {
+            uint8_t miv[16];
+
+            for (size_t i = 0; i < 16; i++)
+                miv[i] = iv[i % 4];
+
+            size_t remaining = std::min(length - offset, blocklength);
+
+            for (size_t x = 0; x < remaining; x++) {
+                if (x % 16 == 0)
+                    referenceEncrypt(miv);
+
+                bytes[x + offset] ^= miv[x % 16];
+            }
+
+            offset += blocklength;
+            blocklength = 0x5B4;
+        }
+    }
+
+    int8_t referenceRollLeft(int8_t data, size_t count) {
+        int32_t mask = (data & 0xFF) << (count % 8);
+
+        return static_cast<int8_t>((mask & 0xFF) | (mask >> 8));
+    }
+
+    int8_t referenceRollRight(int8_t data, size_t count) {
+        int32_t mask = ((data & 0xFF) << 8) >> (count % 8);
+
+        return static_cast<int8_t>((mask & 0xFF) | (mask >> 8));
+    }
+
+    // The maple custom encryption as it was before the lookup tables
+    void referenceMapleEncrypt(int8_t* bytes, size_t length) {
+        for (size_t j = 0; j < 3; j++) {
+            int8_t remember = 0;
+            int8_t datalen = static_cast<int8_t>(length & 0xFF);
+
+            for (size_t i = 0; i < length; i++) {
+                int8_t cur = (referenceRollLeft(bytes[i], 3) + datalen) ^ remember;
+                remember = cur;
+                cur = referenceRollRight(cur, static_cast<int32_t>(datalen) & 0xFF);
+                bytes[i] = static_cast<int8_t>((~cur) & 0xFF) + 0x48;
+                datalen--;
+            }
+
+            remember = 0;
+            datalen = static_cast<int8_t>(length & 0xFF);
+
+            for (size_t i = length; i--;) {
+                int8_t cur = (referenceRollLeft(bytes[i], 4) + datalen) ^ remember;
+                remember = cur;
+                bytes[i] = referenceRollRight(cur ^ 0x13, 3);
+                datalen--;
+            }
+        }
+    }
+
+    // The maple custom decryption as it was before the lookup tables
+    void referenceMapleDecrypt(int8_t* bytes, size_t length) {
+        for (size_t i = 0; i < 3; i++) {
+            uint8_t remember = 0;
+            uint8_t datalen = static_cast<uint8_t>(length & 0xFF);
+
+            for (size_t j = length; j--;) {
+                uint8_t cur = referenceRollLeft(bytes[j], 3) ^ 0x13;
+                bytes[j] = referenceRollRight((cur ^ remember) - datalen, 4);
+                remember = cur;
+                datalen--;
+            }
+
+            remember = 0;
+            datalen = static_cast<uint8_t>(length & 0xFF);
+
+            for (size_t j = 0; j < length; j++) {
+                uint8_t cur = (~(bytes[j] - 0x48)) & 0xFF;
+                cur = referenceRollLeft(cur, static_cast<int32_t>(datalen) & 0xFF);
+                bytes[j] = referenceRollRight((cur ^ remember) - datalen, 3);
+                remember = cur;
+                datalen--;
+            }
+        }
+    }
+
+    // Outputs of the maple custom encryption for the input bytes i * 7 + 3
+    struct GoldenVector {
+        size_t length;
+        std::vector<uint8_t> encrypted;
+        std::vector<uint8_t> decrypted;
+    };
+
+    const GoldenVector GOLDEN[] = {
+        { 1, { 0xA0 }, { 0x99 } },
+        { 2, { 0xD7, 0x8A }, { 0x78, 0x84 } },
+        { 5, { 0x34, 0x74, 0x65, 0xF5, 0xE4 }, { 0x9E, 0x08, 0x1D, 0xFC, 0xD4 } },
+        { 16,
+            { 0x58, 0x8F, 0x0E, 0xEB, 0xBF, 0x46, 0x1D, 0xC3, 0x08, 0x53, 0x7D, 0x05, 0x9B, 0x96, 0xBE, 0xD0 },
+            { 0x9D, 0x96, 0x5A, 0xAC, 0x5D, 0xA5, 0x01, 0x86, 0x8A, 0xC0, 0xC4, 0x3A, 0xA1, 0xAC, 0xEE, 0x52 } },
+        { 33,
+            { 0x01, 0x50, 0x57, 0xBB, 0x6C, 0x07, 0x6C, 0x2D, 0xCD, 0x53, 0xA6, 0x5B, 0x66, 0xBB, 0xC5, 0x82,
+              0xB6, 0x98, 0xF9, 0xDD, 0x57, 0xAC, 0x99, 0xD2, 0xBC, 0xED, 0xE9, 0x47, 0xA1, 0xFB, 0xB0, 0x24, 0xB4 },
+            { 0x62, 0x07, 0x07, 0xCE, 0xDA, 0xE6, 0x7C, 0x8C, 0x60, 0x33, 0xE3, 0xBA, 0x88, 0xE8, 0x70, 0xAC,
+              0xB5, 0x3C, 0xB2, 0xB4, 0x96, 0x95, 0x2F, 0xE1, 0x54, 0x80, 0x4E, 0xC7, 0xBC, 0xE0, 0x3D, 0x31, 0x8B } }
+    };
+
+    // FNV-1a hashes of the outputs for longer inputs of the same pattern
+    struct GoldenHash {
+        size_t length;
+        uint32_t encrypted;
+        uint32_t decrypted;
+    };
+
+    const GoldenHash GOLDEN_HASHES[] = {
+        { 256, 0x600F3248, 0xA8D3537F },
+        { 1460, 0x119F01D8, 0x46184681 },
+        { 70000, 0x9E2F8244, 0xB3B8082D }
+    };
+
+    std::vector<int8_t> goldenInput(size_t length) {
+        std::vector<int8_t> bytes(length);
+
+        for (size_t i = 0; i < length; i++)
+            bytes[i] = static_cast<int8_t>(i * 7 + 3);
+
+        return bytes;
+    }
+
+    uint32_t fnv1a(const std::vector<int8_t>& bytes) {
+        uint32_t hash = 2166136261u;
+
+        for (int8_t byte : bytes) {
+            hash ^= static_cast<uint8_t>(byte);
+            hash *= 16777619u;
+        }
+
+        return hash;
+    }
+
+    std::vector<std::vector<int8_t>> randomPackets(std::mt19937& random) {
+        std::vector<std::vector<int8_t>> packets(PACKETS);
+
+        for (size_t i = 0; i < PACKETS; i++) {
+            // Mostly small packets, with some spanning several blocks
+            size_t length = (i % 50 == 0) ? random() % 20000 : random() % 200 + 2;
+            packets[i].resize(length);
+
+            for (auto& byte : packets[i])
+                byte = static_cast<int8_t>(random());
+        }
+
+        return packets;
+    }
+}
+
+TEST(Cryptography, MatchesReferenceAes) {
+    std::mt19937 random(83);
+    std::vector<std::vector<int8_t>> packets = randomPackets(random);
+    size_t mismatches = 0;
+
+    for (auto& packet : packets) {
+        uint8_t iv[4];
+
+        for (auto& byte : iv)
+            byte = static_cast<uint8_t>(random());
+
+        std::vector<int8_t> expected = packet;
+        referenceOfb(expected.data(), expected.size(), iv);
+        Cryptography::aesofb(packet.data(), packet.size(), iv);
+
+        if (packet != expected)
+            mismatches++;
+    }
+
+    log(std::string("AES backend: ") + Cryptography::aesbackend());
+    assertEqual(0, static_cast<int>(mismatches), "Keystream should match the reference AES byte for byte");
+}
+
+TEST(Cryptography, Benchmark) {
+    std::mt19937 random(8484);
+    std::vector<std::vector<int8_t>> packets = randomPackets(random);
+    uint8_t iv[4] = { 0x52, 0x30, 0x78, 0x61 };
+
+    size_t bytes = 0;
+
+    for (const auto& packet : packets)
+        bytes += packet.size();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (auto& packet : packets)
+        referenceOfb(packet.data(), packet.size(), iv);
+
+    int64_t referencens = nanosecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+
+    for (auto& packet : packets)
+        Cryptography::aesofb(packet.data(), packet.size(), iv);
+
+    int64_t fastns = nanosecondsSince(start);
+
+    std::stringstream ss;
+    ss << bytes << " bytes in " << PACKETS << " packets, reference: " << referencens / 1000 << "us, "
+       << Cryptography::aesbackend() << ": " << fastns / 1000 << "us";
+    log(ss.str());
+}
+
+TEST(Cryptography, MapleGoldenVectors) {
+    for (const GoldenVector& golden : GOLDEN) {
+        std::vector<int8_t> encrypted = goldenInput(golden.length);
+        std::vector<int8_t> decrypted = goldenInput(golden.length);
+
+        Cryptography::mapleencrypt(encrypted.data(), encrypted.size());
+        Cryptography::mapledecrypt(decrypted.data(), decrypted.size());
+
+        for (size_t i = 0; i < golden.length; i++) {
+            assertEqual(golden.encrypted[i], static_cast<uint8_t>(encrypted[i]), "Encrypted byte " + std::to_string(i) + " of " + std::to_string(golden.length));
+            assertEqual(golden.decrypted[i], static_cast<uint8_t>(decrypted[i]), "Decrypted byte " + std::to_string(i) + " of " + std::to_string(golden.length));
+        }
+    }
+
+    for (const GoldenHash& golden : GOLDEN_HASHES) {
+        std::vector<int8_t> encrypted = goldenInput(golden.length);
+        std::vector<int8_t> decrypted = goldenInput(golden.length);
+
+        Cryptography::mapleencrypt(encrypted.data(), encrypted.size());
+        Cryptography::mapledecrypt(decrypted.data(), decrypted.size());
+
+        assert(fnv1a(encrypted) == golden.encrypted, "Encrypted hash of " + std::to_string(golden.length) + " bytes");
+        assert(fnv1a(decrypted) == golden.decrypted, "Decrypted hash of " + std::to_string(golden.length) + " bytes");
+    }
+}
+
+TEST(Cryptography, MatchesReferenceMaple) {
+    std::mt19937 random(118);
+    size_t mismatches = 0;
+
+    // Every length up to a few vector widths, then random packets
+    for (size_t length = 0; length < 300; length++) {
+        std::vector<int8_t> packet(length);
+
+        for (auto& byte : packet)
+            byte = static_cast<int8_t>(random());
+
+        std::vector<int8_t> expected = packet;
+        std::vector<int8_t> roundtrip = packet;
+
+        referenceMapleDecrypt(expected.data(), expected.size());
+        Cryptography::mapledecrypt(packet.data(), packet.size());
+
+        if (packet != expected)
+            mismatches++;
+
+        Cryptography::mapleencrypt(roundtrip.data(), roundtrip.size());
+        referenceMapleDecrypt(roundtrip.data(), roundtrip.size());
+        referenceMapleEncrypt(expected.data(), expected.size());
+
+        if (roundtrip != expected)
+            mismatches++;
+    }
+
+    for (auto& packet : randomPackets(random)) {
+        std::vector<int8_t> expected = packet;
+
+        referenceMapleEncrypt(expected.data(), expected.size());
+        Cryptography::mapleencrypt(packet.data(), packet.size());
+
+        if (packet != expected)
+            mismatches++;
+
+        referenceMapleDecrypt(expected.data(), expected.size());
+        Cryptography::mapledecrypt(packet.data(), packet.size());
+
+        if (packet != expected)
+            mismatches++;
+    }
+
+    assertEqual(0, static_cast<int>(mismatches), "Maple cipher should match the reference byte for byte");
+}
+
+TEST(Cryptography, MapleBenchmark) {
+    std::mt19937 random(2019);
+    std::vector<std::vector<int8_t>> packets = randomPackets(random);
+
+    size_t bytes = 0;
+
+    for (const auto& packet : packets)
+        bytes += packet.size();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (auto& packet : packets)
+        referenceMapleEncrypt(packet.data(), packet.size());
+
+    int64_t referenceencrypt = nanosecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+
+    for (auto& packet : packets)
+        referenceMapleDecrypt(packet.data(), packet.size());
+
+    int64_t referencedecrypt = nanosecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+
+    for (auto& packet : packets)
+        Cryptography::mapleencrypt(packet.data(), packet.size());
+
+    int64_t fastencrypt = nanosecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+
+    for (auto& packet : packets)
+        Cryptography::mapledecrypt(packet.data(), packet.size());
+
+    int64_t fastdecrypt = nanosecondsSince(start);
+
+    std::stringstream ss;
+    ss << bytes << " bytes, encrypt: " << referenceencrypt / 1000 << "us -> " << fastencrypt / 1000 << "us"
+       << ", decrypt: " << referencedecrypt / 1000 << "us -> " << fastdecrypt / 1000 << "us";
+    log(ss.str());
+}
+
+} // namespace Testing
+} // namespace ms
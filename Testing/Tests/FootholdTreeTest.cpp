@@ -0,0 +1,210 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../TestFramework.h"
+#include "../../Gameplay/Physics/Physics.h"
+
+#include <nlnx/node.hpp>
+#include <nlnx/nx.hpp>
+
+#include <chrono>
+#include <random>
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    const int32_t MAPS[] = { 100000000, 200000000, 240000000 };
+    const size_t DROPS = 100000;
+    const size_t MOBS = 2000;
+    const size_t TICKS = 500;
+
+    nl::node footholdNode(int32_t mapid) {
+        std::string strid = std::to_string(mapid);
+        strid.insert(0, 9 - strid.size(), '0');
+
+        std::string folder = "Map" + std::to_string(mapid / 100000000);
+
+        return nl::nx::Map["Map"][folder][strid + ".img"]["foothold"];
+    }
+
+    // The lookup as it was before the column index, a scan over every foothold
+    double linearYBelow(const std::vector<Foothold>& footholds, const Range<int16_t>& borders, Point<int16_t> position) {
+        double comp = borders.second();
+        bool found = false;
+
+        for (const Foothold& fh : footholds) {
+            if (fh.is_wall() || !fh.hcontains(position.x()))
+                continue;
+
+            double ycomp = fh.ground_below(position.x());
+
+            if (comp >= ycomp && ycomp >= position.y()) {
+                comp = ycomp;
+                found = true;
+            }
+        }
+
+        return found ? static_cast<int16_t>(comp) : borders.second();
+    }
+
+    std::vector<Foothold> collectFootholds(nl::node src) {
+        std::vector<Foothold> footholds;
+
+        for (auto basef : src)
+            for (auto midf : basef)
+                for (auto lastf : midf)
+                    footholds.emplace_back(lastf, static_cast<uint16_t>(std::stoi(lastf.name())), static_cast<uint8_t>(std::stoi(basef.name())));
+
+        return footholds;
+    }
+}
+
+TEST(FootholdTree, MatchesLinearScan) {
+    std::mt19937 random(83);
+    size_t checked = 0;
+    size_t mismatches = 0;
+
+    for (int32_t mapid : MAPS) {
+        nl::node src = footholdNode(mapid);
+
+        if (src.size() == 0)
+            continue;
+
+        FootholdTree tree(src);
+        std::vector<Foothold> footholds = collectFootholds(src);
+
+        Range<int16_t> walls = tree.get_walls();
+        Range<int16_t> borders = tree.get_borders();
+        std::uniform_int_distribution<int> xdist(walls.first() - 100, walls.second() + 100);
+        std::uniform_int_distribution<int> ydist(borders.first(), borders.second());
+
+        for (size_t i = 0; i < 20000; i++) {
+            Point<int16_t> position(static_cast<int16_t>(xdist(random)), static_cast<int16_t>(ydist(random)));
+
+            if (tree.get_y_below(position) != linearYBelow(footholds, borders, position))
+                mismatches++;
+
+            checked++;
+        }
+    }
+
+    if (checked == 0)
+        skip("No footholds found, is Map.nx present?");
+
+    std::stringstream ss;
+    ss << checked << " positions checked, " << mismatches << " mismatches";
+    log(ss.str());
+
+    assertEqual(0, static_cast<int>(mismatches), "The column index should find the same ground as a linear scan");
+}
+
+TEST(FootholdTree, Benchmark) {
+    std::mt19937 random(8484);
+    bool any = false;
+
+    for (int32_t mapid : MAPS) {
+        nl::node src = footholdNode(mapid);
+
+        if (src.size() == 0)
+            continue;
+
+        any = true;
+
+        Physics physics(src);
+        const FootholdTree& tree = physics.get_fht();
+        Range<int16_t> walls = tree.get_walls();
+        Range<int16_t> borders = tree.get_borders();
+        std::uniform_int_distribution<int> xdist(walls.first(), walls.second());
+        std::uniform_int_distribution<int> ydist(borders.first(), borders.second());
+
+        // Drops look for the ground below where they were spawned
+        std::vector<Point<int16_t>> drops(DROPS);
+
+        for (auto& drop : drops)
+            drop = Point<int16_t>(static_cast<int16_t>(xdist(random)), static_cast<int16_t>(ydist(random)));
+
+        int64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (const auto& drop : drops)
+            checksum += tree.get_y_below(drop);
+
+        int64_t dropns = nanosecondsSince(start);
+
+        // Mobs walk back and forth on the ground
+        std::vector<PhysicsObject> mobs(MOBS);
+
+        for (auto& mob : mobs) {
+            Point<int16_t> spawn(static_cast<int16_t>(xdist(random)), static_cast<int16_t>(ydist(random)));
+
+            mob.set_x(spawn.x());
+            mob.set_y(tree.get_y_below(spawn));
+            mob.hspeed = random() % 2 ? 0.1 : -0.1;
+            mob.set_flag(PhysicsObject::Flag::TURNATEDGES);
+        }
+
+        std::vector<PhysicsObject> batched = mobs;
+        std::vector<PhysicsObject*> bodies;
+
+        for (auto& mob : batched)
+            bodies.push_back(&mob);
+
+        start = std::chrono::steady_clock::now();
+
+        for (size_t tick = 0; tick < TICKS; tick++) {
+            for (auto& mob : mobs) {
+                mob.hforce = mob.hspeed < 0.0 ? -0.1 : 0.1;
+
+                physics.move_object(mob);
+            }
+        }
+
+        int64_t movens = nanosecondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+
+        for (size_t tick = 0; tick < TICKS; tick++) {
+            for (auto& mob : batched)
+                mob.hforce = mob.hspeed < 0.0 ? -0.1 : 0.1;
+
+            physics.move_objects(bodies.data(), bodies.size());
+        }
+
+        int64_t batchns = nanosecondsSince(start);
+
+        size_t diverged = 0;
+
+        for (size_t i = 0; i < MOBS; i++)
+            if (mobs[i].get_position() != batched[i].get_position())
+                diverged++;
+
+        std::stringstream ss;
+        ss << "Map " << mapid << ": get_y_below " << dropns / static_cast<int64_t>(DROPS) << " ns per drop, "
+           << "move_object " << movens / static_cast<int64_t>(MOBS * TICKS) << " ns per mob tick, "
+           << "move_objects " << batchns / static_cast<int64_t>(MOBS * TICKS) << " ns per mob tick (checksum " << checksum << ")";
+        log(ss.str());
+
+        assertEqual(0, static_cast<int>(diverged), "Batched and single physics steps should move mobs the same way");
+    }
+
+    if (!any)
+        skip("No footholds found, is Map.nx present?");
+}
+
+} // namespace Testing
+} // namespace ms
@@ -0,0 +1,210 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../TestFramework.h"
+#include "../../Net/Handlers/Helpers/LoginParser.h"
+#include "../../Net/Handlers/Helpers/MovementParser.h"
+
+#include <chrono>
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    const size_t ITERATIONS = 200000;
+
+    // Builds packets with the same layout as the ones sent by the server
+    class PacketBuilder {
+    public:
+        template <typename T>
+        PacketBuilder& write(T value) {
+            for (size_t i = 0; i < sizeof(T); i++)
+                bytes.push_back(static_cast<int8_t>(static_cast<uint64_t>(value) >> (8 * i)));
+
+            return *this;
+        }
+
+        PacketBuilder& write_string(const std::string& str) {
+            write<int16_t>(static_cast<int16_t>(str.size()));
+
+            return write_padded_string(str, str.size());
+        }
+
+        PacketBuilder& write_padded_string(const std::string& str, size_t length) {
+            for (size_t i = 0; i < length; i++)
+                bytes.push_back(i < str.size() ? str[i] : '\0');
+
+            return *this;
+        }
+
+        InPacket packet() const {
+            return InPacket(bytes.data(), bytes.size());
+        }
+
+        std::vector<int8_t> bytes;
+    };
+
+    // A mob movement as sent with MOVE_MONSTER, four absolute and four relative fragments
+    PacketBuilder movementPacket() {
+        PacketBuilder builder;
+        builder.write<int8_t>(8);
+
+        for (int16_t i = 0; i < 4; i++) {
+            builder.write<int8_t>(0);
+            builder.write<int16_t>(100 + i).write<int16_t>(-200).write<int16_t>(99 + i).write<int16_t>(-200).write<int16_t>(12);
+            builder.write<int8_t>(2).write<int16_t>(120);
+
+            builder.write<int8_t>(1);
+            builder.write<int16_t>(i).write<int16_t>(-i);
+            builder.write<int8_t>(3).write<int16_t>(60);
+        }
+
+        return builder;
+    }
+
+    // The stats of a character entry as sent with the character list
+    PacketBuilder statsPacket() {
+        PacketBuilder builder;
+        builder.write_padded_string("Maplestory", 13);
+        builder.write<int8_t>(1).write<int8_t>(0).write<int32_t>(20000).write<int32_t>(30030);
+        builder.write<int64_t>(5000000).write<int64_t>(0).write<int64_t>(0);
+        builder.write<int8_t>(70);
+
+        int16_t stats[10] = { 120, 4, 25, 180, 4, 3200, 3500, 900, 1000, 5 };
+
+        for (int16_t stat : stats)
+            builder.write<int16_t>(stat);
+
+        builder.write<int16_t>(3).write<int32_t>(123456).write<int16_t>(10).write<int32_t>(0);
+        builder.write<int32_t>(100000000).write<int8_t>(4).write<int32_t>(0);
+
+        return builder;
+    }
+}
+
+TEST(InPacket, ReadsLittleEndian) {
+    PacketBuilder builder;
+    builder.write<int8_t>(-5).write<int16_t>(-1234).write<int32_t>(0x12345678).write<int64_t>(-9876543210LL);
+
+    InPacket recv = builder.packet();
+
+    assertEqual(-5, recv.read_byte());
+    assertEqual(-1234, recv.read_short());
+    assertEqual(0x12345678, recv.inspect_int(), "Inspecting should not advance");
+    assertEqual(0x12345678, recv.read_int());
+    assert(recv.read_long() == -9876543210LL, "Long should be read in little-endian order");
+    assert(!recv.available(), "Packet should be consumed");
+}
+
+TEST(InPacket, ReadsStrings) {
+    PacketBuilder builder;
+    builder.write_string("Henesys").write_padded_string("Pet", 13);
+
+    InPacket recv = builder.packet();
+
+    assert(recv.read_string() == "Henesys", "String should be copied");
+    assert(recv.read_padded_string(13) == "Pet", "Padding should be removed");
+    assert(!recv.available(), "Packet should be consumed");
+}
+
+TEST(InPacket, ReadsArrays) {
+    PacketBuilder builder;
+
+    for (int32_t i = 0; i < 15; i++)
+        builder.write<int32_t>(i * 1000);
+
+    InPacket recv = builder.packet();
+    std::vector<int32_t> values = recv.read_array<int32_t>(15);
+
+    for (int32_t i = 0; i < 15; i++)
+        assertEqual(i * 1000, values[i]);
+}
+
+TEST(InPacket, ThrowsOnUnderflow) {
+    PacketBuilder builder;
+    builder.write<int16_t>(20).write_padded_string("short", 5);
+
+    InPacket strings = builder.packet();
+    bool thrown = false;
+
+    try {
+        strings.read_string();
+    } catch (const PacketError&) {
+        thrown = true;
+    }
+
+    assert(thrown, "Reading past the end of a string should throw");
+
+    InPacket arrays = builder.packet();
+    thrown = false;
+
+    try {
+        arrays.read_array<int64_t>(2);
+    } catch (const PacketError&) {
+        thrown = true;
+    }
+
+    assert(thrown, "Reading past the end of an array should throw");
+}
+
+TEST(InPacket, ParsesMovement) {
+    PacketBuilder builder = movementPacket();
+    InPacket recv = builder.packet();
+
+    std::vector<Movement> movements = MovementParser::parse_movements(recv);
+
+    assertEqual(8, static_cast<int>(movements.size()));
+    assertEqual(Movement::ABSOLUTE, movements[2].type);
+    assertEqual(102, movements[2].xpos);
+    assertEqual(101, movements[2].lastx);
+    assertEqual(12, movements[2].fh);
+    assertEqual(Movement::RELATIVE, movements[3].type);
+    assertEqual(-1, movements[3].ypos);
+    assert(!recv.available(), "Packet should be consumed");
+}
+
+TEST(InPacket, ParseBenchmark) {
+    PacketBuilder movement = movementPacket();
+    PacketBuilder stats = statsPacket();
+
+    int64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        InPacket recv = movement.packet();
+        checksum += MovementParser::parse_movements(recv).back().duration;
+    }
+
+    int64_t movementns = nanosecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        InPacket recv = stats.packet();
+        checksum += LoginParser::parse_stats(recv).mapid;
+    }
+
+    int64_t statsns = nanosecondsSince(start);
+
+    std::stringstream ss;
+    ss << "Movement: " << movementns / ITERATIONS << "ns per packet, "
+       << "character stats: " << statsns / ITERATIONS << "ns per packet (checksum " << checksum << ")";
+    log(ss.str());
+}
+
+} // namespace Testing
+} // namespace ms
@@ -21,6 +21,9 @@
 #include "../../Gameplay/MapleMap/Mob.h"
 #include "../../Gameplay/Spawn.h"
 #include "../../Gameplay/MapleMap/MapMobs.h"
+#include "../../Data/MobData.h"
+
+#include <chrono>
 
 namespace ms {
 namespace Testing {
@@ -170,5 +173,30 @@ TEST(MobSpawning, ClearAllMobs) {
     log("All mobs cleared successfully");
 }
 
+TEST(MobSpawning, SharedTemplate) {
+    log("Testing that mobs of one id share their template");
+
+    const MobData& first = MobData::get(100100);
+    const MobData& second = MobData::get(100100);
+
+    assert(&first == &second, "Template should be loaded once per mob id");
+    assert(first.is_valid(), "Template should be loaded from the game files");
+    assert(first.get_animations().size() >= 5, "Template should contain the basic stances");
+
+    // Respawn waves construct many mobs of the same id at once
+    const int WAVE = 200;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < WAVE; i++) {
+        Mob mob(6000 + i, 100100, 0, 0, 1, true, -1, Point<int16_t>(400, 300));
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    log("Constructed " + std::to_string(WAVE) + " mobs in " + std::to_string(micros) + "us");
+}
+
 } // namespace Testing
 } // namespace ms
\ No newline at end of file
@@ -0,0 +1,114 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../NxFixture.h"
+#include "../TestFramework.h"
+#include "../../Util/NodeCache.h"
+
+#include <nlnx/file.hpp>
+#include <nlnx/node.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    const char* NX_PATH = "NodeLookupTest.nx";
+
+    // Hashes of literal paths are computed by the compiler
+    static_assert(NodeCache::Path("Mob/0100100.img").hash != NodeCache::Path("Mob/0100101.img").hash, "Paths should hash apart");
+
+    // A root with the children '1' and 'a', where '1' has the children '-5' and '20'
+    // Nodes at 56, the string table at 160 and the strings at 200.
+    void write_nx() {
+        NxFixture nx(216);
+
+        nx.header(5, 56, 5, 160);
+
+        // Name, first child and number of children of each node
+        const uint32_t nodes[5][3] = { { 0, 1, 2 }, { 1, 3, 2 }, { 2, 0, 0 }, { 3, 0, 0 }, { 4, 0, 0 } };
+
+        for (size_t i = 0; i < 5; i++) {
+            nx.put<uint32_t>(56 + i * 20, nodes[i][0]);
+            nx.put<uint32_t>(60 + i * 20, nodes[i][1]);
+            nx.put<uint16_t>(64 + i * 20, static_cast<uint16_t>(nodes[i][2]));
+        }
+
+        const char* strings[5] = { "", "1", "a", "-5", "20" };
+        size_t offset = 200;
+
+        for (size_t i = 0; i < 5; i++) {
+            uint16_t length = static_cast<uint16_t>(std::strlen(strings[i]));
+
+            nx.put<uint64_t>(160 + i * 8, offset);
+            nx.put<uint16_t>(offset, length);
+
+            for (uint16_t c = 0; c < length; c++)
+                nx.put<char>(offset + 2 + c, strings[i][c]);
+
+            offset += 2 + length;
+        }
+
+        nx.save(NX_PATH);
+    }
+
+    void cleanup() {
+        std::remove(nl::file::bitmap_sidecar(NX_PATH).c_str());
+        std::remove(NX_PATH);
+    }
+}
+
+TEST(NodeLookup, IntegerChildren) {
+    write_nx();
+
+    {
+        nl::file file(NX_PATH);
+        nl::node root = file;
+
+        assert(root[1][20].name() == "20", "Integer lookups should find the child named by the number");
+        assert(root[1][-5].name() == "-5", "Negative numbers should keep their sign");
+        assert(root[1][20ULL] == root["1"]["20"], "All integer types should find the same child");
+        assert(!root[1][2], "A missing child should be a null node");
+    }
+
+    cleanup();
+}
+
+TEST(NodeLookup, ResolvesPaths) {
+    write_nx();
+
+    {
+        nl::file file(NX_PATH);
+        nl::node root = file;
+
+        assert(root.resolve("1/20") == root["1"]["20"], "Each part should be looked up in turn");
+        assert(root.resolve("1/") == root["1"], "A trailing slash should be ignored");
+        assert(root.resolve("") == root, "An empty path should resolve to the node itself");
+        assert(!root.resolve("b/20"), "A missing part should resolve to a null node");
+
+        uint64_t before = nl::node::lookups();
+        root.resolve("1/-5");
+        assertEqual(2, static_cast<int>(nl::node::lookups() - before), "Every part should count as one lookup");
+    }
+
+    cleanup();
+}
+
+} // namespace Testing
+} // namespace ms
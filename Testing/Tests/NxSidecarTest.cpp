@@ -0,0 +1,173 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../NxFixture.h"
+#include "../TestFramework.h"
+
+#include <nlnx/file.hpp>
+#include <nlnx/node.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    const char* NX_PATH = "NxSidecarTest.nx";
+
+    // Offset of the table in a sidecar, behind its 40 byte header
+    const size_t TABLE_OFFSET = 40;
+
+    // A v92 style file without a bitmap table: a root with two bitmap children
+    // Nodes at 56, strings at 120 and 144, bitmaps of 8 bytes at 152 and 168.
+    void write_nx() {
+        NxFixture nx(184);
+
+        nx.header(3, 56, 3, 120);
+
+        // Name, first child, number of children, type and bitmap index
+        nx.put<uint32_t>(56, 0);
+        nx.put<uint32_t>(60, 1);
+        nx.put<uint16_t>(64, 2);
+
+        for (uint32_t i = 0; i < 2; i++) {
+            size_t node = 76 + i * 20;
+
+            nx.put<uint32_t>(node, i + 1);
+            nx.put<uint16_t>(node + 10, static_cast<uint16_t>(nl::node::type::bitmap));
+            nx.put<uint32_t>(node + 12, i);
+            nx.put<uint16_t>(node + 16, 2);
+            nx.put<uint16_t>(node + 18, 1);
+        }
+
+        nx.put<uint64_t>(120, 144);
+        nx.put<uint64_t>(128, 146);
+        nx.put<uint64_t>(136, 149);
+        nx.put<uint16_t>(146, 1);
+        nx.put<char>(148, 'a');
+        nx.put<uint16_t>(149, 1);
+        nx.put<char>(151, 'b');
+
+        nx.put<uint32_t>(152, 8);
+        nx.put<uint32_t>(168, 8);
+
+        nx.save(NX_PATH);
+    }
+
+    std::vector<char> read_sidecar() {
+        std::ifstream in(nl::file::bitmap_sidecar(NX_PATH), std::ios::binary);
+
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void write_sidecar(const std::vector<char>& bytes) {
+        std::ofstream out(nl::file::bitmap_sidecar(NX_PATH), std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), bytes.size());
+    }
+
+    uint64_t table_entry(const std::vector<char>& sidecar, size_t index) {
+        uint64_t offset = 0;
+        std::memcpy(&offset, sidecar.data() + TABLE_OFFSET + index * sizeof(uint64_t), sizeof(uint64_t));
+
+        return offset;
+    }
+
+    void cleanup() {
+        std::remove(nl::file::bitmap_sidecar(NX_PATH).c_str());
+        std::remove(NX_PATH);
+    }
+}
+
+TEST(NxSidecar, WrittenOnColdStart) {
+    cleanup();
+    write_nx();
+
+    {
+        nl::file file(NX_PATH);
+        assertEqual(2, static_cast<int>(file.bitmap_count()), "Both bitmaps should be found");
+    }
+
+    std::vector<char> sidecar = read_sidecar();
+    assertEqual(static_cast<int>(TABLE_OFFSET + 16), static_cast<int>(sidecar.size()), "Sidecar should hold the header and two offsets");
+    assert(std::memcmp(sidecar.data(), "NXBT", 4) == 0, "Sidecar should start with its magic");
+    assertEqual(152, static_cast<int>(table_entry(sidecar, 0)), "First bitmap offset should be kept");
+    assertEqual(168, static_cast<int>(table_entry(sidecar, 1)), "Second bitmap offset should be kept");
+
+    cleanup();
+}
+
+TEST(NxSidecar, LoadedOnWarmStart) {
+    cleanup();
+    write_nx();
+
+    { nl::file file(NX_PATH); }
+
+    // A valid sidecar is trusted, so a changed offset survives the next start
+    std::vector<char> sidecar = read_sidecar();
+    put<uint64_t>(sidecar, TABLE_OFFSET + 8, 160);
+    write_sidecar(sidecar);
+
+    {
+        nl::file file(NX_PATH);
+        assertEqual(2, static_cast<int>(file.bitmap_count()), "Table should be loaded from the sidecar");
+    }
+
+    assertEqual(160, static_cast<int>(table_entry(read_sidecar(), 1)), "Valid sidecar should not be rewritten");
+
+    cleanup();
+}
+
+TEST(NxSidecar, RebuiltWhenStale) {
+    cleanup();
+    write_nx();
+
+    { nl::file file(NX_PATH); }
+
+    // A sidecar of another file is rejected, then replaced with the rebuilt table
+    std::vector<char> sidecar = read_sidecar();
+    put<uint64_t>(sidecar, 8, 4096);
+    put<uint64_t>(sidecar, TABLE_OFFSET + 8, 160);
+    write_sidecar(sidecar);
+
+    {
+        nl::file file(NX_PATH);
+        assertEqual(2, static_cast<int>(file.bitmap_count()), "Table should be rebuilt");
+    }
+
+    assertEqual(168, static_cast<int>(table_entry(read_sidecar(), 1)), "Stale sidecar should be replaced");
+
+    // A truncated sidecar is rejected as well
+    sidecar = read_sidecar();
+    sidecar.resize(TABLE_OFFSET + 4);
+    write_sidecar(sidecar);
+
+    {
+        nl::file file(NX_PATH);
+        assertEqual(2, static_cast<int>(file.bitmap_count()), "Table should be rebuilt from a truncated sidecar");
+    }
+
+    assertEqual(static_cast<int>(TABLE_OFFSET + 16), static_cast<int>(read_sidecar().size()), "Truncated sidecar should be replaced");
+
+    cleanup();
+}
+
+} // namespace Testing
+} // namespace ms
@@ -0,0 +1,125 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../LoopbackServer.h"
+#include "../TestFramework.h"
+#include "../../Gameplay/Movement.h"
+#include "../../Net/PacketPool.h"
+#include "../../Net/Session.h"
+#include "../../Net/Packets/CommonPackets.h"
+#include "../../Net/Packets/GameplayPackets.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // Counts heap allocations while enabled, replacing the global allocation functions for the test binary
+    std::atomic<bool> counting(false);
+    std::atomic<size_t> allocations(0);
+}
+
+void* operator new(size_t size) {
+    if (counting)
+        allocations++;
+
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    const size_t ITERATIONS = 1000;
+    // Frames sent before the server reads, few enough to fit into the socket buffers
+    const size_t FRAMES_PER_BATCH = 100;
+    const size_t PACKETS_PER_FRAME = 2;
+
+    // What the game sends during a frame of gameplay, flushed like at the end of a frame
+    void sendFrame(const Movement& movement) {
+        MovePlayerPacket(movement).dispatch();
+        PongPacket().dispatch();
+
+        Session::get().flush();
+    }
+}
+
+TEST(OutPacket, SteadyStateDoesNotAllocate) {
+    LoopbackServer server;
+
+    if (!server.start())
+        skip("Could not listen on the loopback interface");
+
+    Session& session = Session::get();
+
+    assert(session.init("127.0.0.1", server.getPort().c_str()), "Session should connect to the loopback server");
+    assert(server.waitForClient(2000), "Server should accept the client");
+
+    Movement movement(100, -200, 98, -200, 2, 120);
+
+    // The first packets fill the pool and size its buffers and the batch of the session
+    for (size_t i = 0; i < 8; i++)
+        sendFrame(movement);
+
+    assert(PacketPool::get().available() > 0, "Sent packets should return their buffers to the pool");
+    assertEqual(static_cast<int>(8 * PACKETS_PER_FRAME), static_cast<int>(server.receive(8 * PACKETS_PER_FRAME, 2000).size()),
+        "Warm up packets should arrive");
+
+    size_t received = 0;
+    allocations = 0;
+
+    for (size_t sent = 0; sent < ITERATIONS; sent += FRAMES_PER_BATCH) {
+        // Building, batching, encrypting and sending the packets is counted
+        counting = true;
+
+        for (size_t i = 0; i < FRAMES_PER_BATCH; i++)
+            sendFrame(movement);
+
+        counting = false;
+
+        // The server reads between the counted frames, its buffers are not part of the send path
+        received += server.receive(FRAMES_PER_BATCH * PACKETS_PER_FRAME, 2000).size();
+    }
+
+    log("Allocations for " + std::to_string(PACKETS_PER_FRAME * ITERATIONS) + " packets: " + std::to_string(allocations.load()));
+
+    assertEqual(static_cast<int>(PACKETS_PER_FRAME * ITERATIONS), static_cast<int>(received), "Every packet should arrive");
+    assertEqual(0, static_cast<int>(allocations.load()), "Building and sending packets should reuse pooled buffers");
+
+    server.stop();
+    session.read();
+}
+
+TEST(OutPacket, SizeHints) {
+    assert(OutPacket::size_hint(OutPacket::Opcode::MOVE_PLAYER) >= 64, "Movement packets need room for their fragments");
+    assert(OutPacket::size_hint(OutPacket::Opcode::CHANGE_KEYMAP) > OutPacket::size_hint(OutPacket::Opcode::PONG),
+        "Key maps are larger than a pong");
+}
+
+}
+}
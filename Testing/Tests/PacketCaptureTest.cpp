@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../TestFramework.h"
+#include "../../Net/PacketCapture.h"
+
+#include <cstdio>
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    const char* CAPTURE_PATH = "PacketCaptureTest.mspc";
+
+    std::vector<int8_t> packet(int16_t opcode, size_t length) {
+        std::vector<int8_t> bytes(2 + length);
+        bytes[0] = static_cast<int8_t>(opcode);
+        bytes[1] = static_cast<int8_t>(opcode >> 8);
+
+        for (size_t i = 0; i < length; i++)
+            bytes[2 + i] = static_cast<int8_t>(i * 13);
+
+        return bytes;
+    }
+}
+
+TEST(PacketCapture, RoundTrip) {
+    std::vector<std::vector<int8_t>> packets = { packet(125, 3000), packet(236, 40), packet(239, 25), packet(17, 0) };
+    std::vector<int64_t> times = { 0, 7999, 8000, 20000 };
+
+    PacketRecorder recorder;
+    assert(recorder.open(CAPTURE_PATH), "Capture file should be created");
+
+    for (size_t i = 0; i < packets.size(); i++)
+        recorder.record(packets[i].data(), packets[i].size(), times[i]);
+
+    recorder.close();
+
+    PacketReplay replay;
+    assert(replay.load(CAPTURE_PATH), "Capture file should be loaded");
+
+    const std::vector<PacketReplay::Packet>& loaded = replay.get_packets();
+    assertEqual(static_cast<int>(packets.size()), static_cast<int>(loaded.size()), "Every packet should be loaded");
+
+    for (size_t i = 0; i < loaded.size(); i++) {
+        assert(loaded[i].time == times[i], "Arrival time should be kept");
+        assertEqual(static_cast<int>(packets[i].size()), static_cast<int>(loaded[i].length), "Length should be kept");
+        assert(std::memcmp(loaded[i].bytes, packets[i].data(), loaded[i].length) == 0, "Contents should be kept");
+    }
+
+    std::remove(CAPTURE_PATH);
+}
+
+TEST(PacketCapture, ReplaysByTimestep) {
+    std::vector<int8_t> bytes = packet(17, 0);
+    std::vector<int64_t> times = { 0, 7999, 8000, 20000 };
+
+    PacketRecorder recorder;
+    assert(recorder.open(CAPTURE_PATH), "Capture file should be created");
+
+    for (int64_t time : times)
+        recorder.record(bytes.data(), bytes.size(), time);
+
+    recorder.close();
+
+    PacketReplay replay;
+    assert(replay.load(CAPTURE_PATH), "Capture file should be loaded");
+
+    // Record after which update each packet was forwarded
+    size_t updates = 0;
+    std::vector<size_t> forwarded;
+
+    PacketReplay::Result result = replay.run(
+        [&](const int8_t*, size_t) { forwarded.push_back(updates); },
+        [&]() { updates++; },
+        PacketReplay::Speed::FAST
+    );
+
+    assertEqual(4, static_cast<int>(result.packets), "Every packet should be forwarded");
+    assertEqual(3, static_cast<int>(result.updates), "The last packet arrives during the third timestep");
+
+    const size_t expected[] = { 1, 1, 2, 3 };
+
+    for (size_t i = 0; i < forwarded.size(); i++)
+        assertEqual(static_cast<int>(expected[i]), static_cast<int>(forwarded[i]), "Packet should follow the update of the timestep it arrived in");
+
+    std::remove(CAPTURE_PATH);
+}
+
+TEST(PacketCapture, RejectsTruncatedFile) {
+    std::vector<int8_t> bytes = packet(125, 100);
+
+    PacketRecorder recorder;
+    assert(recorder.open(CAPTURE_PATH), "Capture file should be created");
+    recorder.record(bytes.data(), bytes.size(), 0);
+    recorder.close();
+
+    // Cut off the end of the packet
+    std::ifstream in(CAPTURE_PATH, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    std::ofstream out(CAPTURE_PATH, std::ios::binary | std::ios::trunc);
+    out.write(contents.data(), contents.size() - 10);
+    out.close();
+
+    PacketReplay replay;
+    assert(!replay.load(CAPTURE_PATH), "A truncated capture should be rejected");
+
+    std::remove(CAPTURE_PATH);
+}
+
+}
+}
@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../TestFramework.h"
+#include "../../Net/PacketSwitch.h"
+
+#include <cstring>
+#include <memory>
+#include <sstream>
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    std::vector<int8_t> packet(uint16_t opcode, size_t length) {
+        std::vector<int8_t> bytes(2 + length, 0);
+        bytes[0] = static_cast<int8_t>(opcode);
+        bytes[1] = static_cast<int8_t>(opcode >> 8);
+
+        return bytes;
+    }
+}
+
+TEST(PacketSwitch, NamesOpcodes) {
+    assert(std::strcmp(PacketSwitch::name_of(17), "PING") == 0, "Opcode 17 should be PING");
+    assert(std::strcmp(PacketSwitch::name_of(236), "SPAWN_MONSTER") == 0, "Opcode 236 should be SPAWN_MONSTER");
+    assert(PacketSwitch::name_of(PacketSwitch::NUM_HANDLERS) == nullptr, "Opcodes out of bounds have no name");
+}
+
+TEST(PacketSwitch, ProfilesOpcodes) {
+    auto packetswitch = std::make_unique<PacketSwitch>();
+
+    // PING is answered with a pong, which is dropped while there is no connection
+    std::vector<int8_t> ping = packet(17, 0);
+
+    for (size_t i = 0; i < 3; i++)
+        packetswitch->forward(ping.data(), ping.size());
+
+    // An opcode which is named but has no handler
+    std::vector<int8_t> unhandled = packet(1, 10);
+    packetswitch->forward(unhandled.data(), unhandled.size());
+
+    const PacketSwitch::Profile& pings = packetswitch->get_profile(17);
+
+    assertEqual(3, static_cast<int>(pings.count), "Every ping should be counted");
+    assertEqual(6, static_cast<int>(pings.bytes), "Bytes of every ping should be counted");
+    assert(pings.total >= pings.max && pings.max >= 0, "Total time should include the slowest packet");
+
+    assertEqual(1, static_cast<int>(packetswitch->get_profile(1).count), "Unhandled packets should be counted");
+    assertEqual(0, static_cast<int>(packetswitch->get_profile(1).total), "Unhandled packets take no handler time");
+
+    std::ostringstream dump;
+    packetswitch->dump_profile(dump);
+
+    assert(dump.str().find("PING (17)") != std::string::npos, "Dump should list received opcodes by name");
+    assert(dump.str().find("SPAWN_MONSTER") == std::string::npos, "Dump should only list received opcodes");
+
+    packetswitch->reset_profile();
+
+    assertEqual(0, static_cast<int>(packetswitch->get_profile(17).count), "Resetting should discard all measurements");
+}
+
+}
+}
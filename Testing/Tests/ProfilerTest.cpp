@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../TestFramework.h"
+#include "../../Util/Profiler.h"
+
+#include <memory>
+#include <sstream>
+
+namespace ms {
+namespace Testing {
+
+TEST(Profiler, SummarizesCompletedFrames) {
+    auto profiler = std::make_unique<Profiler>();
+
+    // Ten frames in which the stage updates twice for i + 1 and 1 microseconds
+    for (int64_t i = 0; i < 10; i++) {
+        int64_t start = i * 100000;
+
+        profiler->record(Profiler::Section::STAGE_UPDATE, start, start + (i + 1) * 1000);
+        profiler->record(Profiler::Section::STAGE_UPDATE, start, start + 1000);
+        profiler->count(Profiler::Counter::QUADS, static_cast<size_t>(100 * i));
+        profiler->next_frame();
+    }
+
+    // The frame in progress is not part of the summary
+    profiler->record(Profiler::Section::STAGE_UPDATE, 0, 1000000000);
+
+    Profiler::Summary summary = profiler->summarize();
+
+    assertEqual(10, static_cast<int>(summary.frames), "Every completed frame should be summarized");
+    assertEqual(6, static_cast<int>(summary.sections[Profiler::Section::STAGE_UPDATE].p50), "Sections should be added up per frame");
+    assertEqual(11, static_cast<int>(summary.sections[Profiler::Section::STAGE_UPDATE].max), "The slowest frame should be the maximum");
+    assertEqual(0, static_cast<int>(summary.sections[Profiler::Section::UI_DRAW].max), "Sections which never ran take no time");
+    assertEqual(900, static_cast<int>(summary.counters[Profiler::Counter::QUADS].max), "Counters should be kept per frame");
+}
+
+TEST(Profiler, KeepsOnlyRecentFrames) {
+    auto profiler = std::make_unique<Profiler>();
+
+    for (size_t i = 0; i < Profiler::FRAMES * 2; i++) {
+        // Only the first frames are slow, they should have been overwritten
+        int64_t duration = i < Profiler::FRAMES ? 50000 : 1000;
+
+        for (size_t j = 0; j < Profiler::SAMPLES + 10; j++)
+            profiler->record(Profiler::Section::UI_UPDATE, 0, duration);
+
+        profiler->next_frame();
+    }
+
+    Profiler::Summary summary = profiler->summarize();
+
+    assertEqual(static_cast<int>(Profiler::FRAMES - 1), static_cast<int>(summary.frames), "The ring should stay full");
+    assertEqual(static_cast<int>(Profiler::SAMPLES), static_cast<int>(summary.sections[Profiler::Section::UI_UPDATE].max), "Samples past the limit should be dropped");
+}
+
+TEST(Profiler, WritesChromeTrace) {
+    auto profiler = std::make_unique<Profiler>();
+
+    {
+        ScopedTimer timer(Profiler::Section::NETWORK);
+    }
+
+    profiler->record(Profiler::Section::FLUSH, 1500, 4000);
+    profiler->count(Profiler::Counter::UPLOADS, 3);
+    profiler->next_frame();
+
+    std::ostringstream trace;
+    profiler->write_trace(trace);
+
+    std::string json = trace.str();
+
+    assert(json.find("\"traceEvents\":[") != std::string::npos, "Trace should contain an event array");
+    assert(json.find("{\"name\":\"GraphicsGL::flush\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":1.5,\"dur\":2.5}") != std::string::npos, "Sections should be complete events in microseconds");
+    assert(json.find("\"uploads\":3") != std::string::npos, "Counters should be written");
+    assert(json.find("Session::read") == std::string::npos, "Scoped timers record into the shared profiler");
+    assert(json.substr(json.size() - 3) == "]}\n", "Trace should be closed");
+}
+
+}
+}
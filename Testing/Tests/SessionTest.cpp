@@ -0,0 +1,267 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../TestFramework.h"
+#include "../LoopbackServer.h"
+#include "../../Net/Session.h"
+#include "../../Configuration.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+namespace ms {
+namespace Testing {
+
+namespace {
+    const int16_t PING = 17;
+    const int16_t PONG = 24;
+
+    std::vector<int8_t> packet(int16_t opcode, size_t length) {
+        std::vector<int8_t> bytes(OPCODE_LENGTH + length);
+        bytes[0] = static_cast<int8_t>(opcode);
+        bytes[1] = static_cast<int8_t>(opcode >> 8);
+
+        for (size_t i = 0; i < length; i++)
+            bytes[OPCODE_LENGTH + i] = static_cast<int8_t>(i * 7);
+
+        return bytes;
+    }
+
+    // Cryptography of the server, which sends with the iv the client receives with
+    Cryptography serverCryptography() {
+        int8_t swapped[16];
+        std::memcpy(swapped, LoopbackServer::handshake(), 16);
+        std::memcpy(swapped + 7, LoopbackServer::handshake() + 11, HEADER_LENGTH);
+        std::memcpy(swapped + 11, LoopbackServer::handshake() + 7, HEADER_LENGTH);
+
+        return Cryptography(swapped);
+    }
+
+    int64_t microsecondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+TEST(ReceiveBuffer, FramesPacketsSplitAcrossReads) {
+    Cryptography server = serverCryptography();
+    Cryptography client(LoopbackServer::handshake());
+
+    // Packets of different sizes, the last one spanning several AES blocks
+    std::vector<std::vector<int8_t>> packets = { packet(PING, 0), packet(100, 33), packet(200, 5000), packet(PING, 1) };
+    std::vector<int8_t> stream;
+
+    for (std::vector<int8_t> bytes : packets) {
+        int8_t header[HEADER_LENGTH];
+        server.create_header(header, bytes.size());
+        server.encrypt(bytes.data(), bytes.size());
+
+        stream.insert(stream.end(), header, header + HEADER_LENGTH);
+        stream.insert(stream.end(), bytes.begin(), bytes.end());
+    }
+
+    auto buffer = std::make_unique<ReceiveBuffer>();
+    size_t received = 0;
+    size_t offset = 0;
+
+    // Feed the stream in pieces which never line up with the packet boundaries
+    while (offset < stream.size()) {
+        size_t available;
+        int8_t* bytes = buffer->reserve(available);
+        size_t count = std::min<size_t>({ 7, available, stream.size() - offset });
+
+        std::memcpy(bytes, stream.data() + offset, count);
+        buffer->commit(count);
+        offset += count;
+
+        size_t length;
+
+        while (int8_t* next = buffer->next(client, length)) {
+            assert(reinterpret_cast<uintptr_t>(next) >= reinterpret_cast<uintptr_t>(buffer.get()) &&
+                reinterpret_cast<uintptr_t>(next + length) <= reinterpret_cast<uintptr_t>(buffer.get() + 1),
+                "Packets should be handed out from inside the buffer");
+
+            client.decrypt(next, length);
+
+            assertEqual(static_cast<int>(packets[received].size()), static_cast<int>(length), "Packet length should match");
+            assert(std::memcmp(next, packets[received].data(), length) == 0, "Packet contents should match");
+
+            received++;
+        }
+    }
+
+    assertEqual(static_cast<int>(packets.size()), static_cast<int>(received), "All packets should be framed");
+    assertEqual(0, static_cast<int>(buffer->pending()), "No bytes should be left over");
+}
+
+TEST(ReceiveBuffer, RejectsInvalidLength) {
+    Cryptography client(LoopbackServer::handshake());
+    auto buffer = std::make_unique<ReceiveBuffer>();
+
+    // The halves of a header are xored to a signed 16-bit length, this one is negative
+    size_t available;
+    int8_t* bytes = buffer->reserve(available);
+    const int8_t header[HEADER_LENGTH] = { 0x00, 0x00, 0x00, -128 };
+    std::memcpy(bytes, header, HEADER_LENGTH);
+    buffer->commit(HEADER_LENGTH);
+
+    size_t length;
+
+    assert(buffer->next(client, length) == nullptr, "No packet should be returned");
+    assert(buffer->is_corrupted(), "The stream should be marked as corrupted");
+
+    buffer->clear();
+
+    assert(!buffer->is_corrupted(), "Clearing should reset the stream");
+}
+
+TEST(SendBuffer, BatchesPacketsContiguously) {
+    Cryptography client(LoopbackServer::handshake());
+    Cryptography server = serverCryptography();
+
+    std::vector<std::vector<int8_t>> packets = { packet(PONG, 0), packet(41, 20), packet(100, 3000) };
+    SendBuffer batch;
+
+    for (const std::vector<int8_t>& bytes : packets)
+        batch.append(client, bytes.data(), bytes.size());
+
+    assertEqual(3, static_cast<int>(batch.count()), "Every packet should be in the batch");
+    assertEqual(static_cast<int>(3 * HEADER_LENGTH + 2 + 22 + 3002), static_cast<int>(batch.size()), "Batch should hold headers and bodies");
+
+    // The server frames and decrypts the batch like any other stream
+    auto buffer = std::make_unique<ReceiveBuffer>();
+    size_t available;
+    std::memcpy(buffer->reserve(available), batch.data(), batch.size());
+    buffer->commit(batch.size());
+
+    size_t length;
+
+    for (const std::vector<int8_t>& bytes : packets) {
+        int8_t* next = buffer->next(server, length);
+        assertNotNull(next, "Packet should be framed from the batch");
+
+        server.decrypt(next, length);
+
+        assertEqual(static_cast<int>(bytes.size()), static_cast<int>(length), "Packet length should match");
+        assert(std::memcmp(next, bytes.data(), length) == 0, "Packet contents should match");
+    }
+
+    batch.clear();
+
+    assert(batch.empty(), "Clearing should discard the batch");
+}
+
+TEST(Session, DrainsBurstInOneRead) {
+    const size_t BURST = 64;
+
+    LoopbackServer server;
+
+    if (!server.start())
+        skip("Could not listen on the loopback interface");
+
+    Session& session = Session::get();
+
+    assert(session.init("127.0.0.1", server.getPort().c_str()), "Session should connect to the loopback server");
+    assert(server.waitForClient(2000), "Server should accept the client");
+
+    std::vector<std::vector<int8_t>> pings(BURST, packet(PING, 0));
+    assert(server.send(pings), "Server should send the burst");
+
+    // Give the loopback interface time to deliver everything
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    session.read();
+    session.flush();
+
+    Session::Counters sent = session.get_sent();
+
+    assertEqual(static_cast<int>(BURST), static_cast<int>(sent.packets), "Every pong should be counted");
+    assertEqual(static_cast<int>(BURST * (HEADER_LENGTH + OPCODE_LENGTH)), static_cast<int>(sent.bytes), "Headers and opcodes should be counted");
+    assertEqual(1, static_cast<int>(sent.sends), "All pongs should be sent with a single call");
+
+    std::vector<std::vector<int8_t>> replies = server.receive(BURST, 2000);
+
+    assertEqual(static_cast<int>(BURST), static_cast<int>(replies.size()), "Every ping should be answered after a single read");
+
+    for (const std::vector<int8_t>& reply : replies) {
+        int16_t opcode = static_cast<int16_t>(static_cast<uint8_t>(reply[0]) | (reply[1] << 8));
+        assertEqual(PONG, opcode, "Reply should be a pong");
+    }
+
+    server.stop();
+    session.read();
+
+    assert(!session.is_connected(), "Session should notice the server closing the connection");
+}
+
+TEST(Session, NetworkThreadAnswersBurst) {
+    const size_t BURST = 64;
+
+    LoopbackServer server;
+
+    if (!server.start())
+        skip("Could not listen on the loopback interface");
+
+    bool threaded = Setting<NetworkThread>::get().load();
+    Setting<NetworkThread>::get().save(true);
+
+    Session& session = Session::get();
+    bool connected = session.init("127.0.0.1", server.getPort().c_str());
+
+    Setting<NetworkThread>::get().save(threaded);
+
+    assert(connected, "Session should connect to the loopback server");
+    assert(server.waitForClient(2000), "Server should accept the client");
+
+    std::vector<std::vector<int8_t>> pings(BURST, packet(PING, 0));
+    auto start = std::chrono::steady_clock::now();
+    assert(server.send(pings), "Server should send the burst");
+
+    // The network thread decrypts in the background, the main thread only handles what is queued
+    std::vector<std::vector<int8_t>> replies;
+
+    while (replies.size() < BURST && microsecondsSince(start) < 2000000) {
+        session.read();
+        session.flush();
+
+        std::vector<std::vector<int8_t>> received = server.receive(BURST - replies.size(), 1);
+        replies.insert(replies.end(), received.begin(), received.end());
+    }
+
+    log("Round trip of " + std::to_string(BURST) + " pings: " + std::to_string(microsecondsSince(start)) + " us");
+
+    assertEqual(static_cast<int>(BURST), static_cast<int>(replies.size()), "Every ping should be answered");
+
+    for (const std::vector<int8_t>& reply : replies) {
+        int16_t opcode = static_cast<int16_t>(static_cast<uint8_t>(reply[0]) | (reply[1] << 8));
+        assertEqual(PONG, opcode, "Reply should be a pong");
+    }
+
+    server.stop();
+
+    auto deadline = std::chrono::steady_clock::now();
+
+    while (session.is_connected() && microsecondsSince(deadline) < 2000000)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    assert(!session.is_connected(), "Network thread should notice the server closing the connection");
+}
+
+}
+}
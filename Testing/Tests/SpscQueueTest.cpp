@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.										//
+//																				//
+//	This program is distributed in the hope that it will be useful,			//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.						//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "../TestFramework.h"
+#include "../../Template/SpscQueue.h"
+
+#include <thread>
+
+namespace ms {
+namespace Testing {
+
+TEST(SpscQueue, ReusesSlots) {
+    SpscQueue<int32_t, 4> queue;
+
+    assert(queue.empty(), "A new queue should be empty");
+    assert(queue.front() == nullptr, "An empty queue has no front");
+
+    for (int32_t i = 0; i < 4; i++) {
+        int32_t* slot = queue.back();
+        assertNotNull(slot, "Queue should have room");
+
+        *slot = i;
+        queue.push();
+    }
+
+    assert(queue.back() == nullptr, "A full queue has no room");
+
+    assertEqual(0, *queue.front());
+    queue.pop();
+
+    assertNotNull(queue.back(), "Popping should free a slot");
+
+    queue.clear();
+
+    assert(queue.empty(), "Clearing should discard all elements");
+}
+
+TEST(SpscQueue, KeepsOrderAcrossThreads) {
+    const int32_t COUNT = 1000000;
+
+    SpscQueue<int32_t, 256> queue;
+
+    std::thread producer([&queue, COUNT]() {
+        for (int32_t i = 0; i < COUNT; i++) {
+            int32_t* slot;
+
+            while (!(slot = queue.back()))
+                std::this_thread::yield();
+
+            *slot = i;
+            queue.push();
+        }
+    });
+
+    int32_t expected = 0;
+    bool ordered = true;
+
+    while (expected < COUNT) {
+        if (int32_t* value = queue.front()) {
+            ordered = ordered && *value == expected;
+            expected++;
+
+            queue.pop();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    assert(ordered, "Elements should arrive in the order they were pushed");
+    assert(queue.empty(), "Queue should be empty after consuming everything");
+}
+
+}
+}
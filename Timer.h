@@ -52,7 +52,7 @@ namespace ms
 		}
 
 	private:
-		using clock = std::chrono::high_resolution_clock;
+		using clock = std::chrono::steady_clock;
 
 		clock::time_point point;
 	};
@@ -86,6 +86,6 @@ namespace ms
 		}
 
 	private:
-		using clock = std::chrono::high_resolution_clock;
+		using clock = std::chrono::steady_clock;
 	};
 }
\ No newline at end of file
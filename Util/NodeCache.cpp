@@ -0,0 +1,93 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "NodeCache.h"
+
+#include <nlnx/nx.hpp>
+
+namespace ms
+{
+	nl::node NodeCache::resolve(const Path& path)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto iter = entries.find(path.hash);
+
+		if (iter != entries.end())
+		{
+			// Another path with the same hash is not cached
+			if (iter->second.path == path.text)
+				return iter->second.node;
+
+			return find(path.text);
+		}
+
+		nl::node node = find(path.text);
+		entries.emplace(path.hash, Entry{ std::string(path.text), node });
+
+		return node;
+	}
+
+	void NodeCache::clear()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		entries.clear();
+	}
+
+	uint64_t NodeCache::take_lookups()
+	{
+		uint64_t total = nl::node::lookups();
+		uint64_t count = total - lookups;
+		lookups = total;
+
+		return count;
+	}
+
+	nl::node NodeCache::find(std::string_view path)
+	{
+		size_t slash = path.find('/');
+		std::string_view file = path.substr(0, slash);
+		std::string_view rest = slash == std::string_view::npos ? std::string_view() : path.substr(slash + 1);
+
+		const std::pair<std::string_view, const nl::node*> files[] = {
+			{ "Base", &nl::nx::Base }, { "Character", &nl::nx::Character }, { "Effect", &nl::nx::Effect },
+			{ "Etc", &nl::nx::Etc }, { "Item", &nl::nx::Item }, { "Map", &nl::nx::Map },
+			{ "Map001", &nl::nx::Map001 }, { "Map002", &nl::nx::Map002 }, { "Map2", &nl::nx::Map2 },
+			{ "Mob", &nl::nx::Mob }, { "Mob001", &nl::nx::Mob001 }, { "Mob002", &nl::nx::Mob002 },
+			{ "Mob2", &nl::nx::Mob2 }, { "Npc", &nl::nx::Npc }, { "Skill", &nl::nx::Skill },
+			{ "Skill001", &nl::nx::Skill001 }, { "Skill002", &nl::nx::Skill002 }, { "Skill003", &nl::nx::Skill003 },
+			{ "Sound", &nl::nx::Sound }, { "Sound001", &nl::nx::Sound001 }, { "Sound002", &nl::nx::Sound002 },
+			{ "String", &nl::nx::String }, { "UI", &nl::nx::UI }
+		};
+
+		for (auto& entry : files)
+			if (entry.first == file)
+				return entry.second->resolve(rest);
+
+		const std::pair<std::string_view, const nl::nx::lazy_node*> lazy[] = {
+			{ "Morph", &nl::nx::Morph }, { "Quest", &nl::nx::Quest }, { "Reactor", &nl::nx::Reactor },
+			{ "Sound2", &nl::nx::Sound2 }, { "TamingMob", &nl::nx::TamingMob }
+		};
+
+		for (auto& entry : lazy)
+			if (entry.first == file)
+				return entry.second->get().resolve(rest);
+
+		return {};
+	}
+}
@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "../Template/Singleton.h"
+
+#include <nlnx/node.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace ms
+{
+	// Caches nodes by the hash of their path, so hot lookups skip building strings and walking the tree
+	// Paths start with the name of their file, like "Mob/0100100.img/attack1/info".
+	class NodeCache : public Singleton<NodeCache>
+	{
+	public:
+		// A path with its hash, which is computed at compile time for literals
+		class Path
+		{
+		public:
+			constexpr Path(std::string_view text) : text(text), hash(fnv1a(text)) {}
+			constexpr Path(const char* text) : Path(std::string_view(text)) {}
+
+			std::string_view text;
+			uint64_t hash;
+
+		private:
+			static constexpr uint64_t fnv1a(std::string_view text)
+			{
+				uint64_t value = 14695981039346656037ULL;
+
+				for (char c : text)
+				{
+					value ^= static_cast<unsigned char>(c);
+					value *= 1099511628211ULL;
+				}
+
+				return value;
+			}
+		};
+
+		// Return the node at a path, it is resolved on the first call only
+		nl::node resolve(const Path& path);
+
+		// Return the node at a path with printf style arguments like ids, formatted on the stack
+		template <typename... Args>
+		nl::node resolve_format(const char* format, Args... args)
+		{
+			char buffer[256];
+			int length = std::snprintf(buffer, sizeof(buffer), format, args...);
+
+			if (length < 0)
+				return {};
+
+			if (static_cast<size_t>(length) < sizeof(buffer))
+				return resolve(Path(std::string_view(buffer, length)));
+
+			std::string text(length, '\0');
+			std::snprintf(&text[0], text.size() + 1, format, args...);
+
+			return resolve(Path(text));
+		}
+
+		// Drop all cached nodes, they become invalid when the files are closed
+		void clear();
+
+		// Return the number of child lookups the calling thread made since the last call
+		// The main thread reports this as a counter of each frame.
+		uint64_t take_lookups();
+
+	private:
+		struct Entry
+		{
+			std::string path;
+			nl::node node;
+		};
+
+		// The keys are hashes already
+		struct Identity
+		{
+			size_t operator()(uint64_t hash) const
+			{
+				return static_cast<size_t>(hash);
+			}
+		};
+
+		// Resolve a path from the file named by its first part
+		static nl::node find(std::string_view path);
+
+		std::unordered_map<uint64_t, Entry, Identity> entries;
+		std::mutex mutex;
+		uint64_t lookups = 0;
+	};
+}
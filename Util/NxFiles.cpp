@@ -45,31 +45,18 @@ namespace ms
 				if (std::ifstream{ filename }.good() == false)
 					return Error(Error::Code::MISSING_FILE, filename);
 
-			// Check optional files and log warnings for missing ones
-			for (auto filename : filenames)
-			{
-				if (std::ifstream{ filename }.good() == false)
-				{
-					// Skip if it's a required file (already checked above)
-					bool is_required = false;
-					for (auto required : required_files)
-						if (std::strcmp(filename, required) == 0)
-						{
-							is_required = true;
-							break;
-						}
-					if (!is_required)
-					{
-						// Log warning for missing optional file (would need logging system)
-						// For now, continue without error
-					}
-				}
-			}
+			// Optional files are not probed, load_all skips the ones which are missing
 
 			// Loading NX files
 			try
 			{
 				nl::nx::load_all();
+
+#ifdef _DEBUG
+				// Release builds compile out the log, the bench reports the same times as nx-open rows
+				for (auto& time : nl::nx::load_times())
+					LOG(LOG_DEBUG, "[NxFiles] Opened " << time.name << " in " << time.microseconds << " us");
+#endif
 				
 				// Test Character.nx Hair directory immediately after loading
 				nl::node character_node = nl::nx::Character;
@@ -110,11 +97,16 @@ namespace ms
 				// Exploring NX structure
 				
 				// Check if comprehensive extraction is requested
+#ifdef _WIN32
 				char* extract_all = nullptr;
 				size_t len = 0;
 				errno_t err = _dupenv_s(&extract_all, &len, "EXTRACT_ALL_NX");
 				bool full_extraction = (err == 0 && extract_all && std::string(extract_all) == "1");
 				if (extract_all) free(extract_all);
+#else
+				const char* extract_all = std::getenv("EXTRACT_ALL_NX");
+				bool full_extraction = (extract_all && std::string(extract_all) == "1");
+#endif
 				
 				// Disable extraction for testing login screen
 				full_extraction = false;
@@ -225,38 +217,38 @@ namespace ms
 					system("mkdir nx_structures 2>nul");
 					
 					// Extract all major NX files
-					std::vector<std::pair<std::string, const nl::node*>> nx_files = {
-						{"UI", &nl::nx::UI},
-						{"Map", &nl::nx::Map},
-						{"Character", &nl::nx::Character},
-						{"Item", &nl::nx::Item},
-						{"Skill", &nl::nx::Skill},
-						{"Effect", &nl::nx::Effect},
-						{"Sound", &nl::nx::Sound},
-						{"String", &nl::nx::String},
-						{"Etc", &nl::nx::Etc},
-						{"Base", &nl::nx::Base},
-						{"Mob", &nl::nx::Mob},
-						{"Npc", &nl::nx::Npc},
-						{"Quest", &nl::nx::Quest},
-						{"Reactor", &nl::nx::Reactor}
+					std::vector<std::pair<std::string, nl::node>> nx_files = {
+						{"UI", nl::nx::UI},
+						{"Map", nl::nx::Map},
+						{"Character", nl::nx::Character},
+						{"Item", nl::nx::Item},
+						{"Skill", nl::nx::Skill},
+						{"Effect", nl::nx::Effect},
+						{"Sound", nl::nx::Sound},
+						{"String", nl::nx::String},
+						{"Etc", nl::nx::Etc},
+						{"Base", nl::nx::Base},
+						{"Mob", nl::nx::Mob},
+						{"Npc", nl::nx::Npc},
+						{"Quest", nl::nx::Quest},
+						{"Reactor", nl::nx::Reactor}
 					};
 					
 					// Check for split files
 					if (!nl::nx::Map001.name().empty()) {
-						nx_files.push_back({"Map001", &nl::nx::Map001});
+						nx_files.push_back({"Map001", nl::nx::Map001});
 					}
 					if (!nl::nx::Map002.name().empty()) {
-						nx_files.push_back({"Map002", &nl::nx::Map002});
+						nx_files.push_back({"Map002", nl::nx::Map002});
 					}
 					if (!nl::nx::Sound2.name().empty()) {
-						nx_files.push_back({"Sound2", &nl::nx::Sound2});
+						nx_files.push_back({"Sound2", nl::nx::Sound2});
 					}
 					
 					// Extract each file
 					for (const auto& nx_pair : nx_files) {
 						const std::string& name = nx_pair.first;
-						const nl::node& nx_node = *nx_pair.second;
+						const nl::node& nx_node = nx_pair.second;
 						
 						if (nx_node.size() == 0) {
 							// Skipping empty/not loaded nx file
@@ -304,7 +296,7 @@ namespace ms
 					summary << "📁 AVAILABLE NX FILES:" << std::endl;
 					int total_available = 0;
 					for (const auto& nx_pair : nx_files) {
-						const nl::node& node = *nx_pair.second;
+						const nl::node& node = nx_pair.second;
 						if (node.size() > 0) {
 							summary << "  ✅ " << nx_pair.first << "_current.txt - " << node.size() << " root items" << std::endl;
 							total_available++;
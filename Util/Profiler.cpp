@@ -0,0 +1,221 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ms
+{
+	namespace
+	{
+		// Nearest rank percentile of unsorted values
+		int64_t percentile(std::vector<int64_t>& values, double fraction)
+		{
+			if (values.empty())
+				return 0;
+
+			size_t rank = static_cast<size_t>(std::ceil(fraction * values.size()));
+			size_t index = std::min(rank > 0 ? rank - 1 : 0, values.size() - 1);
+
+			std::nth_element(values.begin(), values.begin() + index, values.end());
+
+			return values[index];
+		}
+
+		Profiler::Stats stats(std::vector<int64_t>& values, int64_t divisor)
+		{
+			Profiler::Stats result;
+			result.p50 = percentile(values, 0.5) / divisor;
+			result.p99 = percentile(values, 0.99) / divisor;
+			result.max = percentile(values, 1.0) / divisor;
+
+			return result;
+		}
+
+		// Chrome trace times are in microseconds
+		void write_time(std::ostream& out, int64_t nanoseconds)
+		{
+			out << nanoseconds / 1000 << '.' << static_cast<char>('0' + (nanoseconds / 100) % 10);
+		}
+	}
+
+	Profiler::Profiler()
+	{
+		epoch = std::chrono::steady_clock::now();
+		current = 0;
+
+		frames[0] = {};
+	}
+
+	void Profiler::next_frame()
+	{
+		int64_t time = now();
+
+		frames[current % FRAMES].end = time;
+		current++;
+
+		Frame& frame = frames[current % FRAMES];
+		frame.start = time;
+		frame.end = time;
+		frame.count = 0;
+
+		for (size_t i = 0; i < NUM_COUNTERS; i++)
+			frame.counters[i] = 0;
+	}
+
+	void Profiler::record(Section section, int64_t start, int64_t end)
+	{
+		Frame& frame = frames[current % FRAMES];
+
+		if (frame.count < SAMPLES)
+			frame.samples[frame.count++] = { start, end - start, section };
+	}
+
+	void Profiler::count(Counter counter, size_t value)
+	{
+		frames[current % FRAMES].counters[counter] = value;
+	}
+
+	int64_t Profiler::now() const
+	{
+		auto elapsed = std::chrono::steady_clock::now() - epoch;
+
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+	}
+
+	size_t Profiler::completed() const
+	{
+		return static_cast<size_t>(std::min<uint64_t>(current, FRAMES - 1));
+	}
+
+	const Profiler::Frame& Profiler::completed_frame(size_t index) const
+	{
+		return frames[(current - completed() + index) % FRAMES];
+	}
+
+	Profiler::Summary Profiler::summarize() const
+	{
+		Summary summary = {};
+		summary.frames = completed();
+
+		if (summary.frames == 0)
+			return summary;
+
+		std::vector<int64_t> values(summary.frames);
+
+		for (size_t s = 0; s < NUM_SECTIONS; s++)
+		{
+			for (size_t i = 0; i < summary.frames; i++)
+			{
+				const Frame& frame = completed_frame(i);
+				int64_t total = 0;
+
+				for (size_t j = 0; j < frame.count; j++)
+					if (frame.samples[j].section == s)
+						total += frame.samples[j].duration;
+
+				values[i] = total;
+			}
+
+			summary.sections[s] = stats(values, 1000);
+		}
+
+		for (size_t i = 0; i < summary.frames; i++)
+		{
+			const Frame& frame = completed_frame(i);
+			values[i] = frame.end - frame.start;
+		}
+
+		summary.frame = stats(values, 1000);
+
+		for (size_t c = 0; c < NUM_COUNTERS; c++)
+		{
+			for (size_t i = 0; i < summary.frames; i++)
+				values[i] = static_cast<int64_t>(completed_frame(i).counters[c]);
+
+			summary.counters[c] = stats(values, 1);
+		}
+
+		return summary;
+	}
+
+	void Profiler::write_trace(std::ostream& out) const
+	{
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+		out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Main\"}}";
+
+		for (size_t i = 0; i < completed(); i++)
+		{
+			const Frame& frame = completed_frame(i);
+
+			out << "," << std::endl << "{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":";
+			write_time(out, frame.start);
+			out << ",\"dur\":";
+			write_time(out, frame.end - frame.start);
+			out << "}";
+
+			for (size_t j = 0; j < frame.count; j++)
+			{
+				const Sample& sample = frame.samples[j];
+
+				out << "," << std::endl << "{\"name\":\"" << name_of(sample.section) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":";
+				write_time(out, sample.start);
+				out << ",\"dur\":";
+				write_time(out, sample.duration);
+				out << "}";
+			}
+
+			out << "," << std::endl << "{\"name\":\"Graphics\",\"ph\":\"C\",\"pid\":1,\"ts\":";
+			write_time(out, frame.start);
+			out << ",\"args\":{\"quads\":" << frame.counters[QUADS] << ",\"uploads\":" << frame.counters[UPLOADS] << "}}";
+
+			out << "," << std::endl << "{\"name\":\"Data\",\"ph\":\"C\",\"pid\":1,\"ts\":";
+			write_time(out, frame.start);
+			out << ",\"args\":{\"node lookups\":" << frame.counters[NODE_LOOKUPS] << "}}";
+		}
+
+		out << std::endl << "]}" << std::endl;
+	}
+
+	const char* Profiler::name_of(Section section)
+	{
+		switch (section)
+		{
+			case EVENTS:
+				return "Window::check_events";
+			case STAGE_UPDATE:
+				return "Stage::update";
+			case MAP_LOAD:
+				return "Stage::continue_load";
+			case UI_UPDATE:
+				return "UI::update";
+			case NETWORK:
+				return "Session::read";
+			case STAGE_DRAW:
+				return "Stage::draw";
+			case UI_DRAW:
+				return "UI::draw";
+			case FLUSH:
+				return "GraphicsGL::flush";
+			default:
+				return "";
+		}
+	}
+}
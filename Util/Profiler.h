@@ -0,0 +1,137 @@
+//////////////////////////////////////////////////////////////////////////////////
+//	This file is part of the continued Journey MMORPG client					//
+//	Copyright (C) 2015-2019  Daniel Allendorf, Ryan Payton						//
+//																				//
+//	This program is free software: you can redistribute it and/or modify		//
+//	it under the terms of the GNU Affero General Public License as published by	//
+//	the Free Software Foundation, either version 3 of the License, or			//
+//	(at your option) any later version.											//
+//																				//
+//	This program is distributed in the hope that it will be useful,				//
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of				//
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the				//
+//	GNU Affero General Public License for more details.							//
+//																				//
+//	You should have received a copy of the GNU Affero General Public License	//
+//	along with this program.  If not, see <https://www.gnu.org/licenses/>.		//
+//////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "../Template/Singleton.h"
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace ms
+{
+	// Records how long the sections of each frame take into a ring of the most recent frames
+	// The ring is allocated once and written without locks, only the main thread records.
+	class Profiler : public Singleton<Profiler>
+	{
+	public:
+		enum Section : uint8_t
+		{
+			EVENTS,
+			STAGE_UPDATE,
+			MAP_LOAD,
+			UI_UPDATE,
+			NETWORK,
+			STAGE_DRAW,
+			UI_DRAW,
+			FLUSH,
+			NUM_SECTIONS
+		};
+
+		enum Counter : uint8_t
+		{
+			QUADS,
+			UPLOADS,
+			NODE_LOOKUPS,
+			NUM_COUNTERS
+		};
+
+		// Percentiles over the frames in the ring
+		struct Stats
+		{
+			int64_t p50;
+			int64_t p99;
+			int64_t max;
+		};
+
+		struct Summary
+		{
+			// Microseconds spent in each section per frame, a section may run several times in one frame
+			Stats sections[NUM_SECTIONS];
+			Stats frame;
+			Stats counters[NUM_COUNTERS];
+			size_t frames;
+		};
+
+		Profiler();
+
+		// Complete the current frame and start the next one
+		void next_frame();
+		// Add a section which ran during the current frame, times are from 'now()'
+		void record(Section section, int64_t start, int64_t end);
+		// Set a counter of the current frame
+		void count(Counter counter, size_t value);
+		// Return the nanoseconds since the profiler was created
+		int64_t now() const;
+
+		// Compute percentiles over the completed frames in the ring
+		Summary summarize() const;
+		// Write the completed frames in the ring as a Chrome trace, which chrome://tracing and Perfetto open
+		void write_trace(std::ostream& out) const;
+
+		// Return the name of a section as shown in the overlay and the trace
+		static const char* name_of(Section section);
+
+		// Frames kept, a few seconds at the usual frame rates
+		static constexpr size_t FRAMES = 512;
+		// Sections kept per frame, further ones are dropped until the next frame
+		static constexpr size_t SAMPLES = 64;
+
+	private:
+		struct Sample
+		{
+			int64_t start;
+			int64_t duration;
+			Section section;
+		};
+
+		struct Frame
+		{
+			int64_t start;
+			int64_t end;
+			size_t count;
+			size_t counters[NUM_COUNTERS];
+			Sample samples[SAMPLES];
+		};
+
+		// Return the number of completed frames in the ring
+		size_t completed() const;
+		// Return a completed frame, zero is the oldest one
+		const Frame& completed_frame(size_t index) const;
+
+		Frame frames[FRAMES];
+		uint64_t current;
+		std::chrono::steady_clock::time_point epoch;
+	};
+
+	// Records the time from its construction to its destruction as a section of the current frame
+	class ScopedTimer
+	{
+	public:
+		ScopedTimer(Profiler::Section section) : section(section), start(Profiler::get().now()) {}
+
+		~ScopedTimer()
+		{
+			Profiler::get().record(section, start, Profiler::get().now());
+		}
+
+	private:
+		Profiler::Section section;
+		int64_t start;
+	};
+}
@@ -18,6 +18,9 @@
 
 #include "bitmap.hpp"
 #include <lz4.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <fstream>
 #include <iostream>
@@ -34,7 +37,8 @@ namespace nl {
     bitmap::operator bool() const {
         return m_data ? true : false;
     }
-    std::vector<char> bitmap_buf;
+    //Each thread decompresses into its own buffer so bitmaps can be decoded off the main thread
+    thread_local std::vector<char> bitmap_buf;
     void const * bitmap::data() const {
         if (!m_data)
             return nullptr;
@@ -49,6 +53,47 @@ namespace nl {
             
         return bitmap_buf.data();
     }
+    bool bitmap::decode_into(void * dst, size_t cap) const {
+        if (!m_data || !dst)
+            return false;
+        auto const l = length();
+        if (cap < l)
+            return false;
+        //The compressed size is stored in front of the data
+        auto const compressed = *reinterpret_cast<uint32_t const *>(m_data);
+        auto const result = ::LZ4_decompress_safe(4 + reinterpret_cast<char const *>(m_data),
+            reinterpret_cast<char *>(dst), static_cast<int>(compressed), static_cast<int>(l));
+        return result == static_cast<int>(l);
+    }
+    void const * bitmap::decode_scratch() const {
+        auto const l = length();
+        if (l > bitmap_buf.size())
+            bitmap_buf.resize(l);
+        return decode_into(bitmap_buf.data(), bitmap_buf.size()) ? bitmap_buf.data() : nullptr;
+    }
+    size_t bitmap::decode_batch(bitmap const * bitmaps, void * const * dsts,
+        size_t count, unsigned threads) {
+        if (!threads)
+            threads = std::max(std::thread::hardware_concurrency(), 1u);
+        if (threads > count)
+            threads = static_cast<unsigned>(count);
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> decoded{0};
+        auto work = [&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                if (bitmaps[i].decode_into(dsts[i], bitmaps[i].length()))
+                    ++decoded;
+            }
+        };
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads; ++i)
+            workers.emplace_back(work);
+        //The calling thread takes part as well
+        work();
+        for (auto & worker : workers)
+            worker.join();
+        return decoded;
+    }
     uint16_t bitmap::width() const {
         return m_width;
     }
@@ -58,6 +103,15 @@ namespace nl {
     uint32_t bitmap::length() const {
         return 4u * m_width * m_height;
     }
+    size_t bitmap::touch() const {
+        if (!m_data)
+            return 0;
+        auto const compressed = *reinterpret_cast<uint32_t const *>(m_data);
+        auto const bytes = reinterpret_cast<unsigned char const volatile *>(m_data);
+        for (size_t i = 0; i < compressed + 4; i += 4096)
+            static_cast<void>(bytes[i]);
+        return compressed;
+    }
     size_t bitmap::id() const {
         return reinterpret_cast<size_t>(m_data);
     }
@@ -34,12 +34,31 @@ namespace nl {
         explicit operator bool() const;
         //This function decompresses the data on the fly
         //Do not free the pointer returned by this method
-        //Every time this function is called
+        //Every time this function is called on the same thread
         //any previous pointers returned by this method become invalid
         void const * data() const;
+        //Decompresses the data into the given buffer without allocating
+        //Safe to call from any thread as long as each thread uses its own buffer
+        //Returns false if the bitmap is null, the buffer is smaller than length()
+        //or the compressed data is malformed
+        bool decode_into(void * dst, size_t cap) const;
+        //Decompresses the data into a scratch buffer owned by the calling thread
+        //The pointer stays valid until the same thread decodes another bitmap
+        //Returns nullptr if the bitmap is null or the data is malformed
+        void const * decode_scratch() const;
+        //Decompresses each bitmap into the matching destination buffer
+        //spreading the work across the given number of threads
+        //(0 uses one thread per hardware thread)
+        //Each destination must hold at least length() bytes of its bitmap
+        //Returns the number of bitmaps which were decoded successfully
+        static size_t decode_batch(bitmap const * bitmaps, void * const * dsts,
+            size_t count, unsigned threads = 0);
         uint16_t width() const;
         uint16_t height() const;
         uint32_t length() const;
+        //Reads one byte of each page of the compressed data, so decoding it later does not fault
+        //Safe to call from any thread, returns the number of compressed bytes
+        size_t touch() const;
         //Returns a unique id, useful for keeping track of what bitmaps you loaded
         size_t id() const;
     private:
@@ -38,9 +38,38 @@
 #  include <sys/mman.h>
 #  include <unistd.h>
 #endif
+#include <cstring>
+#include <fstream>
 #include <stdexcept>
 
 namespace nl {
+    namespace {
+        // The sidecar starts with this header, followed by 'count' bitmap offsets
+        // Bump the version whenever the layout or the way the table is built changes.
+        struct sidecar_header {
+            char magic[4];
+            uint32_t version;
+            uint64_t file_size;
+            int64_t mtime;
+            uint64_t header_hash;
+            uint64_t count;
+        };
+        // The sidecar is read as 64 bit words, the table has to start on a word of its own
+        static_assert(sizeof(sidecar_header) % sizeof(uint64_t) == 0, "Sidecar header must keep the offsets aligned");
+        char const sidecar_magic[4] = {'N', 'X', 'B', 'T'};
+        uint32_t const sidecar_version = 1;
+
+        // FNV-1a over the nx header, which changes with the counts and offsets of the tables
+        uint64_t hash_header(file::header const * header) {
+            auto bytes = reinterpret_cast<unsigned char const *>(header);
+            uint64_t hash = 14695981039346656037ULL;
+            for (size_t i = 0; i < sizeof(file::header); ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+    }
     file::file(std::string name) {
         open(name);
     }
@@ -67,6 +96,12 @@ namespace nl {
 #  endif
         if (m_data->file_handle == INVALID_HANDLE_VALUE)
             throw std::runtime_error("Failed to open file " + name);
+        LARGE_INTEGER file_size;
+        FILETIME write_time;
+        if (::GetFileSizeEx(m_data->file_handle, &file_size))
+            m_data->file_size = static_cast<uint64_t>(file_size.QuadPart);
+        if (::GetFileTime(m_data->file_handle, nullptr, nullptr, &write_time))
+            m_data->mtime = (static_cast<int64_t>(write_time.dwHighDateTime) << 32) | write_time.dwLowDateTime;
 #  if WINAPI_FAMILY == WINAPI_FAMILY_APP
         m_data->map = ::CreateFileMappingFromApp(m_data->file_handle, 0, PAGE_READONLY, 0, nullptr);
 #  else
@@ -89,6 +124,8 @@ namespace nl {
         if (::fstat(m_data->file_handle, &finfo) == -1)
             throw std::runtime_error("Failed to obtain file information of file " + name);
         m_data->size = finfo.st_size;
+        m_data->file_size = static_cast<uint64_t>(finfo.st_size);
+        m_data->mtime = static_cast<int64_t>(finfo.st_mtime);
         m_data->base = ::mmap(nullptr, m_data->size, PROT_READ, MAP_SHARED, m_data->file_handle, 0);
         if (reinterpret_cast<intptr_t>(m_data->base) == -1)
             throw std::runtime_error("Failed to create memory mapping of file " + name);
@@ -102,8 +139,12 @@ namespace nl {
         m_data->audio_table = reinterpret_cast<uint64_t const *>(reinterpret_cast<char const *>(m_data->base) + m_data->header->audio_offset);
         
         // v92 NX compatibility: handle files with bitmap_count=0 but containing bitmap nodes
+        // The table is cached in a sidecar, as building it touches nearly every page of the file
         if (m_data->header->bitmap_count == 0) {
-            build_synthetic_bitmap_table(name);
+            if (!load_bitmap_sidecar(name)) {
+                build_synthetic_bitmap_table(name);
+                save_bitmap_sidecar(name);
+            }
         }
     }
     void file::close() {
@@ -146,6 +187,59 @@ namespace nl {
         return {s + 2, *reinterpret_cast<uint16_t const *>(s)};
     }
     
+    std::string file::bitmap_sidecar(std::string const & name) {
+        return name + ".bitmaps";
+    }
+
+    bool file::load_bitmap_sidecar(std::string const & filename) {
+        std::ifstream in(bitmap_sidecar(filename), std::ios::binary | std::ios::ate);
+        if (!in)
+            return false;
+        auto length = static_cast<size_t>(in.tellg());
+        if (length < sizeof(sidecar_header) || (length - sizeof(sidecar_header)) % sizeof(uint64_t) != 0)
+            return false;
+        // Everything is read at once, the header is checked afterwards
+        std::vector<uint64_t> contents(length / sizeof(uint64_t));
+        in.seekg(0);
+        if (!in.read(reinterpret_cast<char *>(contents.data()), length))
+            return false;
+        sidecar_header header;
+        std::memcpy(&header, contents.data(), sizeof(header));
+        if (std::memcmp(header.magic, sidecar_magic, sizeof(sidecar_magic)) != 0
+            || header.version != sidecar_version
+            || header.file_size != m_data->file_size
+            || header.mtime != m_data->mtime
+            || header.header_hash != hash_header(m_data->header)
+            || header.count != (length - sizeof(sidecar_header)) / sizeof(uint64_t))
+            return false;
+        auto table = contents.begin() + sizeof(sidecar_header) / sizeof(uint64_t);
+        m_data->synthetic_bitmap_table.assign(table, contents.end());
+        if (!m_data->synthetic_bitmap_table.empty()) {
+            m_data->v92_mode = true;
+            m_data->bitmap_table = m_data->synthetic_bitmap_table.data();
+        }
+        return true;
+    }
+
+    void file::save_bitmap_sidecar(std::string const & filename) const {
+        // An empty table is saved as well, it records that there was nothing to find
+        bool const synthetic = m_data->v92_mode;
+        sidecar_header header;
+        std::memcpy(header.magic, sidecar_magic, sizeof(sidecar_magic));
+        header.version = sidecar_version;
+        header.file_size = m_data->file_size;
+        header.mtime = m_data->mtime;
+        header.header_hash = hash_header(m_data->header);
+        header.count = synthetic ? m_data->synthetic_bitmap_table.size() : 0;
+        std::ofstream out(bitmap_sidecar(filename), std::ios::binary | std::ios::trunc);
+        if (!out)
+            return;
+        out.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        if (synthetic)
+            out.write(reinterpret_cast<char const *>(m_data->synthetic_bitmap_table.data()),
+                      m_data->synthetic_bitmap_table.size() * sizeof(uint64_t));
+    }
+
     void file::build_synthetic_bitmap_table(const std::string& filename) {
         
         // First pass: count bitmap nodes and check if any exist
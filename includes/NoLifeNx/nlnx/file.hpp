@@ -65,10 +65,16 @@ namespace nl {
         uint32_t node_count() const;
         //Returns the string with a given id number
         std::string get_string(uint32_t) const;
+        //Returns the name of the sidecar which caches the synthetic bitmap table of an nx file
+        static std::string bitmap_sidecar(std::string const & name);
     private:
         data * m_data = nullptr;
         //v92 compatibility: builds synthetic bitmap table for files with bitmap_count=0
         void build_synthetic_bitmap_table(const std::string& filename);
+        //Loads the synthetic bitmap table from its sidecar, fails if the file changed since it was written
+        bool load_bitmap_sidecar(std::string const & filename);
+        //Writes the synthetic bitmap table to its sidecar, failures are ignored
+        void save_bitmap_sidecar(std::string const & filename) const;
         friend node;
         friend bitmap;
         friend audio;
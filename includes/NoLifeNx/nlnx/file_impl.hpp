@@ -45,6 +45,9 @@ namespace nl {
         // v92 compatibility: synthetic bitmap table for files with bitmap_count=0
         std::vector<uint64_t> synthetic_bitmap_table;
         bool v92_mode = false;
+        // Size and last write time, which identify the file for the bitmap table sidecar
+        uint64_t file_size = 0;
+        int64_t mtime = 0;
 #ifdef _WIN32
         void * file_handle = nullptr;
         void * map = nullptr;
@@ -30,6 +30,9 @@
 #include <algorithm>
 
 namespace nl {
+    namespace {
+        thread_local uint64_t lookup_count = 0;
+    }
     node::node(node const & o) :
         m_data(o.m_data), m_file(o.m_file) {}
     node::node(data const * d, file::data const * f) :
@@ -76,22 +79,24 @@ namespace nl {
         return n.get_string() + s;
     }
     node node::operator[](unsigned int n) const {
-        return operator[](std::to_string(n));
+        return get_child(n, false);
     }
     node node::operator[](signed int n) const {
-        return operator[](std::to_string(n));
+        return operator[](static_cast<signed long long>(n));
     }
     node node::operator[](unsigned long n) const {
-        return operator[](std::to_string(n));
+        return get_child(n, false);
     }
     node node::operator[](signed long n) const {
-        return operator[](std::to_string(n));
+        return operator[](static_cast<signed long long>(n));
     }
     node node::operator[](unsigned long long n) const {
-        return operator[](std::to_string(n));
+        return get_child(n, false);
     }
     node node::operator[](signed long long n) const {
-        return operator[](std::to_string(n));
+        if (n < 0)
+            return get_child(0ULL - static_cast<unsigned long long>(n), true);
+        return get_child(static_cast<unsigned long long>(n), false);
     }
     node node::operator[](std::string const & o) const {
         return get_child(o.c_str(), static_cast<uint16_t>(o.length()));
@@ -312,9 +317,24 @@ namespace nl {
     node::type node::data_type() const {
         return m_data ? m_data->type : type::none;
     }
+    node node::get_child(unsigned long long const n, bool const negative) const {
+        //Formats the digits backwards into a buffer on the stack
+        char buffer[24];
+        auto const end = buffer + sizeof(buffer);
+        auto begin = end;
+        auto rest = n;
+        do {
+            *--begin = static_cast<char>('0' + rest % 10);
+            rest /= 10;
+        } while (rest);
+        if (negative)
+            *--begin = '-';
+        return get_child(begin, static_cast<uint16_t>(end - begin));
+    }
     node node::get_child(char const * const o, uint16_t const l) const {
         if (!m_data)
             return {nullptr, m_file};
+        ++lookup_count;
         auto p = m_file->node_table + m_data->children;
         auto n = m_data->num;
         auto const b = reinterpret_cast<const char *>(m_file->base);
@@ -380,16 +400,19 @@ namespace nl {
     node node::root() const {
         return {m_file->node_table, m_file};
     }
-    node node::resolve(std::string path) const {
-        std::istringstream stream(path);
-        std::vector<std::string> parts;
-        std::string segment;
-        while (std::getline(stream, segment, '/'))
-            parts.push_back(segment);
+    node node::resolve(std::string_view path) const {
         auto n = *this;
-        for (auto & part : parts) {
-            n = n[part];
+        while (!path.empty()) {
+            auto const slash = path.find('/');
+            auto const part = path.substr(0, slash);
+            n = n.get_child(part.data(), static_cast<uint16_t>(part.size()));
+            if (slash == std::string_view::npos)
+                break;
+            path.remove_prefix(slash + 1);
         }
         return n;
     }
+    uint64_t node::lookups() {
+        return lookup_count;
+    }
 }
@@ -19,6 +19,7 @@
 #pragma once
 #include "nxfwd.hpp"
 #include <string>
+#include <string_view>
 #include <cstdint>
 #include <cstddef>
 
@@ -64,7 +65,7 @@ namespace nl {
         explicit operator bool() const;
         //Methods to access the children of the node by name
         //Note that the versions taking integers convert the integer to a string
-        //They do not access the children by their integer index
+        //without allocating, they do not access the children by their integer index
         //If you wish to do that, use somenode.begin() + integer_index
         node operator[](unsigned int) const;
         node operator[](signed int) const;
@@ -120,11 +121,14 @@ namespace nl {
         type data_type() const;
         //Returns the root node of the file this node was derived from
         node root() const;
-        //Takes a '/' separated string, and resolves the given path
-        node resolve(std::string) const;
+        //Takes a '/' separated string, and resolves the given path without allocating
+        node resolve(std::string_view) const;
+        //Returns the number of children looked up by name on the calling thread so far
+        static uint64_t lookups();
     private:
         node(data const *, _file_data const *);
         node get_child(char const *, uint16_t) const;
+        node get_child(unsigned long long, bool) const;
         int64_t to_integer() const;
         double to_real() const;
         std::string to_string() const;
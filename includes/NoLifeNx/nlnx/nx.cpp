@@ -19,107 +19,158 @@
 #include "file.hpp"
 #include "node.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
-#include <vector>
 #include <memory>
 #include <stdexcept>
-#include <iostream>
+#include <thread>
+#include <vector>
 
 namespace nl
 {
 	namespace nx
 	{
 		std::vector<std::unique_ptr<file>> files;
+		std::vector<load_time> times;
+		std::mutex files_mutex;
 
 		bool exists(std::string name)
 		{
 			return std::ifstream(name).is_open();
 		}
 
-		node add_file(std::string name)
+		// Opens a file and records the time it took, returns nullptr if it is missing or broken
+		std::unique_ptr<file> open_file(std::string const & name, bool lazy)
 		{
-			if (!exists(name)) {
-				return {};
-			}
+			auto start = std::chrono::steady_clock::now();
+			std::unique_ptr<file> opened;
 
 			try {
-				files.emplace_back(new file(name));
-				return *files.back();
-			} catch (const std::exception& e) {
-				return {};
+				opened.reset(new file(name));
+			} catch (const std::exception&) {
+				return nullptr;
 			}
+
+			auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+			std::lock_guard<std::mutex> lock(files_mutex);
+			times.push_back({ name, elapsed.count(), lazy });
+
+			return opened;
 		}
 
-		node Base, Character, Effect, Etc, Item, Map, Map001, Map002, Map2, Mob, Mob001, Mob002, Mob2, Morph, Npc, Quest, Reactor, Skill, Skill001, Skill002, Skill003, Sound, Sound001, Sound002, Sound2, String, TamingMob, UI;
+		node lazy_node::get() const
+		{
+			std::call_once(loaded, [this]() {
+				if (load)
+					value = load();
+			});
+
+			return value;
+		}
+
+		node Base, Character, Effect, Etc, Item, Map, Map001, Map002, Map2, Mob, Mob001, Mob002, Mob2, Npc, Skill, Skill001, Skill002, Skill003, Sound, Sound001, Sound002, String, UI;
+		lazy_node Morph, Quest, Reactor, Sound2, TamingMob;
 
 		void load_all()
 		{
+			std::pair<char const *, node*> const eager[] = {
+				{ "Base", &Base }, { "Character", &Character }, { "Effect", &Effect }, { "Etc", &Etc },
+				{ "Item", &Item }, { "Map", &Map }, { "Map001", &Map001 }, { "Map002", &Map002 },
+				{ "Map2", &Map2 }, { "Mob", &Mob }, { "Mob001", &Mob001 }, { "Mob002", &Mob002 },
+				{ "Mob2", &Mob2 }, { "Npc", &Npc }, { "Skill", &Skill }, { "Skill001", &Skill001 },
+				{ "Skill002", &Skill002 }, { "Skill003", &Skill003 }, { "Sound", &Sound },
+				{ "Sound001", &Sound001 }, { "Sound002", &Sound002 }, { "String", &String }, { "UI", &UI }
+			};
+			std::pair<char const *, lazy_node*> const lazy[] = {
+				{ "Morph", &Morph }, { "Quest", &Quest }, { "Reactor", &Reactor },
+				{ "Sound2", &Sound2 }, { "TamingMob", &TamingMob }
+			};
+			size_t const count = sizeof(eager) / sizeof(eager[0]);
+
 			if (exists("Base.nx"))
 			{
-				Base = add_file("Base.nx");
-				Character = add_file("Character.nx");
-				Effect = add_file("Effect.nx");
-				Etc = add_file("Etc.nx");
-				Item = add_file("Item.nx");
-				Map = add_file("Map.nx");
-				Map001 = add_file("Map001.nx");
-				Map002 = add_file("Map002.nx");
-				Map2 = add_file("Map2.nx");
-				Mob = add_file("Mob.nx");
-				Mob001 = add_file("Mob001.nx");
-				Mob002 = add_file("Mob002.nx");
-				Mob2 = add_file("Mob2.nx");
-				Morph = add_file("Morph.nx");
-				Npc = add_file("Npc.nx");
-				Quest = add_file("Quest.nx");
-				Reactor = add_file("Reactor.nx");
-				Skill = add_file("Skill.nx");
-				Skill001 = add_file("Skill001.nx");
-				Skill002 = add_file("Skill002.nx");
-				Skill003 = add_file("Skill003.nx");
-				Sound = add_file("Sound.nx");
-				Sound001 = add_file("Sound001.nx");
-				Sound002 = add_file("Sound002.nx");
-				Sound2 = add_file("Sound2.nx");
-				String = add_file("String.nx");
-				TamingMob = add_file("TamingMob.nx");
-				UI = add_file("UI.nx");
+				// Each worker takes the next file until all are open
+				std::vector<std::unique_ptr<file>> opened(count);
+				std::atomic<size_t> next(0);
+				size_t workers = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), count);
+				std::vector<std::thread> pool;
+
+				for (size_t i = 0; i < workers; ++i)
+				{
+					pool.emplace_back([&]() {
+						for (size_t j = next++; j < count; j = next++)
+							opened[j] = open_file(std::string(eager[j].first) + ".nx", false);
+					});
+				}
+
+				for (auto& worker : pool)
+					worker.join();
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (!opened[i])
+						continue;
+
+					*eager[i].second = *opened[i];
+					files.push_back(std::move(opened[i]));
+				}
+
+				for (auto& entry : lazy)
+				{
+					std::string name = std::string(entry.first) + ".nx";
+
+					entry.second->load = [name]() -> node {
+						auto opened = open_file(name, true);
+
+						if (!opened)
+							return {};
+
+						node root = *opened;
+
+						std::lock_guard<std::mutex> lock(files_mutex);
+						files.push_back(std::move(opened));
+
+						return root;
+					};
+				}
 			}
 			else if (exists("Data.nx"))
 			{
-				Base = add_file("Data.nx");
-				Character = Base["Character"];
-				Effect = Base["Effect"];
-				Etc = Base["Etc"];
-				Item = Base["Item"];
-				Map = Base["Map"];
-				Map001 = Base["Map001"];
-				Map002 = Base["Map002"];
-				Map2 = Base["Map2"];
-				Mob = Base["Mob"];
-				Mob001 = Base["Mob001"];
-				Mob002 = Base["Mob002"];
-				Mob2 = Base["Mob2"];
-				Morph = Base["Morph"];
-				Npc = Base["Npc"];
-				Quest = Base["Quest"];
-				Reactor = Base["Reactor"];
-				Skill = Base["Skill"];
-				Skill001 = Base["Skill001"];
-				Skill002 = Base["Skill002"];
-				Skill003 = Base["Skill003"];
-				Sound = Base["Sound"];
-				Sound001 = Base["Sound001"];
-				Sound002 = Base["Sound002"];
-				Sound2 = Base["Sound2"];
-				String = Base["String"];
-				TamingMob = Base["TamingMob"];
-				UI = Base["UI"];
+				auto opened = open_file("Data.nx", false);
+
+				// Like the separate files, a file which fails to open leaves its nodes empty
+				if (opened)
+				{
+					Base = *opened;
+					files.push_back(std::move(opened));
+				}
+
+				for (size_t i = 1; i < count; ++i)
+					*eager[i].second = Base[eager[i].first];
+
+				for (auto& entry : lazy)
+				{
+					std::string name = entry.first;
+
+					entry.second->load = [name]() {
+						return Base[name];
+					};
+				}
 			}
 			else
 			{
 				throw std::runtime_error("Failed to locate nx files.");
 			}
 		}
+
+		std::vector<load_time> load_times()
+		{
+			std::lock_guard<std::mutex> lock(files_mutex);
+
+			return times;
+		}
 	}
-}
\ No newline at end of file
+}
@@ -16,18 +16,77 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.    //
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
-#include "nxfwd.hpp"
+#include "node.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace nl
 {
 	namespace nx
 	{
+		// A node which is loaded the first time it is accessed
+		// Used for files which are rarely needed, so they do not slow down startup.
+		class lazy_node
+		{
+		public:
+			// Returns the node, loading it on the first call
+			node get() const;
+
+			operator node() const
+			{
+				return get();
+			}
+
+			template <typename T>
+			node operator[](T&& key) const
+			{
+				return get()[std::forward<T>(key)];
+			}
+
+			std::string name() const
+			{
+				return get().name();
+			}
+
+			explicit operator bool() const
+			{
+				return static_cast<bool>(get());
+			}
+
+		private:
+			friend void load_all();
+
+			mutable std::once_flag loaded;
+			mutable node value;
+			std::function<node()> load;
+		};
+
+		// Time spent opening a file
+		struct load_time
+		{
+			std::string name;
+			int64_t microseconds;
+			bool lazy;
+		};
+
 		// Pre-defined nodes to access standard MapleStory style data
 		// Make sure you called load_all first
-		extern node Base, Character, Effect, Etc, Item, Map, Map001, Map002, Map2, Mob, Mob001, Mob002, Mob2, Morph, Npc, Quest, Reactor, Skill, Skill001, Skill002, Skill003, Sound, Sound001, Sound002, Sound2, String, TamingMob, UI;
+		extern node Base, Character, Effect, Etc, Item, Map, Map001, Map002, Map2, Mob, Mob001, Mob002, Mob2, Npc, Skill, Skill001, Skill002, Skill003, Sound, Sound001, Sound002, String, UI;
+		// Rarely used files are opened on first access
+		extern lazy_node Morph, Quest, Reactor, Sound2, TamingMob;
 
 		// Loads the pre-defined nodes from a standard setup of nx files for MapleStory
+		// Files are opened in parallel, except for the lazy ones
 		// Only call this function once
 		void load_all();
+
+		// Returns the time spent opening each file so far, in the order they finished
+		// Lazy files are listed once they were accessed
+		std::vector<load_time> load_times();
 	}
-}
\ No newline at end of file
+}